@@ -102,6 +102,12 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
   ("OutputVpsInfo,v",           m_printVpsInfo,                       false,       "Output information about the layer dependencies and layer sets")
   ("PrintPicOutput,c" ,         m_printPicOutput,                     false,         "Print information on picture output")
   ("PrintNalus,n",              m_printReceivedNalus,                 false,        "Print information on received NAL units")
+  ("RandomAccessIndexFile",     m_randomAccessIndexFileName,          string(""),   "Random access index file listing the IRAP access units of the bitstream. Used to seek to StartPoc unless WriteRandomAccessIndex is set")
+  ("WriteRandomAccessIndex",    m_writeRandomAccessIndex,             false,        "Write the random access index file while decoding the bitstream")
+  ("StartCvs",                  m_startCvs,                           0,            "Coded video sequence of StartPoc, counted from 0 in decoding order. With StartPoc equal to -1, output starts with this CVS")
+  ("StartPoc",                  m_startPoc,                           -1,           "First POC to be output. With a random access index, decoding starts at the closest preceding IRAP access unit (-1: from the beginning)")
+  ("EndCvs",                    m_endCvs,                             -1,           "Coded video sequence of EndPoc, counted from 0 in decoding order. With EndPoc equal to -1, output ends with this CVS (-1: StartCvs if EndPoc is given)")
+  ("EndPoc",                    m_endPoc,                             -1,           "Last POC to be output. With a random access index, decoding stops once no later picture can have a POC up to EndPoc (-1: until the end)")
 #endif
   ("SEIColourRemappingInfoFilename",  m_colourRemapSEIFileName,        string(""), "Colour Remapping YUV output file name. If empty, no remapping is applied (ignore SEI message)\n")
 
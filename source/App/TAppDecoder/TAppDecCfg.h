@@ -95,6 +95,12 @@ protected:
   Bool          m_printVpsInfo;                       ///< Output VPS information
   Bool          m_printPicOutput;                     ///< Print information on picture output
   Bool          m_printReceivedNalus;                 ///< Print information on received NAL units
+  std::string   m_randomAccessIndexFileName;          ///< random access index file name
+  Bool          m_writeRandomAccessIndex;             ///< write the random access index file instead of seeking with it
+  Int           m_startCvs;                           ///< coded video sequence of m_startPoc
+  Int           m_startPoc;                           ///< first POC to be output, -1 for the start of the bitstream
+  Int           m_endCvs;                             ///< coded video sequence of m_endPoc, -1 for m_startCvs
+  Int           m_endPoc;                             ///< last POC to be output, -1 for the end of the bitstream
 #if NH_3D
   TChar*        m_pchScaleOffsetFile;                   ///< output coded scale and offset parameters
   Bool          m_depth420OutputFlag;                   ///< output depth layers in 4:2:0
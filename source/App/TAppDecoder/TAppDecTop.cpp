@@ -37,6 +37,9 @@
 
 #include <list>
 #include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <stdio.h>
 #include <fcntl.h>
 #include <assert.h>
@@ -92,6 +95,12 @@ TAppDecTop::TAppDecTop()
   m_layerResetFlag                  = false;
   m_totalNumofPicsReceived          = 0;
   m_cvsStartFound                   = false;
+  m_curNaluPosition                 = 0;
+  m_auStartPosition                 = -1;
+  m_cvsIdx                          = -1;
+  m_randomAccessPoc                 = 0;
+  m_randomAccessPocPending          = false;
+  m_outputPocOffset                 = 0;
 #endif
 #if NH_3D
     m_pScaleOffsetFile              = 0;
@@ -162,14 +171,30 @@ Void TAppDecTop::decode( Int num )
 
   InputByteStream bytestream(m_bitstreamFile);
 
-  while ( m_bitstreamFile )
+  m_randomAccessPoints.clear();
+  m_paramSetPositions .clear();
+  m_auStartPosition = -1;
+  m_cvsIdx          = -1;
+  m_outputPocOffset = 0;
+
+  // Seek to the IRAP access unit preceding StartPoc and limit decoding to what is needed up to EndPoc
+  std::streamoff endPosition = -1;
+  if ( !m_randomAccessIndexFileName.empty() && !m_writeRandomAccessIndex && ( m_startCvs > 0 || m_startPoc >= 0 || m_endCvs >= 0 || m_endPoc >= 0 ) )
+  {
+    endPosition = xSeekRandomAccessPoint( bytestream );
+  }
+
+  while ( !bytestream.eof() && ( endPosition < 0 || bytestream.getPosition() < endPosition ) )
   {
     AnnexBStats stats = AnnexBStats();
     InputNALUnit nalu;
+    const uint8_t* nalUnitBytes;
+    UInt           nalUnitSize;
 
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    m_curNaluPosition = bytestream.getPosition();
+    byteStreamNALUnit(bytestream, nalUnitBytes, nalUnitSize, stats);
 
-    if (nalu.getBitstream().getFifo().empty())
+    if (nalUnitSize == 0)
     {
       /* this can happen if the following occur:
        *  - empty input file
@@ -180,34 +205,27 @@ Void TAppDecTop::decode( Int num )
     }
     else
     {
-      read(nalu);
+      read(nalu, nalUnitBytes, nalUnitSize);
 
-      if ( m_printReceivedNalus )
+      if ( m_writeRandomAccessIndex )
       {
-        std::cout << "Received NAL unit: ";
-        nalu.print();
-        std::cout << std::endl;
+        xTrackRandomAccessNalu( nalu, nalUnitBytes, nalUnitSize );
       }
 
-      if ( xExtractAndRewrite( &nalu )
-          && nalu.m_nuhLayerId <= MAX_NUM_LAYER_IDS-1
-          && !(nalu.m_nalUnitType == NAL_UNIT_VPS && nalu.m_nuhLayerId > 0)
-          && !(nalu.m_nalUnitType == NAL_UNIT_EOB && nalu.m_nuhLayerId > 0)
-         )
+      xProcessNalu( nalu );
+
+      if ( nalu.isSlice() )
       {
-        xGetDecoderIdx( nalu.m_nuhLayerId , true );
-        if( nalu.isSlice() )
-        {
-          xProcessVclNalu   ( nalu );
-        }
-        else
-        {
-          xProcessNonVclNalu( nalu );
-        }
+        m_auStartPosition = -1;
       }
     }
   }
  xTerminateDecoding();
+
+  if ( m_writeRandomAccessIndex )
+  {
+    xWriteRandomAccessIndex();
+  }
 }
 #endif
 
@@ -257,7 +275,7 @@ Void TAppDecTop::decode( )
   Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
   Bool loopFiltered = false;
 
-  while (!!bitstreamFile)
+  while (!bytestream.eof())
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -265,18 +283,18 @@ Void TAppDecTop::decode( )
      * nal unit. */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
 #endif
+    streamoff location = bytestream.getPosition();
     AnnexBStats stats = AnnexBStats();
 
     InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    const uint8_t* nalUnitBytes;
+    UInt           nalUnitSize;
+    byteStreamNALUnit(bytestream, nalUnitBytes, nalUnitSize, stats);
 
     // call actual decoding function
     Bool bNewPicture = false;
-    if (nalu.getBitstream().getFifo().empty())
+    if (nalUnitSize == 0)
     {
       /* this can happen if the following occur:
        *  - empty input file
@@ -287,7 +305,7 @@ Void TAppDecTop::decode( )
     }
     else
     {
-      read(nalu);
+      read(nalu, nalUnitBytes, nalUnitSize);
 
       if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
       {
@@ -298,29 +316,22 @@ Void TAppDecTop::decode( )
         bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
+          /* location points to the start of the current nal unit, which is
+           * still held by the byte stream reader */
+          bytestream.setPosition(location);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
           TComCodingStatistics::SetStatistics(backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
 #endif
         }
       }
     }
 
-    if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
+    if ( (bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
 
       !m_cTDecTop.getFirstSliceInSequence () )
 
     {
-      if (!loopFiltered || bitstreamFile)
+      if (!loopFiltered || !bytestream.eof())
       {
         m_cTDecTop.executeLoopFilters(poc, pcListPic);
       }
@@ -330,7 +341,7 @@ Void TAppDecTop::decode( )
         m_cTDecTop.setFirstSliceInSequence(true);
       }
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
               m_cTDecTop.getFirstSliceInSequence () )
     {
       m_cTDecTop.setFirstSliceInPicture (true);
@@ -953,6 +964,33 @@ Bool TAppDecTop::xExtractAndRewrite( InputNALUnit* nalu )
   return naluInSubStream;
 }
 
+Void TAppDecTop::xProcessNalu( InputNALUnit& nalu )
+{
+  if ( m_printReceivedNalus )
+  {
+    std::cout << "Received NAL unit: ";
+    nalu.print();
+    std::cout << std::endl;
+  }
+
+  if ( xExtractAndRewrite( &nalu )
+      && nalu.m_nuhLayerId <= MAX_NUM_LAYER_IDS-1
+      && !(nalu.m_nalUnitType == NAL_UNIT_VPS && nalu.m_nuhLayerId > 0)
+      && !(nalu.m_nalUnitType == NAL_UNIT_EOB && nalu.m_nuhLayerId > 0)
+     )
+  {
+    xGetDecoderIdx( nalu.m_nuhLayerId , true );
+    if( nalu.isSlice() )
+    {
+      xProcessVclNalu   ( nalu );
+    }
+    else
+    {
+      xProcessNonVclNalu( nalu );
+    }
+  }
+}
+
 Void TAppDecTop::xProcessVclNalu( InputNALUnit nalu )
 {
   TDecTop* dec  = xGetDecoder( nalu );
@@ -971,6 +1009,11 @@ Void TAppDecTop::xProcessVclNalu( InputNALUnit nalu )
       Bool sliceIsFirstOfNewAU = xDetectNewAu( nalu );
       xFinalizePreviousPictures ( sliceIsFirstOfNewAU );
       xDecodeFirstSliceOfPicture( nalu, sliceIsFirstOfNewAU );
+
+      if ( sliceIsFirstOfNewAU && nalu.isIrap() )
+      {
+        xAddRandomAccessPoint();
+      }
     }
     else
     {
@@ -2381,6 +2424,8 @@ Void TAppDecTop::xF13522OutputAndRemOfPicsFromDpb( Bool beforePocDerivation )
         //   in listOfSubDpbsToEmpty are output by repeatedly invoking the "bumping" process specified in clause
         //   F.13.5.2.4 until all these pictures are marked as "not needed for output".
 
+        m_dpb.emptyNotNeedForOutputAndUnusedForRef();
+
         Bool repeat = true;
         while (repeat )
         {
@@ -2399,6 +2444,11 @@ Void TAppDecTop::xF13522OutputAndRemOfPicsFromDpb( Bool beforePocDerivation )
             repeat = false;
           }
         }
+
+        //   All these picture storage buffers are emptied and the sub-DPB fullness is set equal to 0. Bumping does not
+        //   empty pictures output before the current picture marked them as "unused for reference", e.g. earlier
+        //   pictures of the previous CVS, whose POCs would clash with the ones of the new CVS.
+        m_dpb.emptySubDpbs( &listOfSubDpbsToEmpty );
       }
       else
       {
@@ -2986,6 +3036,13 @@ Void TAppDecTop::xCropAndOutput( TComPic* curPic )
     std::cout << std::endl;
   }
 
+  // Pictures of a coded video sequence are output before the IRAP access unit starting the next one is decoded.
+  const Int outputPoc = curPic->getPOC() + m_outputPocOffset;
+  if ( xIsBeforeOutputRange( m_cvsIdx, outputPoc ) || xIsAfterOutputRange( m_cvsIdx, outputPoc ) )
+  {
+    return;
+  }
+
   assert( !curPic->getHasGeneratedRefPics() );
   assert( !curPic->getIsGenerated()         );
 
@@ -3019,6 +3076,233 @@ Void TAppDecTop::xCropAndOutput( TComPic* curPic )
   }
 }
 
+/** Record the byte positions needed for the random access index: possible start of the next access unit
+ *  and the parameter sets received so far.
+ */
+Void TAppDecTop::xTrackRandomAccessNalu( InputNALUnit& nalu, const uint8_t* nalUnitBytes, UInt nalUnitSize )
+{
+  const NalUnitType nalUnitType = nalu.m_nalUnitType;
+
+  // NAL units that start a new access unit when they follow the last VCL NAL unit of an access unit
+  const Bool canStartAu = nalUnitType == NAL_UNIT_ACCESS_UNIT_DELIMITER
+    || nalUnitType == NAL_UNIT_VPS || nalUnitType == NAL_UNIT_SPS || nalUnitType == NAL_UNIT_PPS
+    || nalUnitType == NAL_UNIT_PREFIX_SEI
+    || ( nalUnitType >= NAL_UNIT_RESERVED_NVCL41 && nalUnitType <= NAL_UNIT_RESERVED_NVCL44 )
+    || ( nalUnitType >= NAL_UNIT_UNSPECIFIED_48  && nalUnitType <= NAL_UNIT_UNSPECIFIED_55  );
+
+  if ( canStartAu && m_auStartPosition < 0 )
+  {
+    m_auStartPosition = m_curNaluPosition;
+  }
+
+  // Repeated parameter sets are only kept once, at their last position.
+  if ( nalUnitType == NAL_UNIT_VPS || nalUnitType == NAL_UNIT_SPS || nalUnitType == NAL_UNIT_PPS )
+  {
+    m_paramSetPositions[ std::string( reinterpret_cast<const char*>( nalUnitBytes ), nalUnitSize ) ] = m_curNaluPosition;
+  }
+}
+
+/** Called for the first picture of an IRAP access unit, after its POC has been derived.
+ */
+Void TAppDecTop::xAddRandomAccessPoint()
+{
+  if ( m_curPic->getNoRaslOutputFlag() )
+  {
+    // A new coded video sequence starts. Its POCs are the ones of the complete bitstream, unless decoding started
+    // at this access unit and it is a CRA picture handled as BLA picture.
+    m_cvsIdx++;
+    m_outputPocOffset = 0;
+    if ( m_randomAccessPocPending )
+    {
+      m_outputPocOffset        = m_randomAccessPoc - m_curPic->getPOC();
+      m_randomAccessPocPending = false;
+    }
+  }
+
+  if ( m_writeRandomAccessIndex )
+  {
+    RandomAccessPoint rap;
+    rap.m_cvsIdx   = m_cvsIdx;
+    rap.m_poc      = m_curPic->getPOC();
+    rap.m_position = ( m_auStartPosition >= 0 ) ? m_auStartPosition : m_curNaluPosition;
+
+    for ( std::map<std::string, std::streamoff>::const_iterator it = m_paramSetPositions.begin(); it != m_paramSetPositions.end(); it++ )
+    {
+      if ( it->second < rap.m_position )
+      {
+        rap.m_paramSetPositions.push_back( it->second );
+      }
+    }
+    // Decode in bitstream order, so that later parameter sets replace earlier ones with the same id.
+    std::sort( rap.m_paramSetPositions.begin(), rap.m_paramSetPositions.end() );
+
+    m_randomAccessPoints.push_back( rap );
+  }
+}
+
+Void TAppDecTop::xWriteRandomAccessIndex()
+{
+  std::ofstream indexFile( m_randomAccessIndexFileName.c_str() );
+  if ( !indexFile )
+  {
+    fprintf(stderr, "\nUnable to open file `%s' for writing the random access index\n", m_randomAccessIndexFileName.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  indexFile << "# CVS  POC  AU byte position  number of parameter sets  parameter set byte positions" << std::endl;
+  for ( size_t i = 0; i < m_randomAccessPoints.size(); i++ )
+  {
+    const RandomAccessPoint& rap = m_randomAccessPoints[ i ];
+    indexFile << rap.m_cvsIdx << " " << rap.m_poc << " " << rap.m_position << " " << rap.m_paramSetPositions.size();
+    for ( size_t j = 0; j < rap.m_paramSetPositions.size(); j++ )
+    {
+      indexFile << " " << rap.m_paramSetPositions[ j ];
+    }
+    indexFile << std::endl;
+  }
+}
+
+Bool TAppDecTop::xReadRandomAccessIndex()
+{
+  std::ifstream indexFile( m_randomAccessIndexFileName.c_str() );
+  if ( !indexFile )
+  {
+    return false;
+  }
+
+  std::string line;
+  while ( std::getline( indexFile, line ) )
+  {
+    if ( line.empty() || line[ 0 ] == '#' )
+    {
+      continue;
+    }
+
+    std::istringstream lineStream( line );
+    RandomAccessPoint  rap;
+    size_t             numParamSets = 0;
+
+    lineStream >> rap.m_cvsIdx >> rap.m_poc >> rap.m_position >> numParamSets;
+    rap.m_paramSetPositions.resize( numParamSets );
+    for ( size_t j = 0; j < numParamSets; j++ )
+    {
+      lineStream >> rap.m_paramSetPositions[ j ];
+    }
+
+    if ( lineStream.fail() )
+    {
+      fprintf(stderr, "Invalid line in random access index `%s': %s\n", m_randomAccessIndexFileName.c_str(), line.c_str());
+      m_randomAccessPoints.clear();
+      return false;
+    }
+    m_randomAccessPoints.push_back( rap );
+  }
+  return !m_randomAccessPoints.empty();
+}
+
+/** Decode the parameter sets of the IRAP access unit closest to StartPoc and move the bitstream to it.
+ * \returns byte position at which decoding can stop, -1 to decode until the end of the bitstream
+ */
+std::streamoff TAppDecTop::xSeekRandomAccessPoint( InputByteStream& bytestream )
+{
+  if ( !xReadRandomAccessIndex() )
+  {
+    fprintf(stderr, "Warning: Cannot use random access index `%s', decoding from the start of the bitstream\n", m_randomAccessIndexFileName.c_str());
+    return -1;
+  }
+
+  // IRAP access units are in increasing (CVS, POC) order. Start at the last one that does not follow the start of the
+  // output range, the first one of a CVS covers its leading pictures.
+  size_t startIdx = 0;
+  for ( size_t i = 1; i < m_randomAccessPoints.size(); i++ )
+  {
+    const RandomAccessPoint& rap = m_randomAccessPoints[ i ];
+    const Bool startsCvs = ( rap.m_cvsIdx != m_randomAccessPoints[ i - 1 ].m_cvsIdx );
+    if ( rap.m_cvsIdx < m_startCvs || ( rap.m_cvsIdx == m_startCvs && ( startsCvs || ( m_startPoc >= 0 && rap.m_poc <= m_startPoc ) ) ) )
+    {
+      startIdx = i;
+    }
+  }
+
+  // Leading pictures follow their IRAP access unit in decoding order and belong to its CVS. Hence, decoding can stop
+  // at the IRAP access unit after the first one following the output range, or at that one if it starts a later CVS.
+  std::streamoff endPosition = -1;
+  for ( size_t i = startIdx + 1; i < m_randomAccessPoints.size(); i++ )
+  {
+    const RandomAccessPoint& rap = m_randomAccessPoints[ i ];
+    if ( xIsAfterOutputRange( rap.m_cvsIdx, rap.m_poc ) )
+    {
+      if ( rap.m_cvsIdx != m_randomAccessPoints[ i - 1 ].m_cvsIdx )
+      {
+        endPosition = rap.m_position;
+      }
+      else if ( i + 1 < m_randomAccessPoints.size() )
+      {
+        endPosition = m_randomAccessPoints[ i + 1 ].m_position;
+      }
+      break;
+    }
+  }
+
+  const RandomAccessPoint& rap = m_randomAccessPoints[ startIdx ];
+  if ( rap.m_position > 0 )
+  {
+    for ( size_t j = 0; j < rap.m_paramSetPositions.size(); j++ )
+    {
+      AnnexBStats    stats = AnnexBStats();
+      InputNALUnit   nalu;
+      const uint8_t* nalUnitBytes;
+      UInt           nalUnitSize;
+
+      xSetBitstreamPosition( bytestream, rap.m_paramSetPositions[ j ] );
+      byteStreamNALUnit( bytestream, nalUnitBytes, nalUnitSize, stats );
+      if ( nalUnitSize > 0 )
+      {
+        read( nalu, nalUnitBytes, nalUnitSize );
+        xProcessNalu( nalu );
+      }
+    }
+    xSetBitstreamPosition( bytestream, rap.m_position );
+
+    std::cout << "Random access at CVS " << rap.m_cvsIdx << " POC " << rap.m_poc << ", byte position " << rap.m_position << std::endl;
+  }
+
+  // The IRAP access unit decoding starts at begins a new CVS, count it as the one it belongs to in the complete bitstream.
+  m_cvsIdx                 = rap.m_cvsIdx - 1;
+  m_randomAccessPoc        = rap.m_poc;
+  m_randomAccessPocPending = true;
+  return endPosition;
+}
+
+/** Check whether a picture precedes the output range given by StartCvs and StartPoc.
+ * StartPoc equal to -1 selects the start of StartCvs.
+ */
+Bool TAppDecTop::xIsBeforeOutputRange( Int cvsIdx, Int poc ) const
+{
+  return cvsIdx < m_startCvs || ( cvsIdx == m_startCvs && m_startPoc >= 0 && poc < m_startPoc );
+}
+
+/** Check whether a picture follows the output range given by EndCvs and EndPoc.
+ * EndPoc equal to -1 selects the end of EndCvs, EndCvs equal to -1 the CVS of StartPoc when EndPoc is given and
+ * the end of the bitstream otherwise.
+ */
+Bool TAppDecTop::xIsAfterOutputRange( Int cvsIdx, Int poc ) const
+{
+  if ( m_endCvs < 0 && m_endPoc < 0 )
+  {
+    return false;
+  }
+  const Int endCvs = ( m_endCvs >= 0 ) ? m_endCvs : m_startCvs;
+  return cvsIdx > endCvs || ( cvsIdx == endCvs && m_endPoc >= 0 && poc > m_endPoc );
+}
+
+Void TAppDecTop::xSetBitstreamPosition( InputByteStream& bytestream, std::streamoff position )
+{
+  m_bitstreamFile.clear();
+  m_bitstreamFile.seekg( position );
+  bytestream.reset();
+}
+
 UInt TAppDecTop::getNumberOfChecksumErrorsDetected() const
 {
   UInt numOfChecksumErrors = 0;
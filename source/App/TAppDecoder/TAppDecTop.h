@@ -48,6 +48,14 @@
 #include "TLibDecoder/TDecTop.h"
 #include "TAppDecCfg.h"
 
+#if NH_MV
+#include <map>
+#include <string>
+#include <vector>
+
+class InputByteStream;
+#endif
+
 //! \ingroup TAppDecoder
 //! \{
 
@@ -55,6 +63,17 @@
 // Class definition
 // ====================================================================================================================
 
+#if NH_MV
+/// entry of the random access index: an IRAP access unit and the parameter sets needed to start decoding at it
+struct RandomAccessPoint
+{
+  Int                         m_cvsIdx;             ///< coded video sequence of the access unit, counted from 0 in decoding order
+  Int                         m_poc;                ///< POC of the first picture of the access unit
+  std::streamoff              m_position;           ///< byte position of the first NAL unit of the access unit
+  std::vector<std::streamoff> m_paramSetPositions;  ///< byte positions of preceding VPS/SPS/PPS NAL units, in bitstream order
+};
+#endif
+
 /// decoder application class
 class TAppDecTop : public TAppDecCfg
 {
@@ -116,6 +135,16 @@ private:
   const TComVPS*                  m_vps;                                ///< active VPS
 
   Bool                            m_reconOpen           [ MAX_NUM_LAYERS ]; ///< reconstruction file opened
+
+  // Random access index
+  std::vector<RandomAccessPoint>  m_randomAccessPoints;                 ///< IRAP access units found while decoding
+  std::map<std::string, std::streamoff> m_paramSetPositions;            ///< last byte position of each distinct parameter set NAL unit
+  std::streamoff                  m_curNaluPosition;                    ///< byte position of the current NAL unit
+  std::streamoff                  m_auStartPosition;                    ///< byte position of the first NAL unit that may start the next AU, -1 if none
+  Int                             m_cvsIdx;                             ///< coded video sequence of the current access unit, counted from 0 in decoding order
+  Int                             m_randomAccessPoc;                    ///< POC of the IRAP access unit decoding started at
+  Bool                            m_randomAccessPocPending;             ///< POC offset still to be derived from the first decoded picture
+  Int                             m_outputPocOffset;                    ///< offset from decoded POCs to the POCs of the complete bitstream in the current coded video sequence
 #if NH_3D
   FILE*                           m_pScaleOffsetFile;
   CamParsCollector                m_cCamParsCollector;
@@ -160,6 +189,7 @@ protected:
 #else
   // Process NAL units 
   Bool xExtractAndRewrite                  ( InputNALUnit* nalu );
+  Void xProcessNalu                        ( InputNALUnit& nalu );
   Void xProcessVclNalu                     ( InputNALUnit nalu );
   Bool xIsSkipVclNalu                      ( InputNALUnit& nalu, Bool isFirstSliceOfPic );
   Void xProcessNonVclNalu                  ( InputNALUnit nalu );
@@ -209,6 +239,16 @@ protected:
   Void  xOpenReconFile                     ( TComPic* curPic );
   Void  xFlushOutput                       ( );
   Void  xCropAndOutput                     ( TComPic* curPic );  
+
+  // Random access index
+  Void  xTrackRandomAccessNalu             ( InputNALUnit& nalu, const uint8_t* nalUnitBytes, UInt nalUnitSize );
+  Void  xAddRandomAccessPoint              ( );
+  Void  xWriteRandomAccessIndex            ( );
+  Bool  xReadRandomAccessIndex             ( );
+  std::streamoff xSeekRandomAccessPoint    ( InputByteStream& bytestream );
+  Bool  xIsBeforeOutputRange               ( Int cvsIdx, Int poc ) const;
+  Bool  xIsAfterOutputRange                ( Int cvsIdx, Int poc ) const;
+  Void  xSetBitstreamPosition              ( InputByteStream& bytestream, std::streamoff position );
 #endif
 
 private:
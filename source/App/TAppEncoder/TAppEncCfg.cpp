@@ -112,7 +112,10 @@ TAppEncCfg::TAppEncCfg()
 , m_snrInternalColourSpace(false)
 , m_outputInternalColourSpace(false)
 {
-#if !NH_MV
+#if NH_MV
+  m_numRatePoints = 1;
+  m_ratePoint     = 0;
+#else
   m_aidQP = NULL;
 #endif
   m_startOfCodedInterval = NULL;
@@ -754,7 +757,6 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 #else
   ExtendedProfileName extendedProfile;
 #endif
-  Int saoOffsetBitShift[MAX_NUM_CHANNEL_TYPE];
 
   // Multi-value input fields:                                // minval, maxval (incl), min_entries, max_entries (incl) [, default values, number of default values]
   SMultiValueInput<UInt> cfg_ColumnWidth                     (0, std::numeric_limits<UInt>::max(), 0, std::numeric_limits<UInt>::max());
@@ -807,6 +809,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("BitstreamFile,b",                                 m_bitstreamFileName,                         string(""), "Bitstream output file name")
 #if NH_MV
   ("ReconFile_%d,o_%d",       m_pchReconFileList,       (char *) 0 , MAX_NUM_LAYER_IDS , "reconstructed Yuv output file name %d")
+  ("MultiRateQP_%d",            m_multiRateQP,            std::vector<Double>(0), MAX_NUM_RATE_POINTS, "Qp values for each layer of additional rate point %d (%d > 0), encoded after the rate point given by QP")
+  ("MultiRateBitstreamFile_%d", m_multiRateBitstreamFileName, string(""), MAX_NUM_RATE_POINTS, "Bitstream output file name of additional rate point %d")
+  ("MultiRateReconFile_%d_%d",  m_multiRateReconFileName, string(""), MAX_NUM_RATE_POINTS, MAX_NUM_LAYER_IDS, "reconstructed Yuv output file name of additional rate point %d and layer %d")
 #else
   ("ReconFile,o",                                     m_reconFileName,                             string(""), "Reconstructed YUV output file name")
 #endif
@@ -882,6 +887,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
+  ("SegmentSize",                                     m_segmentSize,                                        0, "Number of frames of a segment, segments are encoded separately and stitched afterwards (0: encode all frames)")
+  ("SegmentIdx",                                      m_segmentIdx,                                         0, "Index of the segment to encode when SegmentSize is non-zero")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
@@ -946,6 +953,25 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 #if NH_MV
   ("DispSearchRangeRestriction",  m_bUseDisparitySearchRangeRestriction, false, "restrict disparity search range")
   ("VerticalDispSearchRange",     m_iVerticalDisparitySearchRange, 56, "vertical disparity search range")
+#endif
+#if NH_3D_IV_MOTION_SEED
+  ("IvMotionSeed",                                    m_bUseIvMotionSeed,                               false, "Use base view motion at the NBDV position as ME start point in dependent texture views")
+  ("IvMotionSeedSearchRange",                         m_iIvMotionSeedSearchRange,                           8, "Motion search range when the base view motion is the best ME start point")
+#endif
+#if NH_MV_PYRAMID_ME
+  ("PyramidME",                                       m_bUsePyramidME,                                  false, "Predict the integer ME start point by a coarse search on 1/4 and 1/2 resolution luma planes")
+  ("PyramidMERefineRange",                            m_iPyramidMERefineRange,                              8, "Full resolution motion search range around the coarse motion vector of the pyramid ME")
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  ("MultiRateMotionSeed",                             m_bUseRatePointMotionSeed,                         true, "Use the motion of the first rate point as ME start point of the additional rate points")
+  ("MultiRateMotionSeedSearchRange",                  m_iRatePointMotionSeedSearchRange,                    8, "Motion search range when the motion of the first rate point is the best ME start point")
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  ("SubPelPlaneCache",                                m_bUseSubPelPlaneCache,                           false, "Interpolate each reference picture once at all quarter sample positions for the fractional motion search")
+#endif
+#if NH_MV_PIC_ANALYSIS
+  ("PicAnalysis",                                     m_bUsePicAnalysis,                                false, "Analyse each input picture once on 8x8 blocks and reuse the result in rate control and adaptive QP")
+  ("PicAnalysisFastIntra",                            m_bUsePicAnalysisFastIntra,                       false, "Skip intra modes in inter slices for CUs that are well predicted from the previous input picture")
 #endif
   ("BipredSearchRange",                               m_bipredSearchRange,                                  4, "Motion search range for bipred refinement")
   ("MinSearchWindow",                                 m_minSearchWindow,                                    8, "Minimum motion search window size for the adaptive window ME")
@@ -1020,8 +1046,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("AMP",                                             m_enableAMP,                                       true, "Enable asymmetric motion partitions")
   ("CrossComponentPrediction",                        m_crossComponentPredictionEnabledFlag,            false, "Enable the use of cross-component prediction (not valid in V1 profiles)")
   ("ReconBasedCrossCPredictionEstimate",              m_reconBasedCrossCPredictionEstimate,             false, "When determining the alpha value for cross-component prediction, use the decoded residual rather than the pre-transform encoder-side residual")
-  ("SaoLumaOffsetBitShift",                           saoOffsetBitShift[CHANNEL_TYPE_LUMA],                 0, "Specify the luma SAO bit-shift. If negative, automatically calculate a suitable value based upon bit depth and initial QP")
-  ("SaoChromaOffsetBitShift",                         saoOffsetBitShift[CHANNEL_TYPE_CHROMA],               0, "Specify the chroma SAO bit-shift. If negative, automatically calculate a suitable value based upon bit depth and initial QP")
+  ("SaoLumaOffsetBitShift",                           m_saoOffsetBitShift[CHANNEL_TYPE_LUMA],               0, "Specify the luma SAO bit-shift. If negative, automatically calculate a suitable value based upon bit depth and initial QP")
+  ("SaoChromaOffsetBitShift",                         m_saoOffsetBitShift[CHANNEL_TYPE_CHROMA],             0, "Specify the chroma SAO bit-shift. If negative, automatically calculate a suitable value based upon bit depth and initial QP")
   ("TransformSkip",                                   m_useTransformSkip,                               false, "Intra transform skipping")
   ("TransformSkipFast",                               m_useTransformSkipFast,                           false, "Fast intra transform skipping")
   ("TransformSkipLog2MaxSize",                        m_log2MaxTransformSkipBlockSize,                     2U, "Specify transform-skip maximum size. Minimum 2. (not valid in V1 profiles)")
@@ -1324,6 +1350,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
                                                                                                               
   ("UseEstimatedVSD",                                 m_bUseEstimatedVSD        , true                          ,"Model based VSD estimation instead of rendering based for some encoder decisions" )      
   ("VSOEarlySkip",                                    m_bVSOEarlySkip           , true                          ,"Early skip of VSO computation if synthesis error assumed to be zero" )      
+  ("VSOIncrementalSetup",                             m_bVSOIncrementalSetup    , true                          ,"Render the initial synthesized views once per slice instead of once per CTU row (renderer model buffers of picture height)" )
                                                                                                                
   ("WVSO",                                            m_bUseWVSO                , true                          ,"Use depth fidelity term for VSO" )
   ("VSOWeight",                                       m_iVSOWeight              , 10                            ,"Synthesized View Distortion Change weight" )
@@ -1334,6 +1361,10 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 #if NH_3D_QTL
   ("QTL"                   ,                          m_bUseQTL                 , true                          , "Use depth quad tree limitation (encoder only)" )
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  ("TexGuidedDepthMD"      ,                          m_bUseTexGuidedDepthMD    , false                         , "Prune depth DMM, DIS and intra candidates using edges and skip modes of the co-located texture (encoder only)" )
+  ("TexGuidedDepthEdgeThr" ,                          m_iTexGuidedDepthEdgeThr  , 8                             , "Difference of neighbouring texture samples (8 bit scale) regarded as edge by TexGuidedDepthMD" )
+#endif
 #if NH_3D
 
   ("IvMvPredFlag"          ,                          m_ivMvPredFlag            , BoolAry1d(2,true)             , "Inter-view motion prediction"              )
@@ -1439,6 +1470,13 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
    */
 
   m_framesToBeEncoded = ( m_framesToBeEncoded + m_temporalSubsampleRatio - 1 ) / m_temporalSubsampleRatio;
+
+  // restrict the input to the segment, it is coded as separate coded video sequence starting with an IDR picture
+  if ( m_segmentSize > 0 )
+  {
+    m_FrameSkip        += m_segmentIdx * m_segmentSize * m_temporalSubsampleRatio;
+    m_framesToBeEncoded = min( m_segmentSize, m_framesToBeEncoded - m_segmentIdx * m_segmentSize );
+  }
   m_adIntraLambdaModifier = cfg_adIntraLambdaModifier.values;
   if(m_isField)
   {
@@ -1841,40 +1879,15 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   for( Int layer = 0; layer < m_numberOfLayers; layer++ )
   {
     m_aidQP.push_back( new Int[ m_framesToBeEncoded + m_iGOPSize + 1 ] );
-    ::memset( m_aidQP[layer], 0, sizeof(Int)*( m_framesToBeEncoded + m_iGOPSize + 1 ) );
-
-    // handling of floating-point QP values
-    // if QP is not integer, sequence is split into two sections having QP and QP+1
-    m_iQP.push_back((Int)( m_fQP[layer] ));
-    if ( m_iQP[layer] < m_fQP[layer] )
-    {
-      Int iSwitchPOC = (Int)( m_framesToBeEncoded - (m_fQP[layer] - m_iQP[layer])*m_framesToBeEncoded + 0.5 );
-
-      iSwitchPOC = (Int)( (Double)iSwitchPOC / m_iGOPSize + 0.5 )*m_iGOPSize;
-      for ( Int i=iSwitchPOC; i<m_framesToBeEncoded + m_iGOPSize + 1; i++ )
-      {
-        m_aidQP[layer][i] = 1;
-      }
-    }
+    m_iQP  .push_back( 0 ); 
+  }
+  xSetQPDependentParameters(); 
 
-    for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
-    {
-      if (saoOffsetBitShift[ch]<0)
-      {
-        if (m_internalBitDepth[ch]>10)
-        {
-          m_log2SaoOffsetScale[layer][ch]=UInt(Clip3<Int>(0, m_internalBitDepth[ch]-10, Int(m_internalBitDepth[ch]-10 + 0.165*m_iQP[layer] - 3.22 + 0.5) ) );
-        }
-        else
-        {
-          m_log2SaoOffsetScale[layer][ch]=0;
-        }
-      }
-      else
-      {
-        m_log2SaoOffsetScale[layer][ch]=UInt(saoOffsetBitShift[ch]);
-      }
-    }
+  m_ratePoint     = 0; 
+  m_numRatePoints = 1; 
+  while ( m_numRatePoints < MAX_NUM_RATE_POINTS && !m_multiRateQP[ m_numRatePoints ].empty() )
+  {
+    m_numRatePoints++; 
   }
 
   xResizeVector( m_bLoopFilterDisable ); 
@@ -1890,73 +1903,10 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   }
 #else
   m_aidQP = new Int[ m_framesToBeEncoded + m_iGOPSize + 1 ];
-  ::memset( m_aidQP, 0, sizeof(Int)*( m_framesToBeEncoded + m_iGOPSize + 1 ) );
-
-  // handling of floating-point QP values
-  // if QP is not integer, sequence is split into two sections having QP and QP+1
-  m_iQP = (Int)( m_fQP );
-  if ( m_iQP < m_fQP )
-  {
-    Int iSwitchPOC = (Int)( m_framesToBeEncoded - (m_fQP - m_iQP)*m_framesToBeEncoded + 0.5 );
-
-    iSwitchPOC = (Int)( (Double)iSwitchPOC / m_iGOPSize + 0.5 )*m_iGOPSize;
-    for ( Int i=iSwitchPOC; i<m_framesToBeEncoded + m_iGOPSize + 1; i++ )
-    {
-      m_aidQP[i] = 1;
-    }
-  }
-
-  for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
-  {
-    if (saoOffsetBitShift[ch]<0)
-    {
-      if (m_internalBitDepth[ch]>10)
-      {
-        m_log2SaoOffsetScale[ch]=UInt(Clip3<Int>(0, m_internalBitDepth[ch]-10, Int(m_internalBitDepth[ch]-10 + 0.165*m_iQP - 3.22 + 0.5) ) );
-      }
-      else
-      {
-        m_log2SaoOffsetScale[ch]=0;
-      }
-    }
-    else
-    {
-      m_log2SaoOffsetScale[ch]=UInt(saoOffsetBitShift[ch]);
-    }
-  }
-
+  xSetQPDependentParameters(); 
 #endif
 
-  // reading external dQP description from file
-  if ( !m_dQPFileName.empty() )
-  {
-    FILE* fpt=fopen( m_dQPFileName.c_str(), "r" );
-    if ( fpt )
-    {
-#if NH_MV
-      for( Int layer = 0; layer < m_numberOfLayers; layer++ )
-      {
-#endif
-      Int iValue;
-      Int iPOC = 0;
-      while ( iPOC < m_framesToBeEncoded )
-      {
-        if ( fscanf(fpt, "%d", &iValue ) == EOF )
-        {
-          break;
-        }
-#if NH_MV
-        m_aidQP[layer][ iPOC ] = iValue;
-        iPOC++;
-      }
-#else
-        m_aidQP[ iPOC ] = iValue;
-        iPOC++;
-#endif
-      }
-      fclose(fpt);
-    }
-  }
+  xReadDQPFile(); 
 
 #if NH_MV
   xParseSeiCfg(); 
@@ -2044,31 +1994,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 
 
 #if NH_3D_VSO
-  // Table base optimization 
-  // Q&D
-  Double adLambdaScaleTable[] = 
-  {  0.031250, 0.031639, 0.032029, 0.032418, 0.032808, 0.033197, 0.033586, 0.033976, 0.034365, 0.034755, 
-  0.035144, 0.035533, 0.035923, 0.036312, 0.036702, 0.037091, 0.037480, 0.037870, 0.038259, 0.038648, 
-  0.039038, 0.039427, 0.039817, 0.040206, 0.040595, 0.040985, 0.041374, 0.041764, 0.042153, 0.042542, 
-  0.042932, 0.043321, 0.043711, 0.044100, 0.044194, 0.053033, 0.061872, 0.070711, 0.079550, 0.088388, 
-  0.117851, 0.147314, 0.176777, 0.235702, 0.294628, 0.353553, 0.471405, 0.589256, 0.707107, 0.707100, 
-  0.753550, 0.800000  
-  }; 
-  if ( m_bUseVSO && m_bVSOLSTable )
-  {
-    Int firstDepthLayer = -1; 
-    for (Int layer = 0; layer < m_numberOfLayers; layer++ )
-    {
-      if ( m_depthFlag[ layer ]  || m_auxId[ layer ] == 2 )
-      {
-        firstDepthLayer = layer;
-        break; 
-      }
-    }
-    AOT( firstDepthLayer == -1 );
-    AOT( (m_iQP[firstDepthLayer] < 0) || (m_iQP[firstDepthLayer] > 51));
-    m_dLambdaScaleVSO *= adLambdaScaleTable[m_iQP[firstDepthLayer]]; 
-  }
+  m_dLambdaScaleVSOCfg = m_dLambdaScaleVSO; 
+  xSetLambdaScaleVSO(); 
+
   if ( m_bUseVSO && m_uiVSOMode == 4)
   {
     m_cRenModStrParser.setString( m_iNumberOfViews, m_pchVSOConfig );
@@ -2138,6 +2066,184 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 // Private member functions
 // ====================================================================================================================
 
+/** Derive the integer key-picture QPs, the per-slice QP switch for fractional QPs and the SAO offset scaling from m_fQP.
+    Called at configuration parsing and again for each additional rate point.
+ */
+Void TAppEncCfg::xSetQPDependentParameters()
+{
+#if NH_MV
+  for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+  {
+    ::memset( m_aidQP[layer], 0, sizeof(Int)*( m_framesToBeEncoded + m_iGOPSize + 1 ) );
+
+    // handling of floating-point QP values
+    // if QP is not integer, sequence is split into two sections having QP and QP+1
+    m_iQP[layer] = (Int)( m_fQP[layer] );
+    if ( m_iQP[layer] < m_fQP[layer] )
+    {
+      Int iSwitchPOC = (Int)( m_framesToBeEncoded - (m_fQP[layer] - m_iQP[layer])*m_framesToBeEncoded + 0.5 );
+
+      iSwitchPOC = (Int)( (Double)iSwitchPOC / m_iGOPSize + 0.5 )*m_iGOPSize;
+      for ( Int i=iSwitchPOC; i<m_framesToBeEncoded + m_iGOPSize + 1; i++ )
+      {
+        m_aidQP[layer][i] = 1;
+      }
+    }
+
+    for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
+    {
+      if (m_saoOffsetBitShift[ch]<0)
+      {
+        if (m_internalBitDepth[ch]>10)
+        {
+          m_log2SaoOffsetScale[layer][ch]=UInt(Clip3<Int>(0, m_internalBitDepth[ch]-10, Int(m_internalBitDepth[ch]-10 + 0.165*m_iQP[layer] - 3.22 + 0.5) ) );
+        }
+        else
+        {
+          m_log2SaoOffsetScale[layer][ch]=0;
+        }
+      }
+      else
+      {
+        m_log2SaoOffsetScale[layer][ch]=UInt(m_saoOffsetBitShift[ch]);
+      }
+    }
+  }
+#else
+  ::memset( m_aidQP, 0, sizeof(Int)*( m_framesToBeEncoded + m_iGOPSize + 1 ) );
+
+  // handling of floating-point QP values
+  // if QP is not integer, sequence is split into two sections having QP and QP+1
+  m_iQP = (Int)( m_fQP );
+  if ( m_iQP < m_fQP )
+  {
+    Int iSwitchPOC = (Int)( m_framesToBeEncoded - (m_fQP - m_iQP)*m_framesToBeEncoded + 0.5 );
+
+    iSwitchPOC = (Int)( (Double)iSwitchPOC / m_iGOPSize + 0.5 )*m_iGOPSize;
+    for ( Int i=iSwitchPOC; i<m_framesToBeEncoded + m_iGOPSize + 1; i++ )
+    {
+      m_aidQP[i] = 1;
+    }
+  }
+
+  for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    if (m_saoOffsetBitShift[ch]<0)
+    {
+      if (m_internalBitDepth[ch]>10)
+      {
+        m_log2SaoOffsetScale[ch]=UInt(Clip3<Int>(0, m_internalBitDepth[ch]-10, Int(m_internalBitDepth[ch]-10 + 0.165*m_iQP - 3.22 + 0.5) ) );
+      }
+      else
+      {
+        m_log2SaoOffsetScale[ch]=0;
+      }
+    }
+    else
+    {
+      m_log2SaoOffsetScale[ch]=UInt(m_saoOffsetBitShift[ch]);
+    }
+  }
+#endif
+}
+
+Void TAppEncCfg::xReadDQPFile()
+{
+  // reading external dQP description from file
+  if ( !m_dQPFileName.empty() )
+  {
+    FILE* fpt=fopen( m_dQPFileName.c_str(), "r" );
+    if ( fpt )
+    {
+#if NH_MV
+      for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+      {
+#endif
+      Int iValue;
+      Int iPOC = 0;
+      while ( iPOC < m_framesToBeEncoded )
+      {
+        if ( fscanf(fpt, "%d", &iValue ) == EOF )
+        {
+          break;
+        }
+#if NH_MV
+        m_aidQP[layer][ iPOC ] = iValue;
+        iPOC++;
+      }
+#else
+        m_aidQP[ iPOC ] = iValue;
+        iPOC++;
+#endif
+      }
+      fclose(fpt);
+    }
+  }
+}
+
+#if NH_3D_VSO
+Void TAppEncCfg::xSetLambdaScaleVSO()
+{
+  m_dLambdaScaleVSO = m_dLambdaScaleVSOCfg; 
+
+  // Table base optimization 
+  // Q&D
+  Double adLambdaScaleTable[] = 
+  {  0.031250, 0.031639, 0.032029, 0.032418, 0.032808, 0.033197, 0.033586, 0.033976, 0.034365, 0.034755, 
+  0.035144, 0.035533, 0.035923, 0.036312, 0.036702, 0.037091, 0.037480, 0.037870, 0.038259, 0.038648, 
+  0.039038, 0.039427, 0.039817, 0.040206, 0.040595, 0.040985, 0.041374, 0.041764, 0.042153, 0.042542, 
+  0.042932, 0.043321, 0.043711, 0.044100, 0.044194, 0.053033, 0.061872, 0.070711, 0.079550, 0.088388, 
+  0.117851, 0.147314, 0.176777, 0.235702, 0.294628, 0.353553, 0.471405, 0.589256, 0.707107, 0.707100, 
+  0.753550, 0.800000  
+  }; 
+  if ( m_bUseVSO && m_bVSOLSTable )
+  {
+    Int firstDepthLayer = -1; 
+    for (Int layer = 0; layer < m_numberOfLayers; layer++ )
+    {
+      if ( m_depthFlag[ layer ]  || m_auxId[ layer ] == 2 )
+      {
+        firstDepthLayer = layer;
+        break; 
+      }
+    }
+    AOT( firstDepthLayer == -1 );
+    AOT( (m_iQP[firstDepthLayer] < 0) || (m_iQP[firstDepthLayer] > 51));
+    m_dLambdaScaleVSO = m_dLambdaScaleVSOCfg * adLambdaScaleTable[m_iQP[firstDepthLayer]]; 
+  }
+}
+#endif
+
+#if NH_MV
+/** Switch the configuration to an additional rate point: QPs of all layers and output file names are replaced by the
+    MultiRate* values of the rate point. All other parameters are shared by the rate points.
+ */
+Void TAppEncCfg::xSetRatePoint( Int ratePoint )
+{
+  assert( ratePoint > 0 && ratePoint < m_numRatePoints ); 
+  m_ratePoint = ratePoint; 
+
+  m_fQP = m_multiRateQP[ ratePoint ]; 
+  xResizeVector( m_fQP ); 
+  xSetQPDependentParameters(); 
+  xReadDQPFile(); 
+#if NH_3D_VSO
+  xSetLambdaScaleVSO(); 
+#endif
+
+  m_bitstreamFileName = m_multiRateBitstreamFileName[ ratePoint ]; 
+  for( Int layer = 0; layer < m_pchReconFileList.size(); layer++ )
+  {
+    if ( m_pchReconFileList[layer] != NULL )
+    {
+      free( m_pchReconFileList[layer] ); 
+    }
+    const std::string& reconFileName = m_multiRateReconFileName[ ratePoint ][ layer ]; 
+    m_pchReconFileList[layer] = reconFileName.empty() ? NULL : strdup( reconFileName.c_str() );
+  }
+}
+#endif
+
 Void TAppEncCfg::xCheckParameter()
 {
   if (m_decodedPictureHashSEIType==HASHTYPE_NONE)
@@ -2169,6 +2275,18 @@ Void TAppEncCfg::xCheckParameter()
 #define xConfirmPara(a,b) check_failed |= confirmPara(a,b)
 
   xConfirmPara(m_bitstreamFileName.empty(), "A bitstream file name must be specified (BitstreamFile)");
+#if NH_MV
+  xConfirmPara( !m_multiRateQP[0].empty(), "MultiRateQP_0 is not supported, QPs of the first rate point are given by QP" );
+  for( Int ratePoint = 1; ratePoint < m_numRatePoints; ratePoint++ )
+  {
+    xConfirmPara( m_multiRateBitstreamFileName[ ratePoint ].empty(), "A bitstream file name must be specified for each additional rate point (MultiRateBitstreamFile_%d)" );
+    for( Int i = 0; i < m_multiRateQP[ ratePoint ].size(); i++ )
+    {
+      Int iQP = (Int) m_multiRateQP[ ratePoint ][ i ]; 
+      xConfirmPara( iQP <  -6 * (m_internalBitDepth[CHANNEL_TYPE_LUMA] - 8) || iQP > 51, "MultiRateQP exceeds supported range (-QpBDOffsety to 51)" );
+    }
+  }
+#endif
   const UInt maxBitDepth=(m_chromaFormatIDC==CHROMA_400) ? m_internalBitDepth[CHANNEL_TYPE_LUMA] : std::max(m_internalBitDepth[CHANNEL_TYPE_LUMA], m_internalBitDepth[CHANNEL_TYPE_CHROMA]);
   xConfirmPara(m_bitDepthConstraint<maxBitDepth, "The internalBitDepth must not be greater than the bitDepthConstraint value");
   xConfirmPara(m_chromaFormatConstraint<m_chromaFormatIDC, "The chroma format used must not be greater than the chromaFormatConstraint value");
@@ -2283,6 +2401,22 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_InputChromaFormatIDC >= NUM_CHROMA_FORMAT,                                "InputChromaFormatIDC must be either 400, 420, 422 or 444" );
   xConfirmPara( m_iFrameRate <= 0,                                                          "Frame rate must be more than 1" );
   xConfirmPara( m_temporalSubsampleRatio < 1,                                               "Temporal subsample rate must be no less than 1" );
+  xConfirmPara( m_segmentSize < 0,                                                          "SegmentSize must not be negative" );
+  if ( m_segmentSize > 0 )
+  {
+    xConfirmPara( m_segmentIdx < 0,                                                         "SegmentIdx must not be negative" );
+    xConfirmPara( m_framesToBeEncoded <= 0,                                                 "SegmentIdx exceeds the number of segments of the sequence" );
+    xConfirmPara( m_isField,                                                                "Segment encoding is not supported for field coding" );
+    xConfirmPara( m_segmentSize % m_iGOPSize != 0,                                          "SegmentSize must be a multiple of GOPSize" );
+#if NH_MV
+    for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+    {
+      xConfirmPara( m_iIntraPeriod[layer] > 0 && m_segmentSize % m_iIntraPeriod[layer] != 0, "SegmentSize must be a multiple of IntraPeriod" );
+    }
+#else
+    xConfirmPara( m_iIntraPeriod > 0 && m_segmentSize % m_iIntraPeriod != 0,                "SegmentSize must be a multiple of IntraPeriod" );
+#endif
+  }
   xConfirmPara( m_framesToBeEncoded <= 0,                                                   "Total Number Of Frames encoded must be more than 0" );
 #if NH_MV
   xConfirmPara( m_numberOfLayers > MAX_NUM_LAYER_IDS ,                                      "NumberOfLayers must be less than or equal to MAX_NUM_LAYER_IDS");
@@ -2549,6 +2683,21 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
 #if NH_MV
   xConfirmPara( m_iVerticalDisparitySearchRange <= 0 ,                                      "Vertical Disparity Search Range must be more than 0" );
+#if NH_3D_IV_MOTION_SEED
+  xConfirmPara( m_iIvMotionSeedSearchRange <= 0 ,                                           "Inter-view motion seed search range must be more than 0" );
+#endif
+#if NH_MV_PYRAMID_ME
+  xConfirmPara( m_iPyramidMERefineRange <= 0 ,                                              "Pyramid ME refinement range must be more than 0" );
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  xConfirmPara( m_iRatePointMotionSeedSearchRange <= 0 ,                                    "Rate point motion seed search range must be more than 0" );
+#endif
+#if NH_MV_PIC_ANALYSIS
+  xConfirmPara( m_bUsePicAnalysisFastIntra && !m_bUsePicAnalysis,                           "PicAnalysisFastIntra requires PicAnalysis" );
+#endif
+#if NH_3D_TEX_GUIDED_MD
+  xConfirmPara( m_iTexGuidedDepthEdgeThr < 0 ,                                              "Texture edge threshold must be greater than or equal to 0" );
+#endif
 #endif
   xConfirmPara( m_iMaxDeltaQP > 7,                                                          "Absolute Delta QP exceeds supported range (0 to 7)" );
   xConfirmPara( m_iMaxCuDQPDepth > m_uiMaxCUDepth - 1,                                          "Absolute depth for a minimum CuDQP exceeds maximum coding unit depth" );
@@ -3441,6 +3590,10 @@ Void TAppEncCfg::xPrintParameter()
 #endif
   printf("Bitstream      File                    : %s\n", m_bitstreamFileName.c_str()      );
 #if NH_MV
+  for( Int ratePoint = 1; ratePoint < m_numRatePoints; ratePoint++ )
+  {
+    printf("Bitstream File Rate Point %i      : %s\n", ratePoint, m_multiRateBitstreamFileName[ ratePoint ].c_str() );
+  }
   for( Int layer = 0; layer < m_numberOfLayers; layer++)
   {
     printf("Reconstruction File %i            : %s\n", layer, m_pchReconFileList[layer]);
@@ -3464,6 +3617,12 @@ Void TAppEncCfg::xPrintParameter()
 #endif
 #if NH_MV  
   xPrintParaVector( "QP"               , m_fQP                ); 
+  for( Int ratePoint = 1; ratePoint < m_numRatePoints; ratePoint++ )
+  {
+    std::ostringstream description; 
+    description << "QP Rate Point " << ratePoint; 
+    xPrintParaVector( description.str(), m_multiRateQP[ ratePoint ] ); 
+  }
   xPrintParaVector( "LoopFilterDisable", m_bLoopFilterDisable ); 
   xPrintParaVector( "SAO"              , m_bUseSAO            ); 
 #endif
@@ -3486,6 +3645,10 @@ Void TAppEncCfg::xPrintParameter()
     printf("Frame/Field                       : Frame based coding\n");
     printf("Frame index                       : %u - %d (%d frames)\n", m_FrameSkip, m_FrameSkip+m_framesToBeEncoded-1, m_framesToBeEncoded );
   }
+  if ( m_segmentSize > 0 )
+  {
+    printf("Segment                           : %d (%d frames per segment)\n", m_segmentIdx, m_segmentSize );
+  }
 #if NH_MV
   printf("Profile                           :");
   for (Int i = 0; i < m_profiles.size(); i++)
@@ -3545,6 +3708,24 @@ Void TAppEncCfg::xPrintParameter()
   printf("Disp search range restriction     : %d\n", m_bUseDisparitySearchRangeRestriction );
   printf("Vertical disp search range        : %d\n", m_iVerticalDisparitySearchRange );
 #endif
+#if NH_3D_IV_MOTION_SEED
+  if ( m_bUseIvMotionSeed )
+  {
+    printf("Inter-view motion seed range      : %d\n", m_iIvMotionSeedSearchRange );
+  }
+#endif
+#if NH_MV_PYRAMID_ME
+  if ( m_bUsePyramidME )
+  {
+    printf("Pyramid ME refinement range       : %d\n", m_iPyramidMERefineRange );
+  }
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  if ( m_numRatePoints > 1 && m_bUseRatePointMotionSeed )
+  {
+    printf("Rate point motion seed range      : %d\n", m_iRatePointMotionSeedSearchRange );
+  }
+#endif
 #if NH_MV
   xPrintParaVector( "Intra period", m_iIntraPeriod );
 #else
@@ -3676,6 +3857,7 @@ Void TAppEncCfg::xPrintParameter()
     printf("VSO LS Table                      : %d\n",    m_bVSOLSTable ? 1 : 0);
     printf("VSO Estimated VSD                 : %d\n",    m_bUseEstimatedVSD ? 1 : 0);
     printf("VSO Early Skip                    : %d\n",    m_bVSOEarlySkip ? 1 : 0);   
+    printf("VSO Incremental Setup             : %d\n",    m_bVSOIncrementalSetup ? 1 : 0);
     if ( m_bUseWVSO )
     {
       printf("Dist. Weights (VSO/VSD/SAD)       : %d/%d/%d\n ", m_iVSOWeight, m_iVSDWeight, m_iDWeight );    
@@ -3744,6 +3926,12 @@ Void TAppEncCfg::xPrintParameter()
 
   printf(" SignBitHidingFlag:%d ", m_signHideFlag);
   printf("RecalQP:%d", m_recalculateQPAccordingToLambda ? 1 : 0 );
+#if NH_MV_SUBPEL_PLANE_CACHE
+  printf(" SubPelPlaneCache:%d", m_bUseSubPelPlaneCache ? 1 : 0 );
+#endif
+#if NH_MV_PIC_ANALYSIS
+  printf(" PicAnalysis:%d FastIntra:%d", m_bUsePicAnalysis ? 1 : 0, m_bUsePicAnalysisFastIntra ? 1 : 0 );
+#endif
 #if NH_3D_VSO
   printf(" VSO:%d ", m_bUseVSO   );
   printf("WVSO:%d ", m_bUseWVSO );  
@@ -3751,6 +3939,9 @@ Void TAppEncCfg::xPrintParameter()
 #if NH_3D_QTL
   printf( "QTL:%d "                  , m_bUseQTL);
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  printf( "TexGuidedDepthMD:%d "     , m_bUseTexGuidedDepthMD ? 1 : 0 );
+#endif
 #if NH_3D
   printf( "IlluCompEnable:%d "       , m_abUseIC);
   printf( "IlluCompLowLatencyEnc:%d ",  m_bUseLowLatencyICEnc);
@@ -68,6 +68,11 @@ protected:
   std::string m_bitstreamFileName;                            ///< output bitstream file
 #if NH_MV
   std::vector<char*>     m_pchReconFileList;                  ///< output reconstruction file names
+  Int                    m_numRatePoints;                     ///< number of rate points encoded in one run
+  Int                    m_ratePoint;                         ///< rate point currently encoded
+  std::vector< std::vector<Double> > m_multiRateQP;           ///< QPs for each layer of the additional rate points
+  StringAry1d            m_multiRateBitstreamFileName;        ///< output bitstream files of the additional rate points
+  StringAry2d            m_multiRateReconFileName;            ///< output reconstruction files for each layer of the additional rate points
   Int                    m_numberOfLayers;                    ///< number of Layers to Encode
   Int                    m_iNumberOfViews;                    ///< number of Layers that are views
 #else
@@ -144,6 +149,8 @@ protected:
   Int       m_iFrameRate;                                     ///< source frame-rates (Hz)
   UInt      m_FrameSkip;                                   ///< number of skipped frames from the beginning
   UInt      m_temporalSubsampleRatio;                         ///< temporal subsample ratio, 2 means code every two frames
+  Int       m_segmentSize;                                    ///< number of frames of a segment encoded for stitching, 0: encode the whole sequence
+  Int       m_segmentIdx;                                     ///< index of the segment encoded
   Int       m_iSourceWidth;                                   ///< source width in pixel
   Int       m_iSourceHeight;                                  ///< source height in pixel (when interlaced = field height)
 
@@ -221,6 +228,7 @@ protected:
 #else
   UInt      m_log2SaoOffsetScale[MAX_NUM_CHANNEL_TYPE];       ///< number of bits for the upward bit shift operation on the decoded SAO offsets
 #endif
+  Int       m_saoOffsetBitShift[MAX_NUM_CHANNEL_TYPE];        ///< SAO bit-shift as configured, negative for automatic derivation from the QP
   Bool      m_useTransformSkip;                               ///< flag for enabling intra transform skipping
   Bool      m_useTransformSkipFast;                           ///< flag for enabling fast intra transform skipping
   UInt      m_log2MaxTransformSkipBlockSize;                  ///< transform-skip maximum size (minimum of 2)
@@ -360,6 +368,25 @@ protected:
 #if NH_MV
   Bool      m_bUseDisparitySearchRangeRestriction;            ///< restrict vertical search range for inter-view prediction
   Int       m_iVerticalDisparitySearchRange;                  ///< ME vertical search range for inter-view prediction
+#endif
+#if NH_3D_IV_MOTION_SEED
+  Bool      m_bUseIvMotionSeed;                               ///< seed dependent texture view ME with base view motion
+  Int       m_iIvMotionSeedSearchRange;                       ///< ME search range when the base view motion is the best start point
+#endif
+#if NH_MV_PYRAMID_ME
+  Bool      m_bUsePyramidME;                                  ///< coarse to fine integer ME on downsampled luma planes
+  Int       m_iPyramidMERefineRange;                          ///< full resolution search range around the coarse motion vector
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  Bool      m_bUseRatePointMotionSeed;                        ///< seed the ME of the additional rate points with the motion of the first one
+  Int       m_iRatePointMotionSeedSearchRange;                ///< ME search range when that motion is the best start point
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  Bool      m_bUseSubPelPlaneCache;                           ///< fractional ME reads from interpolated reference planes built once per picture
+#endif
+#if NH_MV_PIC_ANALYSIS
+  Bool      m_bUsePicAnalysis;                                ///< 8x8 block analysis of each input picture, reused by RC and AQ
+  Bool      m_bUsePicAnalysisFastIntra;                       ///< skip intra in inter slices when the analysis shows good temporal prediction
 #endif
   FastInterSearchMode m_fastInterSearchMode;                  ///< Parameter that controls fast encoder settings
   Bool      m_bUseEarlyCU;                                    ///< flag for using Early CU setting
@@ -556,9 +583,11 @@ protected:
   Bool      m_bUseVSO;                                        ///< flag for using View Synthesis Optimization
   Bool      m_bVSOLSTable;                                    ///< Depth QP dependent Lagrange parameter optimization (m23714)
   Bool      m_bVSOEarlySkip;                                  ///< Early skip of VSO computation (JCT3V-A0093 modification 4)
+  Bool      m_bVSOIncrementalSetup;                           ///< render initial synthesized views once per slice, CTU rows only move the window of the renderer model
                                                               
   //// Used for development by GT, might be removed later     
   Double    m_dLambdaScaleVSO;                                ///< Scaling factor for Lambda in VSO mode
+  Double    m_dLambdaScaleVSOCfg;                             ///< Scaling factor for Lambda in VSO mode as configured, before QP dependent table scaling
   Bool      m_bForceLambdaScaleVSO;                           ///< Use Lambda Scale for depth even if VSO is turned off
   Bool      m_bAllowNegDist;                                  ///< Allow negative distortion in VSO
   UInt      m_uiVSOMode;                                      ///< Number of VSO Mode, 1 = , 2 = simple, org vs. ren, 3 = simple, ren vs. ren, 4 = full  
@@ -581,6 +610,10 @@ protected:
 #if NH_3D_QTL
   Bool       m_bUseQTL;                                        ///< flag for using depth QuadTree Limitation
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  Bool       m_bUseTexGuidedDepthMD;                           ///< prune depth mode decision candidates with the texture edge and skip map
+  Int        m_iTexGuidedDepthEdgeThr;                         ///< texture sample difference regarded as edge
+#endif
 #if NH_3D
   BoolAry1d  m_ivMvPredFlag;
   BoolAry1d  m_ivMvScalingFlag;
@@ -602,6 +635,14 @@ protected:
   Void  xCheckParameter ();                                   ///< check validity of configuration values
   Void  xPrintParameter ();                                   ///< print configuration values
   Void  xPrintUsage     ();                                   ///< print usage
+  Void  xSetQPDependentParameters();                          ///< derive slice QPs and SAO offset scaling from the key-picture QPs
+  Void  xReadDQPFile    ();                                   ///< read QP offset for each slice from external file
+#if NH_3D_VSO
+  Void  xSetLambdaScaleVSO();                                 ///< derive VSO lambda scaling from the QP of the first depth layer
+#endif
+#if NH_MV
+  Void  xSetRatePoint   ( Int ratePoint );                    ///< switch QPs and output files to the given rate point
+#endif
 #if NH_MV
 
   template<typename T>
@@ -59,7 +59,9 @@ TAppEncTop::TAppEncTop()
 {
 
 #if NH_MV
-  m_vps = new TComVPS; 
+  m_vps               = NULL;
+  m_ivPicLists        = NULL;
+  m_selectedRatePoint = 0;
 #else
   m_iFrameRcvd = 0;
 #endif
@@ -74,6 +76,15 @@ TAppEncTop::~TAppEncTop()
   {
    delete m_vps; 
   };
+  if (m_ivPicLists)
+  {
+    delete m_ivPicLists;
+  }
+  for( Int ratePoint = 0; ratePoint < (Int) m_ratePointLibs.size(); ratePoint++ )
+  {
+    delete m_ratePointLibs[ ratePoint ].m_vps;
+    delete m_ratePointLibs[ ratePoint ].m_ivPicLists;
+  }
 #endif
 
 }
@@ -90,10 +101,6 @@ Void TAppEncTop::xInitLibCfg()
   vps.createCamPars(m_iNumberOfViews);  
 #endif
 
-#if NH_3D_DLT
-  TComDLT dlt = TComDLT();
-#endif
-
 #if NH_MV
   Int maxTempLayer = -1; 
   for (Int j = 0; j < m_numberOfLayers; j++)
@@ -148,10 +155,14 @@ Void TAppEncTop::xInitLibCfg()
   xSetCamPara              ( vps ); 
 #endif
 #if NH_3D_VSO || NH_3D
-  m_ivPicLists.setVPS      ( &vps );
+  m_ivPicLists->setVPS     ( &vps );
 #endif
 #if NH_3D_DLT
-  xDeriveDltArray          ( vps, &dlt );
+  // the depth analysis only depends on the input, it is shared by all rate points
+  if ( m_ratePoint == 0 )
+  {
+    xDeriveDltArray        ( vps, &m_dlt );
+  }
 #endif
   if ( m_targetEncLayerIdList.size() == 0 )
   {
@@ -214,9 +225,13 @@ Void TAppEncTop::xInitLibCfg()
   /// Create encoders and set profiles profiles
   for(Int layerIdInVps = 0; layerIdInVps < m_numberOfLayers; layerIdInVps++)
   {
-    m_frameRcvd                 .push_back(0);
+    if ( m_ratePoint == 0 )
+    {
+      // the input is read once for all rate points
+      m_frameRcvd                 .push_back(0);
+      m_acTVideoIOYuvInputFileList.push_back(new TVideoIOYuv);
+    }
     m_acTEncTopList             .push_back(new TEncTop); 
-    m_acTVideoIOYuvInputFileList.push_back(new TVideoIOYuv);
     m_acTVideoIOYuvReconFileList.push_back(new TVideoIOYuv);
 #if NH_3D    
     Int profileIdc = -1; 
@@ -270,7 +285,7 @@ Void TAppEncTop::xInitLibCfg()
 
     Int layerId = vps.getLayerIdInNuh          ( layerIdInVps );
 #if NH_MV
-    m_ivPicLists.getSubDpb( layerId, true ); 
+    m_ivPicLists->getSubDpb( layerId, true ); 
 #endif
 
     m_cTEncTop.setLayerIdInVps                 ( layerIdInVps ); 
@@ -296,6 +311,7 @@ Void TAppEncTop::xInitLibCfg()
 
     // SAIT_VSO_EST_A0033
     m_cTEncTop.setUseEstimatedVSD              ( isDepth || isAuxDepth ? m_bUseEstimatedVSD     : false );
+    m_cTEncTop.setVSOIncrementalSetup          ( m_bVSOIncrementalSetup );
 
     // LGE_WVSO_A0119
     m_cTEncTop.setUseWVSO                      ( isDepth || isAuxDepth ? m_bUseWVSO             : false );   
@@ -317,16 +333,23 @@ Void TAppEncTop::xInitLibCfg()
 #if NH_3D_QTL
     m_cTEncTop.setUseQTL                       ( isDepth || isAuxDepth ? m_bUseQTL  : false );
 #endif
+#if NH_3D_TEX_GUIDED_MD
+    // texture layers build the map, depth layers use it
+    m_cTEncTop.setUseTexGuidedDepthMD          ( m_bUseTexGuidedDepthMD );
+    m_cTEncTop.setTexGuidedDepthEdgeThr        ( m_iTexGuidedDepthEdgeThr );
+#endif
 #if NH_3D
     m_cTEncTop.setSps3dExtension               ( m_sps3dExtension );
 #endif // NH_3D
 
-    m_cTEncTop.setIvPicLists                   ( &m_ivPicLists ); 
+    m_cTEncTop.setIvPicLists                   ( m_ivPicLists ); 
+    // the QP independent analysis and the motion of the first rate point are reused by the other ones
+    m_cTEncTop.setFirstRatePointEncTop         ( m_ratePoint > 0 ? m_ratePointLibs[ 0 ].m_acTEncTopList[ layerIdInVps ] : NULL );
 #endif  // NH_MV
   m_cTEncTop.setVPS(&vps);
 
 #if NH_3D_DLT
-  m_cTEncTop.setDLT(dlt);
+  m_cTEncTop.setDLT(m_dlt);
 #endif
 
 #if NH_MV
@@ -436,6 +459,25 @@ Void TAppEncTop::xInitLibCfg()
 #if NH_MV
   m_cTEncTop.setUseDisparitySearchRangeRestriction                ( m_bUseDisparitySearchRangeRestriction );
   m_cTEncTop.setVerticalDisparitySearchRange                      ( m_iVerticalDisparitySearchRange );
+#endif
+#if NH_3D_IV_MOTION_SEED
+  m_cTEncTop.setUseIvMotionSeed                                   ( m_bUseIvMotionSeed );
+  m_cTEncTop.setIvMotionSeedSearchRange                           ( m_iIvMotionSeedSearchRange );
+#endif
+#if NH_MV_PYRAMID_ME
+  m_cTEncTop.setUsePyramidME                                      ( m_bUsePyramidME );
+  m_cTEncTop.setPyramidMERefineRange                              ( m_iPyramidMERefineRange );
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  m_cTEncTop.setUseRatePointMotionSeed                            ( m_bUseRatePointMotionSeed );
+  m_cTEncTop.setRatePointMotionSeedSearchRange                    ( m_iRatePointMotionSeedSearchRange );
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  m_cTEncTop.setUseSubPelPlaneCache                               ( m_bUseSubPelPlaneCache );
+#endif
+#if NH_MV_PIC_ANALYSIS
+  m_cTEncTop.setUsePicAnalysis                                    ( m_bUsePicAnalysis );
+  m_cTEncTop.setUsePicAnalysisFastIntra                           ( m_bUsePicAnalysisFastIntra );
 #endif
   //====== Quality control ========
   m_cTEncTop.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
@@ -571,6 +613,7 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setDecodedPictureHashSEIType                         ( m_decodedPictureHashSEIType );
   m_cTEncTop.setRecoveryPointSEIEnabled                           ( m_recoveryPointSEIEnabled );
   m_cTEncTop.setBufferingPeriodSEIEnabled                         ( m_bufferingPeriodSEIEnabled );
+  m_cTEncTop.setBufferingPeriodConcatenationFlag                  ( m_segmentSize > 0 && m_segmentIdx > 0 );
   m_cTEncTop.setPictureTimingSEIEnabled                           ( m_pictureTimingSEIEnabled );
   m_cTEncTop.setToneMappingInfoSEIEnabled                         ( m_toneMappingInfoSEIEnabled );
   m_cTEncTop.setTMISEIToneMapId                                   ( m_toneMapId );
@@ -811,29 +854,40 @@ Void TAppEncTop::xInitLibCfg()
   {
     if ( m_uiVSOMode == 4 )
     {
-#if H_3D_VSO_EARLY_SKIP
-      m_cRendererModel.create( m_cRenModStrParser.getNumOfBaseViews(), m_cRenModStrParser.getNumOfModels(), m_iSourceWidth, m_uiMaxCUHeight , LOG2_DISP_PREC_LUT, 0, true, m_bVSOEarlySkip );
-#else
-      m_cRendererModel.create( m_cRenModStrParser.getNumOfBaseViews(), m_cRenModStrParser.getNumOfModels(), m_iSourceWidth, m_uiMaxCUHeight , LOG2_DISP_PREC_LUT, 0 , true);
-#endif
+      // with incremental setup the model holds all CTU rows of a slice, otherwise a single CTU row
+      Int iRenModelHeight = m_bVSOIncrementalSetup ? m_iSourceHeight : (Int) m_uiMaxCUHeight;
+
       for ( Int layer = 0; layer < m_numberOfLayers ; layer++ )
       {
         TEncTop* pcEncTop =  m_acTEncTopList[ layer ]; 
-        Int iViewNum      = pcEncTop->getViewIndex(); 
+        // the renderer model configuration is given for the views sorted by camera position, like in TEncTop::deriveRenModelSetup
+        Int iViewSIdx     = m_cCameraData.getBaseId2SortedId()[ pcEncTop->getViewIndex() ];
         Int iContent      = pcEncTop->getIsDepth() || pcEncTop->getIsAuxDepth() ? 1 : 0; 
-        Int iNumOfModels  = m_cRenModStrParser.getNumOfModelsForView(iViewNum, iContent);
+        Int iNumOfModels  = m_cRenModStrParser.getNumOfModelsForView(iViewSIdx, iContent);
 
         Bool bUseVSO      = (iNumOfModels != 0);
 
         pcEncTop->setUseVSO( bUseVSO );
-        pcEncTop->getRdCost()->setRenModel( bUseVSO ? &m_cRendererModel : NULL );
+
+        // each layer renders with the model of its own search instance, the model setup of a slice is derived once and only read
+        TRenModel* pcRenModel = bUseVSO ? pcEncTop->getPredSearch()->getRenModel() : NULL;
+        pcEncTop->getRdCost()->setRenModel( pcRenModel );
+
+        if ( bUseVSO )
+        {
+#if H_3D_VSO_EARLY_SKIP
+          pcRenModel->create( m_cRenModStrParser.getNumOfBaseViews(), m_cRenModStrParser.getNumOfModels(), m_iSourceWidth, iRenModelHeight, LOG2_DISP_PREC_LUT, 0, true, m_bVSOEarlySkip );
+#else
+          pcRenModel->create( m_cRenModStrParser.getNumOfBaseViews(), m_cRenModStrParser.getNumOfModels(), m_iSourceWidth, iRenModelHeight, LOG2_DISP_PREC_LUT, 0 , true);
+#endif
+        }
 
         for (Int iCurModel = 0; iCurModel < iNumOfModels; iCurModel++ )
         {
           Int iModelNum; Int iLeftViewNum; Int iRightViewNum; Int iDump; Int iOrgRefNum; Int iBlendMode;
 
-          m_cRenModStrParser.getSingleModelData  ( iViewNum, iContent, iCurModel, iModelNum, iBlendMode, iLeftViewNum, iRightViewNum, iOrgRefNum, iDump ) ;
-          m_cRendererModel  .createSingleModel   ( iViewNum, iContent, iModelNum, iLeftViewNum, iRightViewNum, (iOrgRefNum != -1), iBlendMode );
+          m_cRenModStrParser.getSingleModelData  ( iViewSIdx, iContent, iCurModel, iModelNum, iBlendMode, iLeftViewNum, iRightViewNum, iOrgRefNum, iDump ) ;
+          pcRenModel       ->createSingleModel   ( iViewSIdx, iContent, iModelNum, iLeftViewNum, iRightViewNum, (iOrgRefNum != -1), iBlendMode );
         }            
       }
     }
@@ -848,16 +902,22 @@ Void TAppEncTop::xInitLibCfg()
 Void TAppEncTop::xCreateLib()
 {
 #if NH_MV
-  // initialize global variables
-  initROM();
+  // initialize global variables, shared by all rate points
+  if ( m_ratePoint == 0 )
+  {
+    initROM();
 #if NH_3D_DMM
-  initWedgeLists( true );
+    initWedgeLists( true );
 #endif
+  }
 
   for( Int layer=0; layer < m_numberOfLayers; layer++)
   {
-    m_acTVideoIOYuvInputFileList[layer]->open( m_pchInputFileList[layer],     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
-    m_acTVideoIOYuvInputFileList[layer]->skipFrames( m_FrameSkip, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
+    if ( m_ratePoint == 0 )
+    {
+      m_acTVideoIOYuvInputFileList[layer]->open( m_pchInputFileList[layer],     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
+      m_acTVideoIOYuvInputFileList[layer]->skipFrames( m_FrameSkip, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
+    }
 
     if (m_pchReconFileList[layer])
     {
@@ -886,20 +946,28 @@ Void TAppEncTop::xDestroyLib()
   // destroy ROM
   destroyROM();
 
+  for( Int ratePoint = 0; ratePoint < m_numRatePoints; ratePoint++ )
+  {
+    xSelectRatePoint( ratePoint );
+    for(Int layer=0; layer<m_numberOfLayers; layer++)
+    {
+      m_acTVideoIOYuvReconFileList[layer]->close();
+      delete m_acTVideoIOYuvReconFileList[layer] ; 
+      m_acTVideoIOYuvReconFileList[layer] = NULL;
+      m_acTEncTopList[layer]->deletePicBuffer();
+      m_acTEncTopList[layer]->destroy();
+      delete m_acTEncTopList[layer] ; 
+      m_acTEncTopList[layer] = NULL;
+      delete m_cListPicYuvRec[layer] ; 
+      m_cListPicYuvRec[layer] = NULL;
+    }
+  }
+
   for(Int layer=0; layer<m_numberOfLayers; layer++)
   {
     m_acTVideoIOYuvInputFileList[layer]->close();
-    m_acTVideoIOYuvReconFileList[layer]->close();
     delete m_acTVideoIOYuvInputFileList[layer] ; 
     m_acTVideoIOYuvInputFileList[layer] = NULL;
-    delete m_acTVideoIOYuvReconFileList[layer] ; 
-    m_acTVideoIOYuvReconFileList[layer] = NULL;
-    m_acTEncTopList[layer]->deletePicBuffer();
-    m_acTEncTopList[layer]->destroy();
-    delete m_acTEncTopList[layer] ; 
-    m_acTEncTopList[layer] = NULL;
-    delete m_cListPicYuvRec[layer] ; 
-    m_cListPicYuvRec[layer] = NULL;
   }
 #else
   // Video I/O
@@ -927,6 +995,33 @@ Void TAppEncTop::xInitLib(Bool isFieldCoding)
 #endif
 }
 
+#if NH_MV
+/** Make the encoder instances and output files of a rate point the current ones. The libs of the previously selected
+    rate point are stored in m_ratePointLibs.
+ */
+Void TAppEncTop::xSelectRatePoint( Int ratePoint )
+{
+  for( Int i = 0; i < 2; i++ )
+  {
+    RatePointLib& lib = m_ratePointLibs[ i == 0 ? m_selectedRatePoint : ratePoint ];
+    std::swap( m_acTEncTopList             , lib.m_acTEncTopList              );
+    std::swap( m_acTVideoIOYuvReconFileList, lib.m_acTVideoIOYuvReconFileList );
+    std::swap( m_cListPicYuvRec            , lib.m_cListPicYuvRec             );
+    std::swap( m_ivPicLists                , lib.m_ivPicLists                 );
+    std::swap( m_vps                       , lib.m_vps                        );
+    std::swap( m_essentialBytes            , lib.m_essentialBytes             );
+    std::swap( m_totalBytes                , lib.m_totalBytes                 );
+  }
+  m_selectedRatePoint = ratePoint;
+
+  if ( m_vps == NULL )
+  {
+    m_vps        = new TComVPS;
+    m_ivPicLists = new TComPicLists;
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -941,22 +1036,55 @@ Void TAppEncTop::xInitLib(Bool isFieldCoding)
  */
 Void TAppEncTop::encode()
 {
+#if NH_MV
+  // all rate points are encoded in lockstep: each input picture is read once and each access unit is coded at all
+  // rate points before the next one, such that the QP independent analysis and the motion of the first rate point
+  // can be reused by the other ones
+  m_ratePointLibs.resize( m_numRatePoints );
+  std::vector<fstream*> bitstreamFiles;
+  for( Int ratePoint = 0; ratePoint < m_numRatePoints; ratePoint++ )
+  {
+    if ( ratePoint > 0 )
+    {
+      xSetRatePoint( ratePoint );
+      printf("\nRate point %d\n", ratePoint );
+      printf("Bitstream      File                    : %s\n", m_bitstreamFileName.c_str() );
+      xPrintParaVector( "QP", m_fQP );
+    }
+
+    bitstreamFiles.push_back( new fstream( m_bitstreamFileName.c_str(), fstream::binary | fstream::out ) );
+    if (!*bitstreamFiles.back())
+    {
+      fprintf(stderr, "\nfailed to open bitstream file `%s' for writing\n", m_bitstreamFileName.c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    // initialize internal class & member variables
+    xSelectRatePoint( ratePoint );
+    xInitLibCfg();
+    xCreateLib();
+    xInitLib(m_isField);
+  }
+#else
   fstream bitstreamFile(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
   if (!bitstreamFile)
   {
     fprintf(stderr, "\nfailed to open bitstream file `%s' for writing\n", m_bitstreamFileName.c_str());
     exit(EXIT_FAILURE);
   }
+#endif
 
 #if !NH_3D
   TComPicYuv*       pcPicYuvOrg = new TComPicYuv;
 #endif
   TComPicYuv*       pcPicYuvRec = NULL;
 
+#if !NH_MV
   // initialize internal class & member variables
   xInitLibCfg();
   xCreateLib();
   xInitLib(m_isField);
+#endif
 
   printChromaFormat();
 
@@ -1025,12 +1153,17 @@ Void TAppEncTop::encode()
       Int frmCnt = 0;
       while ( !eos[layer] && !(frmCnt == gopSize))
       {
-        // get buffers
-        xGetBuffer(pcPicYuvRec, layer);
-
         // read input YUV file        
         m_acTVideoIOYuvInputFileList[layer]->read      ( pcPicYuvOrg, &cPicYuvTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC );
-        m_acTEncTopList             [layer]->initNewPic( pcPicYuvOrg );
+
+        for( Int ratePoint = 0; ratePoint < m_numRatePoints; ratePoint++ )
+        {
+          xSelectRatePoint( ratePoint );
+
+          // get buffers
+          xGetBuffer(pcPicYuvRec, layer);
+          m_acTEncTopList[layer]->initNewPic( pcPicYuvOrg );
+        }
 
         // increase number of received frames
         m_frameRcvd[layer]++;
@@ -1046,7 +1179,11 @@ Void TAppEncTop::encode()
           flush          [layer] = true;
           eos            [layer] = true;
           m_frameRcvd    [layer]--;
-          m_acTEncTopList[layer]->setFramesToBeEncoded(m_frameRcvd[layer]);
+          for( Int ratePoint = 0; ratePoint < m_numRatePoints; ratePoint++ )
+          {
+            xSelectRatePoint( ratePoint );
+            m_acTEncTopList[layer]->setFramesToBeEncoded(m_frameRcvd[layer]);
+          }
         }
       }
     }
@@ -1059,16 +1196,19 @@ Void TAppEncTop::encode()
         m_cCameraData.update( iNextPoc );
       }
 #endif
-      for(Int layer=0; layer < m_numberOfLayers; layer++ )
+      for( Int ratePoint = 0; ratePoint < m_numRatePoints; ratePoint++ )
       {
+        xSelectRatePoint( ratePoint );
+        for(Int layer=0; layer < m_numberOfLayers; layer++ )
+        {
 #if NH_3D
-        TComPicYuv* pcPicYuvOrg    =  picYuvOrg    [ m_depthFlag[layer] ];
-        TComPicYuv& cPicYuvTrueOrg =  picYuvTrueOrg[ m_depthFlag[layer] ];
+          TComPicYuv* pcPicYuvOrg    =  picYuvOrg    [ m_depthFlag[layer] ];
+          TComPicYuv& cPicYuvTrueOrg =  picYuvTrueOrg[ m_depthFlag[layer] ];
 #endif
-        if (!xLayerIdInTargetEncLayerIdList( m_vps->getLayerIdInNuh( layer ) ))
-        {
-          continue; 
-        }
+          if (!xLayerIdInTargetEncLayerIdList( m_vps->getLayerIdInNuh( layer ) ))
+          {
+            continue; 
+          }
 
 #if NH_3D_VSO        
           if( m_bUseVSO && m_bUseEstimatedVSD && iNextPoc < m_framesToBeEncoded )
@@ -1078,24 +1218,36 @@ Void TAppEncTop::encode()
           }
 #endif
 
-        Int   iNumEncoded = 0;
+          Int   iNumEncoded = 0;
 
-        // call encoding function for one frame                               
-        m_acTEncTopList[layer]->encode( eos[layer], flush[layer] ? 0 : pcPicYuvOrg, flush[layer] ? 0 : &cPicYuvTrueOrg, snrCSC, *m_cListPicYuvRec[layer], outputAccessUnits, iNumEncoded, gopId );        
-        xWriteOutput(bitstreamFile, iNumEncoded, outputAccessUnits, layer);
-        outputAccessUnits.clear();
+          // call encoding function for one frame                               
+          m_acTEncTopList[layer]->encode( eos[layer], flush[layer] ? 0 : pcPicYuvOrg, flush[layer] ? 0 : &cPicYuvTrueOrg, snrCSC, *m_cListPicYuvRec[layer], outputAccessUnits, iNumEncoded, gopId );        
+          xWriteOutput(*bitstreamFiles[ratePoint], iNumEncoded, outputAccessUnits, layer);
+          outputAccessUnits.clear();
+        }
       }
     }
 
     gopSize = maxGopSize;
   }
-  for(Int layer=0; layer < m_numberOfLayers; layer++ )
+  for( Int ratePoint = 0; ratePoint < m_numRatePoints; ratePoint++ )
   {
-    if (!xLayerIdInTargetEncLayerIdList( m_vps->getLayerIdInNuh( layer ) ))
+    xSelectRatePoint( ratePoint );
+    if ( ratePoint > 0 )
     {
-      continue; 
-    }    
-    m_acTEncTopList[layer]->printSummary(m_isField);
+      printf("\nRate point %d\n", ratePoint );
+    }
+    for(Int layer=0; layer < m_numberOfLayers; layer++ )
+    {
+      if (!xLayerIdInTargetEncLayerIdList( m_vps->getLayerIdInNuh( layer ) ))
+      {
+        continue; 
+      }    
+      m_acTEncTopList[layer]->printSummary(m_isField);
+    }
+    printRateSummary();
+    xDeleteBuffer();
+    delete bitstreamFiles[ ratePoint ];
   }
 #else
 
@@ -1174,10 +1326,14 @@ Void TAppEncTop::encode()
 #endif
 
   // delete buffers & classes
+#if NH_MV
+  xDestroyLib();
+#else
   xDeleteBuffer();
   xDestroyLib();
 
   printRateSummary();
+#endif
 
 #if NH_3D_REN_MAX_DEV_OUT
   Double dMaxDispDiff = m_cCameraData.getMaxShiftDeviation(); 
@@ -1303,7 +1459,8 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
       TComPicYuv*  pcPicYuvRecBottom  = *(iterPicYuvRec++);
 
 #if NH_MV
-      if (m_pchReconFileList[layerIdx])
+      // the file names of the configuration are the ones of the last rate point
+      if (m_acTVideoIOYuvReconFileList[layerIdx]->isOpen())
       {
 #if NH_3D
         m_acTVideoIOYuvReconFileList[layerIdx]->write( pcPicYuvRecTop, pcPicYuvRecBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, m_depth420OutputFlag && m_depthFlag[layerIdx ] ? CHROMA_420 : NUM_CHROMA_FORMAT, m_isTopFieldFirst );
@@ -1360,7 +1517,8 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
     {
       TComPicYuv*  pcPicYuvRec  = *(iterPicYuvRec++);
 #if NH_MV
-      if (m_pchReconFileList[layerIdx])
+      // the file names of the configuration are the ones of the last rate point
+      if (m_acTVideoIOYuvReconFileList[layerIdx]->isOpen())
       {
 #if NH_3D
         m_acTVideoIOYuvReconFileList[layerIdx]->write( pcPicYuvRec, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, m_depth420OutputFlag && m_depthFlag[layerIdx ] ? CHROMA_420 : NUM_CHROMA_FORMAT  );
@@ -73,7 +73,7 @@ private:
 
   std::vector<Int>           m_frameRcvd;                   ///< number of received frames 
 
-  TComPicLists               m_ivPicLists;                  ///< picture buffers of encoder instances
+  TComPicLists*              m_ivPicLists;                  ///< picture buffers of encoder instances
 #if NH_MV
   TComVPS*                   m_vps;                         ///< vps
 #else
@@ -95,9 +95,28 @@ private:
 
   UInt m_essentialBytes;
   UInt m_totalBytes;
+#if NH_3D_DLT
+  TComDLT                     m_dlt;                        ///< depth lookup tables, derived once and shared by all rate points
+#endif
+#if NH_MV
+  /// encoder instances and outputs of a rate point, exchanged with the members above when the rate point is selected
+  struct RatePointLib
+  {
+    std::vector<TEncTop*>                m_acTEncTopList;
+    std::vector<TVideoIOYuv*>            m_acTVideoIOYuvReconFileList;
+    std::vector<TComList<TComPicYuv*>*>  m_cListPicYuvRec;
+    TComPicLists*                        m_ivPicLists;
+    TComVPS*                             m_vps;
+    UInt                                 m_essentialBytes;
+    UInt                                 m_totalBytes;
+
+    RatePointLib() : m_ivPicLists( NULL ), m_vps( NULL ), m_essentialBytes( 0 ), m_totalBytes( 0 ) {}
+  };
+  std::vector<RatePointLib>   m_ratePointLibs;              ///< libs of the rate points, the one of the selected rate point is held by the members
+  Int                         m_selectedRatePoint;          ///< rate point of the libs held by the members
+#endif
 #if NH_3D_VSO
   TRenTop                     m_cRendererTop; 
-  TRenModel                   m_cRendererModel;   
 #endif
 protected:
   // initialization
@@ -105,6 +124,9 @@ protected:
   Void  xInitLibCfg       ();                               ///< initialize internal variables
   Void  xInitLib          (Bool isFieldCoding);             ///< initialize encoder class
   Void  xDestroyLib       ();                               ///< destroy encoder class
+#if NH_MV
+  Void  xSelectRatePoint  ( Int ratePoint );                ///< make the libs of a rate point the current ones
+#endif
 
   /// obtain required buffers
 #if NH_MV
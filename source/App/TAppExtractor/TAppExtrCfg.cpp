@@ -64,6 +64,14 @@ Bool TAppExtrCfg::parseCfg( Int argc, TChar* argv[] )
   string cfg_OutputBitstreamFile;
   string cfg_SpsInfoFile;
   string cfg_ExtractLayerIds;
+  Int    cfg_LayerSetIdx;
+  Int    cfg_MaxTemporalId;
+#if NH_MV
+  std::vector<char*> cfg_OutputBitstreamFiles;
+  std::vector<char*> cfg_ExtractLayerIdsList;
+  IntAry2d           cfg_LayerSetIdxList;
+  IntAry2d           cfg_MaxTemporalIdList;
+#endif
 
   po::Options opts;
   opts.addOptions()
@@ -72,6 +80,14 @@ Bool TAppExtrCfg::parseCfg( Int argc, TChar* argv[] )
   ("OutputBitstreamFile,o",  cfg_OutputBitstreamFile,   string(""), "bitstream output file name")
   ("SpsInfoFile,s",          cfg_SpsInfoFile,           string(""), "SPS info file name")
   ("ExtractLayerIds,e",      cfg_ExtractLayerIds,       string(""), "comma-separated list of layer IDs for extraction")
+  ("LayerSetIdx,l",          cfg_LayerSetIdx,           -1,         "index of the VPS layer set to be extracted instead of ExtractLayerIds")
+  ("MaxTemporalId,t",        cfg_MaxTemporalId,         -1,         "highest TemporalId to be extracted (-1: all)")
+#if NH_MV
+  ("OutputBitstreamFile_%d", cfg_OutputBitstreamFiles,  (char *) 0, MAX_NUM_EXTR_OUTPUTS, "bitstream output file name of additional operation point %d, all outputs are written in one pass")
+  ("ExtractLayerIds_%d",     cfg_ExtractLayerIdsList,   (char *) 0, MAX_NUM_EXTR_OUTPUTS, "comma-separated list of layer IDs for extraction of operation point %d")
+  ("LayerSetIdx_%d",         cfg_LayerSetIdxList,       IntAry1d(1,-1), MAX_NUM_EXTR_OUTPUTS, "index of the VPS layer set of operation point %d")
+  ("MaxTemporalId_%d",       cfg_MaxTemporalIdList,     IntAry1d(1,-1), MAX_NUM_EXTR_OUTPUTS, "highest TemporalId of operation point %d")
+#endif
   ;
 
   po::setDefaults(opts);
@@ -90,10 +106,23 @@ Bool TAppExtrCfg::parseCfg( Int argc, TChar* argv[] )
 
   /* convert std::string to c string for compatability */
   m_pchInputBitstreamFile = cfg_InputBitstreamFile.empty() ? NULL : strdup(cfg_InputBitstreamFile.c_str());
-  m_pchOutputBitstreamFile = cfg_OutputBitstreamFile.empty() ? NULL : strdup(cfg_OutputBitstreamFile.c_str());
   m_pchSpsInfoFile = cfg_SpsInfoFile.empty() ? NULL : strdup(cfg_SpsInfoFile.c_str());
 
-  xSplitUIntString( cfg_ExtractLayerIds, m_suiExtractLayerIds );
+  if ( !cfg_OutputBitstreamFile.empty() )
+  {
+    xAddOutput( cfg_OutputBitstreamFile, cfg_ExtractLayerIds, cfg_LayerSetIdx, cfg_MaxTemporalId );
+  }
+#if NH_MV
+  for ( Int i = 0; i < MAX_NUM_EXTR_OUTPUTS; i++ )
+  {
+    if ( cfg_OutputBitstreamFiles[ i ] )
+    {
+      const Int layerSetIdx   = cfg_LayerSetIdxList  [ i ].empty() ? -1 : cfg_LayerSetIdxList  [ i ][ 0 ];
+      const Int maxTemporalId = cfg_MaxTemporalIdList[ i ].empty() ? -1 : cfg_MaxTemporalIdList[ i ][ 0 ];
+      xAddOutput( cfg_OutputBitstreamFiles[ i ], cfg_ExtractLayerIdsList[ i ] ? cfg_ExtractLayerIdsList[ i ] : "", layerSetIdx, maxTemporalId );
+    }
+  }
+#endif
 
   if (!m_pchInputBitstreamFile)
   {
@@ -101,7 +130,7 @@ Bool TAppExtrCfg::parseCfg( Int argc, TChar* argv[] )
     return false;
   }
 
-  if (!m_pchOutputBitstreamFile && !m_pchSpsInfoFile)
+  if (m_outputBitstreamFiles.empty() && !m_pchSpsInfoFile)
   {
     fprintf(stderr, "No output file specifed, aborting\n");
     return false;
@@ -110,6 +139,17 @@ Bool TAppExtrCfg::parseCfg( Int argc, TChar* argv[] )
   return true;
 }
 
+Void TAppExtrCfg::xAddOutput( const std::string& rFileName, const std::string& rLayerIds, Int layerSetIdx, Int maxTemporalId )
+{
+  std::set<UInt> layerIds;
+  xSplitUIntString( rLayerIds, layerIds );
+
+  m_outputBitstreamFiles.push_back( rFileName     );
+  m_extractLayerIds     .push_back( layerIds      );
+  m_extractLayerSetIdx  .push_back( layerSetIdx   );
+  m_extractMaxTemporalId.push_back( maxTemporalId );
+}
+
 Void TAppExtrCfg::xSplitUIntString( const std::string& rString, std::set<UInt>& rSet )
 {
   char* cString = NULL;
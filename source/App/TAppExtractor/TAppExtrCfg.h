@@ -45,6 +45,9 @@
 #include "../../Lib/TLibCommon/CommonDef.h"
 #include <string>
 #include <set>
+#include <vector>
+
+static const Int MAX_NUM_EXTR_OUTPUTS = 64;           ///< maximum number of sub-bitstreams extracted in one pass
 
 // ====================================================================================================================
 // Class definition
@@ -55,10 +58,13 @@ class TAppExtrCfg
 {
 protected:
   char*          m_pchInputBitstreamFile;              ///< input bitstream file name
-  char*          m_pchOutputBitstreamFile;             ///< output bitstream file name
   char*          m_pchSpsInfoFile;                     ///< SPS information file name
 
-  std::set<UInt> m_suiExtractLayerIds;                 ///< list of layer IDs to be extracted
+  // operation points, one output bitstream each
+  std::vector<std::string>    m_outputBitstreamFiles;  ///< output bitstream file names
+  std::vector<std::set<UInt> > m_extractLayerIds;      ///< layer IDs to be extracted, if not given by a layer set
+  std::vector<Int>            m_extractLayerSetIdx;    ///< VPS layer set to be extracted, -1: use m_extractLayerIds
+  std::vector<Int>            m_extractMaxTemporalId;  ///< highest TemporalId to be extracted, -1: all
 
 public:
   TAppExtrCfg()          {}
@@ -68,6 +74,7 @@ public:
 
 protected:
   Void  xSplitUIntString( const std::string& rString, std::set<UInt>& rList );
+  Void  xAddOutput      ( const std::string& rFileName, const std::string& rLayerIds, Int layerSetIdx, Int maxTemporalId );
 };
 
 #endif
@@ -37,11 +37,15 @@
 #include "../../Lib/TLibDecoder/AnnexBread.h"
 #include <fstream>
 #include <list>
+#include <set>
+#include <vector>
 #include <stdio.h>
 #include <fcntl.h>
 #include <assert.h>
 
 #if NH_MV
+static const size_t EXTR_WRITE_BLOCK_SIZE = 1 << 20;  ///< size of the blocks written to the output bitstreams
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -73,30 +77,39 @@ Void TAppExtrTop::extract()
     exit( EXIT_FAILURE );
   }
 
-  fstream outputBitstreamFile;
-  if( m_pchOutputBitstreamFile )
+  // all operation points are extracted in one pass over the input
+  const size_t numOutputs = m_outputBitstreamFiles.size();
+  vector<fstream*>         outputBitstreamFiles( numOutputs, NULL );
+  vector<vector<uint8_t> > outputBuffers       ( numOutputs );
+  vector<set<UInt> >       extractLayerIds     ( m_extractLayerIds );
+
+  for( size_t i = 0; i < numOutputs; i++ )
   {
-    outputBitstreamFile.open( m_pchOutputBitstreamFile, fstream::binary | fstream::out );
-    if( outputBitstreamFile.fail() )
+    outputBitstreamFiles[ i ] = new fstream( m_outputBitstreamFiles[ i ].c_str(), fstream::binary | fstream::out );
+    if( outputBitstreamFiles[ i ]->fail() )
     {
-      fprintf( stderr, "\nfailed to open bitstream file `%s' for writing\n", m_pchOutputBitstreamFile );
+      fprintf( stderr, "\nfailed to open bitstream file `%s' for writing\n", m_outputBitstreamFiles[ i ].c_str() );
       exit( EXIT_FAILURE );
     }
+    outputBuffers[ i ].reserve( EXTR_WRITE_BLOCK_SIZE );
   }
 
+  m_cTExtrTop.init();
+
   InputByteStream inputBytestream( inputBitstreamFile );
 
   Bool bEndOfFile = false;
   while( !bEndOfFile )
   {
-    streampos location = inputBitstreamFile.tellg();
-    AnnexBStats stats = AnnexBStats();
-    vector<uint8_t> nalUnit;
-    InputNALUnit nalu;
-    bEndOfFile = byteStreamNALUnit( inputBytestream, nalUnit, stats );
+    streamoff      location = inputBytestream.getPosition();
+    AnnexBStats    stats    = AnnexBStats();
+    const uint8_t* nalUnitBytes;
+    UInt           nalUnitSize;
+
+    bEndOfFile = byteStreamNALUnit( inputBytestream, nalUnitBytes, nalUnitSize, stats );
 
     // handle NAL unit
-    if( nalUnit.empty() )
+    if( nalUnitSize < 2 )
     {
       /* this can happen if the following occur:
        *  - empty input file
@@ -104,29 +117,71 @@ Void TAppExtrTop::extract()
        *  - start_code_prefix immediately followed by EOF
        */
       fprintf( stderr, "Warning: Attempt to decode an empty NAL unit\n" );
+      continue;
     }
-    else
+
+    // the NAL unit header is sufficient to select NAL units
+    const NalUnitType nalUnitType = NalUnitType( ( nalUnitBytes[ 0 ] >> 1 ) & 0x3f );
+    const UInt        nuhLayerId  = ( ( nalUnitBytes[ 0 ] & 1 ) << 5 ) | ( nalUnitBytes[ 1 ] >> 3 );
+    const Int         temporalId  = ( nalUnitBytes[ 1 ] & 7 ) - 1;
+
+    if( nalUnitType == NAL_UNIT_VPS || ( nalUnitType == NAL_UNIT_SPS && m_pchSpsInfoFile ) )
     {
-      read( nalu );
+      const Bool firstVps = !m_cTExtrTop.isVpsReceived();
+      InputNALUnit nalu;
+      read( nalu, nalUnitBytes, nalUnitSize );
+      m_cTExtrTop.decodeParameterSet( nalu, m_pchSpsInfoFile != NULL );
 
-      // decide whether to extract packet or not
-      if ( m_cTExtrTop.extract( nalu, m_suiExtractLayerIds ) && outputBitstreamFile.is_open() )
+      // layer sets are resolved with the first VPS
+      if( firstVps && m_cTExtrTop.isVpsReceived() )
       {
-        inputBitstreamFile.clear();
+        for( size_t i = 0; i < numOutputs; i++ )
+        {
+          if( m_extractLayerSetIdx[ i ] >= 0 )
+          {
+            if( m_extractLayerSetIdx[ i ] >= m_cTExtrTop.getNumLayerSets() )
+            {
+              fprintf( stderr, "\nlayer set %d of `%s' is not present in the VPS\n", m_extractLayerSetIdx[ i ], m_outputBitstreamFiles[ i ].c_str() );
+              exit( EXIT_FAILURE );
+            }
+            extractLayerIds[ i ].clear();
+            m_cTExtrTop.getLayerIdsInLayerSet( m_extractLayerSetIdx[ i ], extractLayerIds[ i ] );
+          }
+        }
+      }
+    }
 
-        streampos location2 = inputBitstreamFile.tellg();
-        inputBitstreamFile.seekg( location );
+    // copy the NAL unit including its start code and zero bytes as read from the input
+    const uint8_t* bytes    = inputBytestream.getBytes( location );
+    const size_t   numBytes = size_t( inputBytestream.getPosition() - location );
 
-        do
+    for( size_t i = 0; i < numOutputs; i++ )
+    {
+      if( extractLayerIds[ i ].find( nuhLayerId ) != extractLayerIds[ i ].end()
+        && ( m_extractMaxTemporalId[ i ] < 0 || temporalId <= m_extractMaxTemporalId[ i ] ) )
+      {
+        vector<uint8_t>& buffer = outputBuffers[ i ];
+        buffer.insert( buffer.end(), bytes, bytes + numBytes );
+        if( buffer.size() >= EXTR_WRITE_BLOCK_SIZE )
         {
-          outputBitstreamFile.put( inputBitstreamFile.get() );
-        } while( inputBitstreamFile.tellg() != location2 );
+          outputBitstreamFiles[ i ]->write( reinterpret_cast<const char*>( &buffer[ 0 ] ), buffer.size() );
+          buffer.clear();
+        }
       }
     }
   }
 
   inputBitstreamFile.close();
-  outputBitstreamFile.close();
+
+  for( size_t i = 0; i < numOutputs; i++ )
+  {
+    if( !outputBuffers[ i ].empty() )
+    {
+      outputBitstreamFiles[ i ]->write( reinterpret_cast<const char*>( &outputBuffers[ i ][ 0 ] ), outputBuffers[ i ].size() );
+    }
+    outputBitstreamFiles[ i ]->close();
+    delete outputBitstreamFiles[ i ];
+  }
 
 
   // write SPS info file
@@ -145,8 +200,14 @@ Void TAppExtrTop::extract()
     cSpsInfoFileHandle.close();
   }
 
-  m_cTExtrTop.dumpVpsInfo( std::cout ); 
-  m_cTExtrTop.dumpSpsInfo( std::cout );
+  if ( m_cTExtrTop.isVpsReceived() )
+  {
+    m_cTExtrTop.dumpVpsInfo( std::cout );
+  }
+  if ( m_pchSpsInfoFile )
+  {
+    m_cTExtrTop.dumpSpsInfo( std::cout );
+  }
 
 }
 #endif
@@ -68,7 +68,7 @@ int main(int argc, char* argv[])
   long lBefore = clock();
 
   // call extraction function
-//  cTAppExtrTop.extract();
+  cTAppExtrTop.extract();
 
   // ending time
   dResult = (double)(clock()-lBefore) / CLOCKS_PER_SEC;
@@ -0,0 +1,198 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     segmentStitcher.cpp
+    \brief    concatenation of separately encoded segments of a sequence into one bitstream
+
+    The segments are produced by independent encoder runs with SegmentSize and SegmentIdx, e.g. as
+    concurrent processes, and each of them starts with an IRAP access unit. Their concatenation hence
+    is a sequence of coded video sequences. Parameter sets repeated unchanged at the start of a segment
+    are removed, changed parameter sets are kept. HRD timing is continued by the concatenation_flag
+    written by the encoder in the first buffering period SEI of each segment but the first.
+*/
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
+
+#include "TLibDecoder/AnnexBread.h"
+
+using namespace std;
+
+static const size_t STITCH_WRITE_BLOCK_SIZE = 1 << 20;  ///< size of the blocks written to the output bitstream
+
+typedef vector<uint8_t>                          NalUnitBytes;
+typedef pair<Int, UInt>                          ParameterSetKey;   ///< nal_unit_type and nuh_layer_id of a parameter set
+typedef map<ParameterSetKey, vector<NalUnitBytes> > ParameterSetMap;
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    fprintf(stderr, "usage: %s <output bitstream> <segment 0 bitstream> [<segment 1 bitstream> ...]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  fstream outputBitstreamFile(argv[1], fstream::binary | fstream::out);
+  if (outputBitstreamFile.fail())
+  {
+    fprintf(stderr, "\nfailed to open bitstream file `%s' for writing\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  ParameterSetMap      parameterSets;   ///< parameter sets in effect at the end of the previous segment
+  vector<uint8_t>      outputBuffer;
+  UInt                 numNalUnits   = 0;
+  UInt                 numRemovedPs  = 0;
+  outputBuffer.reserve(STITCH_WRITE_BLOCK_SIZE);
+
+  const Int numSegments = argc - 2;
+  for (Int segment = 0; segment < numSegments; segment++)
+  {
+    const char* segmentFileName = argv[segment + 2];
+    ifstream inputBitstreamFile(segmentFileName, ifstream::in | ifstream::binary);
+    if (inputBitstreamFile.fail())
+    {
+      fprintf(stderr, "\nfailed to open bitstream file `%s' for reading\n", segmentFileName);
+      return EXIT_FAILURE;
+    }
+
+    InputByteStream inputBytestream(inputBitstreamFile);
+    ParameterSetMap      segmentParameterSets;  ///< parameter sets of the current segment
+    set<ParameterSetKey> changedKeys;           ///< parameter set types of the current segment with new content
+    Bool bFirstVclNalUnit = true;
+    Bool bPrevRemoved     = false;
+    Bool bEndOfFile       = false;
+
+    while (!bEndOfFile)
+    {
+      streamoff      location = inputBytestream.getPosition();
+      AnnexBStats    stats    = AnnexBStats();
+      const uint8_t* nalUnitBytes;
+      UInt           nalUnitSize;
+
+      bEndOfFile = byteStreamNALUnit(inputBytestream, nalUnitBytes, nalUnitSize, stats);
+
+      if (nalUnitSize < 2)
+      {
+        continue;
+      }
+
+      const NalUnitType nalUnitType = NalUnitType((nalUnitBytes[0] >> 1) & 0x3f);
+      const UInt        nuhLayerId  = ((nalUnitBytes[0] & 1) << 5) | (nalUnitBytes[1] >> 3);
+
+      // segments are spliced at IRAP access units only
+      if (nalUnitType < NAL_UNIT_VPS && bFirstVclNalUnit)
+      {
+        if (nalUnitType < NAL_UNIT_CODED_SLICE_BLA_W_LP || nalUnitType > NAL_UNIT_RESERVED_IRAP_VCL23)
+        {
+          fprintf(stderr, "\nsegment `%s' does not start with an IRAP access unit\n", segmentFileName);
+          return EXIT_FAILURE;
+        }
+        bFirstVclNalUnit = false;
+      }
+
+      Bool bRemove = false;
+      if (nalUnitType == NAL_UNIT_VPS || nalUnitType == NAL_UNIT_SPS || nalUnitType == NAL_UNIT_PPS)
+      {
+        // a parameter set is removed when it is identical to one in effect, as long as no new parameter set of
+        // the same type and layer, which might replace one in effect, has been received in this segment
+        const ParameterSetKey       key( nalUnitType, nuhLayerId );
+        const vector<NalUnitBytes>& inEffect = parameterSets[key];
+        const NalUnitBytes          bytes( nalUnitBytes, nalUnitBytes + nalUnitSize );
+        if (find(inEffect.begin(), inEffect.end(), bytes) == inEffect.end())
+        {
+          changedKeys.insert(key);
+        }
+        else if (changedKeys.find(key) == changedKeys.end())
+        {
+          bRemove = true;
+        }
+        segmentParameterSets[key].push_back(bytes);
+      }
+      // an end of bitstream NAL unit is only allowed at the end of the stitched bitstream
+      else if (nalUnitType == NAL_UNIT_EOB && segment < numSegments - 1)
+      {
+        bRemove = true;
+      }
+
+      if (bRemove)
+      {
+        numRemovedPs += (nalUnitType != NAL_UNIT_EOB) ? 1 : 0;
+        bPrevRemoved  = true;
+        continue;
+      }
+
+      // the first NAL unit of an access unit needs a zero_byte, which might have been removed with a parameter set
+      if (bPrevRemoved && stats.m_numZeroByteBytes == 0)
+      {
+        outputBuffer.push_back(0);
+      }
+      bPrevRemoved = false;
+
+      // copy the NAL unit including its start code and zero bytes as read from the input
+      const uint8_t* bytes    = inputBytestream.getBytes(location);
+      const size_t   numBytes = size_t(inputBytestream.getPosition() - location);
+      outputBuffer.insert(outputBuffer.end(), bytes, bytes + numBytes);
+      numNalUnits++;
+
+      if (outputBuffer.size() >= STITCH_WRITE_BLOCK_SIZE)
+      {
+        outputBitstreamFile.write(reinterpret_cast<const char*>(&outputBuffer[0]), outputBuffer.size());
+        outputBuffer.clear();
+      }
+    }
+    inputBitstreamFile.close();
+
+    // parameter sets of changed types are replaced by the ones of this segment
+    for (set<ParameterSetKey>::iterator it = changedKeys.begin(); it != changedKeys.end(); it++)
+    {
+      parameterSets[*it] = segmentParameterSets[*it];
+    }
+  }
+
+  if (!outputBuffer.empty())
+  {
+    outputBitstreamFile.write(reinterpret_cast<const char*>(&outputBuffer[0]), outputBuffer.size());
+  }
+  outputBitstreamFile.close();
+
+  printf("Stitched %d segments into `%s': %u NAL units, %u repeated parameter sets removed\n", numSegments, argv[1], numNalUnits, numRemovedPs);
+  return EXIT_SUCCESS;
+}
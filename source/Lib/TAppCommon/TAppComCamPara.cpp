@@ -65,6 +65,21 @@ TAppComCamPara::xCreateLUTs( UInt uiNumberSourceViews, UInt uiNumberTargetViews,
   radLUT         = new Double***[ uiNumberSourceViews ];
   raiLUT         = new Int   ***[ uiNumberSourceViews ];
 
+#if NH_3D_CAM_LUT_INCREMENTAL
+  // tables of all view pairs are held in one contiguous block per type
+  UInt     uiNumTables = uiNumberSourceViews * uiNumberTargetViews * 2;
+  Double** pdTables    = new Double*[ uiNumTables ];
+  Int**    piTables    = new Int*   [ uiNumTables ];
+  Double*  pdData      = new Double [ uiNumTables * 257 ];
+  Int*     piData      = new Int    [ uiNumTables * 257 ];
+
+  for( UInt uiTable = 0; uiTable < uiNumTables; uiTable++ )
+  {
+    pdTables[ uiTable ] = pdData + uiTable * 257;
+    piTables[ uiTable ] = piData + uiTable * 257;
+  }
+#endif
+
   for( UInt uiSourceView = 0; uiSourceView < uiNumberSourceViews; uiSourceView++ )
   {
     radShiftParams[ uiSourceView ] = new Double* [ uiNumberTargetViews ];
@@ -77,6 +92,11 @@ TAppComCamPara::xCreateLUTs( UInt uiNumberSourceViews, UInt uiNumberTargetViews,
       radShiftParams[ uiSourceView ][ uiTargetView ]      = new Double [ 2 ];
       raiShiftParams[ uiSourceView ][ uiTargetView ]      = new Int64  [ 2 ];
 
+#if NH_3D_CAM_LUT_INCREMENTAL
+      UInt uiTable = ( uiSourceView * uiNumberTargetViews + uiTargetView ) * 2;
+      radLUT        [ uiSourceView ][ uiTargetView ]      = pdTables + uiTable;
+      raiLUT        [ uiSourceView ][ uiTargetView ]      = piTables + uiTable;
+#else
       radLUT        [ uiSourceView ][ uiTargetView ]      = new Double*[ 2 ];
       radLUT        [ uiSourceView ][ uiTargetView ][ 0 ] = new Double [ 257 ];
       radLUT        [ uiSourceView ][ uiTargetView ][ 1 ] = new Double [ 257 ];
@@ -84,6 +104,7 @@ TAppComCamPara::xCreateLUTs( UInt uiNumberSourceViews, UInt uiNumberTargetViews,
       raiLUT        [ uiSourceView ][ uiTargetView ]      = new Int*   [ 2 ];
       raiLUT        [ uiSourceView ][ uiTargetView ][ 0 ] = new Int    [ 257 ];
       raiLUT        [ uiSourceView ][ uiTargetView ][ 1 ] = new Int    [ 257 ];
+#endif
     }
   }
 }
@@ -817,7 +838,11 @@ TAppComCamPara::xSetCodedScaleOffset( UInt uiFrame )
 
 
 Void
+#if NH_3D_CAM_LUT_INCREMENTAL
+TAppComCamPara::xSetShiftParametersAndLUT( UInt uiNumberSourceViews, UInt uiNumberTargetViews, UInt uiFrame, Bool bExternalReference , Double****& radLUT, Int****& raiLUT, Double***& radShiftParams, Int64***& raiShiftParams, Bool& rbLUTSet )
+#else
 TAppComCamPara::xSetShiftParametersAndLUT( UInt uiNumberSourceViews, UInt uiNumberTargetViews, UInt uiFrame, Bool bExternalReference , Double****& radLUT, Int****& raiLUT, Double***& radShiftParams, Int64***& raiShiftParams )
+#endif
 {
   if( uiNumberSourceViews <= 1 || uiNumberTargetViews == 0 )
   {
@@ -841,6 +866,9 @@ TAppComCamPara::xSetShiftParametersAndLUT( UInt uiNumberSourceViews, UInt uiNumb
       // integer-valued scale and offset
       Int64 iScale, iOffset;
       xGetShiftParameterInt ( uiSourceView, uiTargetView, uiFrame, bExternalReference, true, iScale, iOffset );
+#if NH_3D_CAM_LUT_INCREMENTAL
+      Bool bIntUnchanged = ( raiShiftParams[ uiSourceView][ uiTargetView ][ 0 ] == iScale && raiShiftParams[ uiSourceView][ uiTargetView ][ 1 ] == iOffset );
+#endif
       raiShiftParams[ uiSourceView][ uiTargetView ][ 0 ] = iScale;
       raiShiftParams[ uiSourceView][ uiTargetView ][ 1 ] = iOffset;
 
@@ -861,6 +889,13 @@ TAppComCamPara::xSetShiftParametersAndLUT( UInt uiNumberSourceViews, UInt uiNumb
         xGetShiftParameterReal( uiSourceView, uiTargetView, uiFrame, bExternalReference, true, dScale, dOffset );
       }
 
+#if NH_3D_CAM_LUT_INCREMENTAL
+      if( rbLUTSet && bIntUnchanged && radShiftParams[ uiSourceView][ uiTargetView ][ 0 ] == dScale && radShiftParams[ uiSourceView][ uiTargetView ][ 1 ] == dOffset )
+      {
+        // parameters of this view pair did not change, tables are still valid
+        continue;
+      }
+#endif
       radShiftParams[ uiSourceView][ uiTargetView ][ 0 ] = dScale;
       radShiftParams[ uiSourceView][ uiTargetView ][ 1 ] = dOffset;
 
@@ -917,6 +952,9 @@ TAppComCamPara::xSetShiftParametersAndLUT( UInt uiNumberSourceViews, UInt uiNumb
       std::cout << "   max rnd chroma disp diff is " << dMaxRndDispDvC << " (allowed: " << dMaxAllowedRndDispDvC << ")" << std::endl;
     }
   }
+#if NH_3D_CAM_LUT_INCREMENTAL
+  rbLUTSet = true;
+#endif
 }
 
 Void
@@ -924,8 +962,13 @@ TAppComCamPara::xSetShiftParametersAndLUT( UInt uiFrame )
 {
   xInit2dArray             ( (UInt)m_iNumberOfBaseViews, (UInt)m_iNumberOfBaseViews,  m_aaiScaleAndOffsetSet, 0 );
   xSetCodedScaleOffset     (                                                          uiFrame );
+#if NH_3D_CAM_LUT_INCREMENTAL
+  xSetShiftParametersAndLUT( (UInt)m_iNumberOfBaseViews, (UInt)m_iNumberOfBaseViews,  uiFrame, false, m_adBaseViewShiftLUT,  m_aiBaseViewShiftLUT,  m_adBaseViewShiftParameter,  m_aiBaseViewShiftParameter,  m_bBaseViewShiftLUTSet  );
+  xSetShiftParametersAndLUT( (UInt)m_iNumberOfBaseViews, (UInt)m_iNumberOfSynthViews, uiFrame, true,  m_adSynthViewShiftLUT, m_aiSynthViewShiftLUT, m_adSynthViewShiftParameter, m_aiSynthViewShiftParameter, m_bSynthViewShiftLUTSet );
+#else
   xSetShiftParametersAndLUT( (UInt)m_iNumberOfBaseViews, (UInt)m_iNumberOfBaseViews,  uiFrame, false, m_adBaseViewShiftLUT,  m_aiBaseViewShiftLUT,  m_adBaseViewShiftParameter,  m_aiBaseViewShiftParameter  );
   xSetShiftParametersAndLUT( (UInt)m_iNumberOfBaseViews, (UInt)m_iNumberOfSynthViews, uiFrame, true,  m_adSynthViewShiftLUT, m_aiSynthViewShiftLUT, m_adSynthViewShiftParameter, m_aiSynthViewShiftParameter );
+#endif
 };
 
 
@@ -978,6 +1021,10 @@ TAppComCamPara::TAppComCamPara()
   m_aiBaseViewShiftLUT        = 0;
   m_adSynthViewShiftLUT       = 0;
   m_aiSynthViewShiftLUT       = 0;
+#if NH_3D_CAM_LUT_INCREMENTAL
+  m_bBaseViewShiftLUTSet      = false;
+  m_bSynthViewShiftLUTSet     = false;
+#endif
 
   m_bSetupFromCoded           = false;
   m_bCamParsCodedPrecSet      = false;
@@ -993,13 +1040,23 @@ TAppComCamPara::~TAppComCamPara()
 {
   xDeleteArray( m_adBaseViewShiftParameter,  m_iNumberOfBaseViews, m_iNumberOfBaseViews     );
   xDeleteArray( m_aiBaseViewShiftParameter,  m_iNumberOfBaseViews, m_iNumberOfBaseViews     );
+#if NH_3D_CAM_LUT_INCREMENTAL
+  xDeleteLUT  ( m_adBaseViewShiftLUT,        std::max( 1, m_iNumberOfBaseViews ) );
+  xDeleteLUT  ( m_aiBaseViewShiftLUT,        std::max( 1, m_iNumberOfBaseViews ) );
+#else
   xDeleteArray( m_adBaseViewShiftLUT,        m_iNumberOfBaseViews, m_iNumberOfBaseViews,  2 );
   xDeleteArray( m_aiBaseViewShiftLUT,        m_iNumberOfBaseViews, m_iNumberOfBaseViews,  2 );
+#endif
 
   xDeleteArray( m_adSynthViewShiftParameter, m_iNumberOfBaseViews, std::max((Int) 1 ,m_iNumberOfSynthViews));
   xDeleteArray( m_aiSynthViewShiftParameter, m_iNumberOfBaseViews, std::max((Int) 1 ,m_iNumberOfSynthViews));
+#if NH_3D_CAM_LUT_INCREMENTAL
+  xDeleteLUT  ( m_adSynthViewShiftLUT,       std::max( 1, m_iNumberOfBaseViews ) );
+  xDeleteLUT  ( m_aiSynthViewShiftLUT,       std::max( 1, m_iNumberOfBaseViews ) );
+#else
   xDeleteArray( m_adSynthViewShiftLUT,       m_iNumberOfBaseViews, std::max((Int) 1 ,m_iNumberOfSynthViews), 2 );
   xDeleteArray( m_aiSynthViewShiftLUT,       m_iNumberOfBaseViews, std::max( (Int)1 ,m_iNumberOfSynthViews), 2 );
+#endif
 
   xDeleteArray( m_aaiCodedScale,             m_iNumberOfBaseViews );
   xDeleteArray( m_aaiCodedOffset,            m_iNumberOfBaseViews );
@@ -101,6 +101,10 @@ private:
   Int****             m_aiBaseViewShiftLUT;                    ///< Disparity LUT
   Double****          m_adSynthViewShiftLUT;                   ///< Disparity LUT
   Int****             m_aiSynthViewShiftLUT;                   ///< Disparity LUT
+#if NH_3D_CAM_LUT_INCREMENTAL
+  Bool                m_bBaseViewShiftLUTSet;                  ///< base view LUTs hold valid data for the stored shift parameters
+  Bool                m_bSynthViewShiftLUTSet;                 ///< synthesized view LUTs hold valid data for the stored shift parameters
+#endif
 
 protected:
   // create and delete arrays
@@ -110,6 +114,9 @@ protected:
   template<class T> Void  xDeleteArray  ( T*& rpt, UInt uiSize1, UInt uiSize2, UInt uiSize3 );
   template<class T> Void  xDeleteArray  ( T*& rpt, UInt uiSize1, UInt uiSize2 );
   template<class T> Void  xDeleteArray  ( T*& rpt, UInt uiSize );
+#if NH_3D_CAM_LUT_INCREMENTAL
+  template<class T> Void  xDeleteLUT    ( T****& rpt, UInt uiSize );
+#endif
 
   // functions for reading, initialization, sorting, getting data, etc.
   Void  xReadCameraParameterFile  ( TChar* pchCfgFileName );
@@ -138,7 +145,11 @@ protected:
   Void  xGetCodedCameraData       ( UInt uiSourceView, UInt uiTargetView, Bool bByIdx,  UInt uiFrame, Int& riScale, Int& riOffset, Int& riPrecision );
 
   Void  xSetCodedScaleOffset      ( UInt uiFrame );
+#if NH_3D_CAM_LUT_INCREMENTAL
+  Void  xSetShiftParametersAndLUT ( UInt uiNumViewDim1, UInt uiNumViewDim2, UInt uiFrame, Bool bExternalReference, Double****& radLUT, Int****& raiLUT, Double***& radShiftParams, Int64***& raiShiftParams, Bool& rbLUTSet );
+#else
   Void  xSetShiftParametersAndLUT ( UInt uiNumViewDim1, UInt uiNumViewDim2, UInt uiFrame, Bool bExternalReference, Double****& radLUT, Int****& raiLUT, Double***& radShiftParams, Int64***& raiShiftParams );
+#endif
   Void  xSetShiftParametersAndLUT ( UInt uiFrame );
 
   // getting conversion parameters for disparity to virtual depth conversion
@@ -280,6 +291,25 @@ Void TAppComCamPara::xDeleteArray( T*& rpt, UInt uiSize )
   rpt = NULL;
 };
 
+#if NH_3D_CAM_LUT_INCREMENTAL
+template <class T>
+Void TAppComCamPara::xDeleteLUT( T****& rpt, UInt uiSize )
+{
+  if( rpt )
+  {
+    // table data of all view pairs is one block starting at the first table
+    delete[] rpt[ 0 ][ 0 ][ 0 ];
+    delete[] rpt[ 0 ][ 0 ];
+    for( UInt uiK = 0; uiK < uiSize; uiK++ )
+    {
+      delete[] rpt[ uiK ];
+    }
+    delete[] rpt;
+  }
+  rpt = NULL;
+};
+#endif
+
 
 
 #endif // __TAPPCOMCAMPARA__
@@ -47,6 +47,7 @@
 // ====================================================================================================================
 
 #define MAX_NUM_CTX_MOD             512       ///< maximum number of supported contexts
+#define NUM_CTX_MOD_PER_CHUNK         8       ///< number of contexts tracked as one unit when context sets are copied (MAX_NUM_CTX_MOD/64 chunks)
 
 #define NUM_SPLIT_FLAG_CTX            3       ///< number of context models for split flag
 #define NUM_SKIP_FLAG_CTX             3       ///< number of context models for skip flag
@@ -0,0 +1,157 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComArena.cpp
+    \brief    bump allocator for short-lived scratch buffers
+*/
+
+#include "TComArena.h"
+#include <assert.h>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TComArena::TComArena()
+: m_uiCurBlock ( 0 )
+, m_uiCurOffset( 0 )
+, m_uiPeakSize ( 0 )
+{
+}
+
+TComArena::~TComArena()
+{
+  destroy();
+}
+
+Void TComArena::create( size_t uiInitialSize )
+{
+  destroy();
+  xAddBlock( uiInitialSize );
+  m_uiCurBlock  = 0;
+  m_uiCurOffset = 0;
+}
+
+Void TComArena::destroy()
+{
+  xFreeBlocks();
+  m_uiCurBlock  = 0;
+  m_uiCurOffset = 0;
+  m_uiPeakSize  = 0;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TComArena::reset()
+{
+  if( m_apucBlock.size() > 1 )
+  {
+    // overflow happened, replace all blocks by a single one covering the peak usage
+    size_t uiTotalSize = 0;
+    for( UInt uiBlock = 0; uiBlock < (UInt)m_auiBlockSize.size(); uiBlock++ )
+    {
+      uiTotalSize += m_auiBlockSize[ uiBlock ];
+    }
+    xFreeBlocks();
+    xAddBlock( uiTotalSize );
+  }
+  m_uiCurBlock  = 0;
+  m_uiCurOffset = 0;
+}
+
+Void* TComArena::allocBytes( size_t uiSize )
+{
+  uiSize = ( uiSize + ARENA_ALIGNMENT - 1 ) & ~( ARENA_ALIGNMENT - 1 );
+
+  if( m_apucBlock.empty() )
+  {
+    xAddBlock( uiSize );
+  }
+
+  while( m_uiCurOffset + uiSize > m_auiBlockSize[ m_uiCurBlock ] )
+  {
+    m_uiCurBlock++;
+    m_uiCurOffset = 0;
+    if( m_uiCurBlock == (UInt)m_apucBlock.size() )
+    {
+      xAddBlock( std::max( uiSize, m_auiBlockSize[ m_uiCurBlock - 1 ] ) );
+    }
+  }
+
+  Void* pvMem    = m_apucBlock[ m_uiCurBlock ] + m_uiCurOffset;
+  m_uiCurOffset += uiSize;
+
+  size_t uiUsed = m_uiCurOffset;
+  for( UInt uiBlock = 0; uiBlock < m_uiCurBlock; uiBlock++ )
+  {
+    uiUsed += m_auiBlockSize[ uiBlock ];
+  }
+  m_uiPeakSize = std::max( m_uiPeakSize, uiUsed );
+
+  return pvMem;
+}
+
+Void TComArena::releaseToMark( const Mark& rcMark )
+{
+  assert(  rcMark.m_uiBlock <  m_uiCurBlock || ( rcMark.m_uiBlock == m_uiCurBlock && rcMark.m_uiOffset <= m_uiCurOffset ) || m_apucBlock.empty() );
+  m_uiCurBlock  = rcMark.m_uiBlock;
+  m_uiCurOffset = rcMark.m_uiOffset;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Void TComArena::xAddBlock( size_t uiMinSize )
+{
+  size_t uiSize = ( uiMinSize + ARENA_ALIGNMENT - 1 ) & ~( ARENA_ALIGNMENT - 1 );
+  m_apucBlock   .push_back( (UChar*)xMalloc( UChar, uiSize ) );
+  m_auiBlockSize.push_back( uiSize );
+}
+
+Void TComArena::xFreeBlocks()
+{
+  for( UInt uiBlock = 0; uiBlock < (UInt)m_apucBlock.size(); uiBlock++ )
+  {
+    xFree( m_apucBlock[ uiBlock ] );
+  }
+  m_apucBlock   .clear();
+  m_auiBlockSize.clear();
+}
+
+//! \}
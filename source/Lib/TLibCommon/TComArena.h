@@ -0,0 +1,130 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComArena.h
+    \brief    bump allocator for short-lived scratch buffers (header)
+*/
+
+#ifndef __TCOMARENA__
+#define __TCOMARENA__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+#include <new>
+#include <vector>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// bump allocator for temporary buffers used within one CTU
+/** Memory is handed out linearly from a pre-allocated block and released in LIFO order
+    via marks (see TComArenaScope). If a request does not fit, an overflow block is
+    allocated; all blocks are merged into one larger block at the next reset(), so that
+    steady state coding does not touch the heap anymore.
+    Only trivially destructible types may be allocated, destructors are never called.
+*/
+class TComArena
+{
+public:
+  struct Mark
+  {
+    UInt   m_uiBlock;
+    size_t m_uiOffset;
+  };
+
+private:
+  std::vector<UChar*> m_apucBlock;
+  std::vector<size_t> m_auiBlockSize;
+  UInt                m_uiCurBlock;
+  size_t              m_uiCurOffset;
+  size_t              m_uiPeakSize;
+
+  static const size_t ARENA_ALIGNMENT = 32;
+
+  Void  xAddBlock     ( size_t uiMinSize );
+  Void  xFreeBlocks   ();
+
+public:
+  TComArena();
+  ~TComArena();
+
+  Void  create        ( size_t uiInitialSize );
+  Void  destroy       ();
+
+  /// release all allocations, merge overflow blocks into one block
+  Void  reset         ();
+
+  Void* allocBytes    ( size_t uiSize );
+
+  template <typename T>
+  T*    alloc         ( size_t uiNum )
+  {
+    T* p = static_cast<T*>( allocBytes( sizeof( T ) * uiNum ) );
+    for( size_t i = 0; i < uiNum; i++ )
+    {
+      new ( p + i ) T;
+    }
+    return p;
+  }
+
+  Mark  getMark       () const            { Mark cMark = { m_uiCurBlock, m_uiCurOffset }; return cMark; }
+  Void  releaseToMark ( const Mark& rcMark );
+
+  size_t getPeakSize  () const            { return m_uiPeakSize; }
+};
+
+/// releases all arena allocations made during its lifetime when going out of scope
+class TComArenaScope
+{
+private:
+  TComArena&       m_rcArena;
+  TComArena::Mark  m_cMark;
+
+  TComArenaScope( const TComArenaScope& );
+  TComArenaScope& operator= ( const TComArenaScope& );
+
+public:
+  TComArenaScope( TComArena& rcArena ) : m_rcArena( rcArena ), m_cMark( rcArena.getMark() ) {}
+  ~TComArenaScope()                      { m_rcArena.releaseToMark( m_cMark ); }
+};
+
+//! \}
+
+#endif // __TCOMARENA__
@@ -94,11 +94,13 @@ Void TComInputBitstream::resetToStart()
 
 UChar* TComOutputBitstream::getByteStream() const
 {
+  xFlushHeldBytes();
   return (UChar*) &m_fifo.front();
 }
 
 UInt TComOutputBitstream::getByteStreamLength()
 {
+  xFlushHeldBytes();
   return UInt(m_fifo.size());
 }
 
@@ -114,43 +116,42 @@ Void TComOutputBitstream::write   ( UInt uiBits, UInt uiNumberOfBits )
   assert( uiNumberOfBits <= 32 );
   assert( uiNumberOfBits == 32 || (uiBits & (~0 << uiNumberOfBits)) == 0 );
 
-  /* any modulo 8 remainder of num_total_bits cannot be written this time,
-   * and will be held until next time. */
-  UInt num_total_bits = uiNumberOfBits + m_num_held_bits;
-  UInt next_num_held_bits = num_total_bits % 8;
+  /* less than 32 bits are held between calls, the register can take
+   * another 32 bits without overflow */
+  m_held_bits      = ( m_held_bits << uiNumberOfBits ) | uiBits;
+  m_num_held_bits += uiNumberOfBits;
 
-  /* form a byte aligned word (write_bits), by concatenating any held bits
-   * with the new bits, discarding the bits that will form the next_held_bits.
-   * eg: H = held bits, V = n new bits        /---- next_held_bits
-   * len(H)=7, len(V)=1: ... ---- HHHH HHHV . 0000 0000, next_num_held_bits=0
-   * len(H)=7, len(V)=2: ... ---- HHHH HHHV . V000 0000, next_num_held_bits=1
-   * if total_bits < 8, the value of v_ is not used */
-  UChar next_held_bits = uiBits << (8 - next_num_held_bits);
-
-  if (!(num_total_bits >> 3))
+  if (m_num_held_bits < 32)
   {
-    /* insufficient bits accumulated to write out, append new_held_bits to
-     * current held_bits */
-    /* NB, this requires that v only contains 0 in bit positions {31..n} */
-    m_held_bits |= next_held_bits;
-    m_num_held_bits = next_num_held_bits;
     return;
   }
 
-  /* topword serves to justify held_bits to align with the msb of uiBits */
-  UInt topword = (uiNumberOfBits - next_num_held_bits) & ~((1 << 3) -1);
-  UInt write_bits = (m_held_bits << topword) | (uiBits >> next_num_held_bits);
+  /* move the 32 oldest held bits to the fifo */
+  m_num_held_bits -= 32;
+  UInt write_bits = UInt( m_held_bits >> m_num_held_bits );
+  m_held_bits    &= ( uint64_t( 1 ) << m_num_held_bits ) - 1;
 
-  switch (num_total_bits >> 3)
+  if (m_fifo.capacity() == 0)
   {
-  case 4: m_fifo.push_back(write_bits >> 24);
-  case 3: m_fifo.push_back(write_bits >> 16);
-  case 2: m_fifo.push_back(write_bits >> 8);
-  case 1: m_fifo.push_back(write_bits);
+    m_fifo.reserve(4096);
   }
+  size_t fifoSize = m_fifo.size();
+  m_fifo.resize(fifoSize + 4);
+  uint8_t* dst = &m_fifo[fifoSize];
+  dst[0] = uint8_t( write_bits >> 24 );
+  dst[1] = uint8_t( write_bits >> 16 );
+  dst[2] = uint8_t( write_bits >>  8 );
+  dst[3] = uint8_t( write_bits       );
+}
 
-  m_held_bits = next_held_bits;
-  m_num_held_bits = next_num_held_bits;
+Void TComOutputBitstream::xFlushHeldBytes() const
+{
+  while (m_num_held_bits >= 8)
+  {
+    m_num_held_bits -= 8;
+    m_fifo.push_back( uint8_t( m_held_bits >> m_num_held_bits ) );
+  }
+  m_held_bits &= ( uint64_t( 1 ) << m_num_held_bits ) - 1;
 }
 
 Void TComOutputBitstream::writeAlignOne()
@@ -162,13 +163,7 @@ Void TComOutputBitstream::writeAlignOne()
 
 Void TComOutputBitstream::writeAlignZero()
 {
-  if (0 == m_num_held_bits)
-  {
-    return;
-  }
-  m_fifo.push_back(m_held_bits);
-  m_held_bits = 0;
-  m_num_held_bits = 0;
+  write(0, getNumBitsUntilByteAligned());
 }
 
 /**
@@ -178,16 +173,30 @@ Void TComOutputBitstream::writeAlignZero()
  */
 Void   TComOutputBitstream::addSubstream( TComOutputBitstream* pcSubstream )
 {
-  UInt uiNumBits = pcSubstream->getNumberOfWrittenBits();
+  pcSubstream->xFlushHeldBytes();
+  const vector<uint8_t>& rbsp = pcSubstream->m_fifo;
 
-  const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  if (getNumBitsUntilByteAligned() == 0)
   {
-    write(*it++, 8);
+    // byte aligned, append the bytes of the substream as one block
+    xFlushHeldBytes();
+    m_fifo.insert(m_fifo.end(), rbsp.begin(), rbsp.end());
   }
-  if (uiNumBits&0x7)
+  else
   {
-    write(pcSubstream->getHeldBits()>>(8-(uiNumBits&0x7)), uiNumBits&0x7);
+    size_t pos = 0;
+    for (; pos + 4 <= rbsp.size(); pos += 4)
+    {
+      write( ( UInt( rbsp[pos] ) << 24 ) | ( UInt( rbsp[pos + 1] ) << 16 ) | ( UInt( rbsp[pos + 2] ) << 8 ) | rbsp[pos + 3], 32 );
+    }
+    for (; pos < rbsp.size(); pos++)
+    {
+      write(rbsp[pos], 8);
+    }
+  }
+  if (pcSubstream->m_num_held_bits)
+  {
+    write(UInt(pcSubstream->m_held_bits), pcSubstream->m_num_held_bits);
   }
 }
 
@@ -240,7 +249,7 @@ Int TComOutputBitstream::countStartCodeEmulations()
 Void TComInputBitstream::pseudoRead ( UInt uiNumberOfBits, UInt& ruiBits )
 {
   UInt saved_num_held_bits = m_num_held_bits;
-  UChar saved_held_bits = m_held_bits;
+  uint64_t saved_held_bits = m_held_bits;
   UInt saved_fifo_idx = m_fifo_idx;
 
   UInt num_bits_to_read = min(uiNumberOfBits, getNumBitsLeft());
@@ -270,59 +279,93 @@ Void TComInputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
 #endif
 
   /* NB, bits are extracted from the MSB of each byte. */
-  UInt retval = 0;
-  if (uiNumberOfBits <= m_num_held_bits)
+  if (uiNumberOfBits > m_num_held_bits)
+  {
+    xRefill();
+    assert(uiNumberOfBits <= m_num_held_bits);
+  }
+
+  m_num_held_bits -= uiNumberOfBits;
+  ruiBits = UInt((m_held_bits >> m_num_held_bits) & ((uint64_t(1) << uiNumberOfBits) - 1));
+}
+
+/**
+ * Top up the bit cache with as many whole bytes from the fifo as fit
+ * into the 64-bit cache word.
+ */
+Void TComInputBitstream::xRefill()
+{
+  const UInt numBytes = std::min<UInt>((64 - m_num_held_bits) >> 3, (UInt)m_fifo.size() - m_fifo_idx);
+  if (numBytes == 0)
   {
-    /* n=1, len(H)=7:   -VHH HHHH, shift_down=6, mask=0xfe
-     * n=3, len(H)=7:   -VVV HHHH, shift_down=4, mask=0xf8
-     */
-    retval = m_held_bits >> (m_num_held_bits - uiNumberOfBits);
-    retval &= ~(0xff << uiNumberOfBits);
-    m_num_held_bits -= uiNumberOfBits;
-    ruiBits = retval;
     return;
   }
 
-  /* all num_held_bits will go into retval
-   *   => need to mask leftover bits from previous extractions
-   *   => align retval with top of extracted word */
-  /* n=5, len(H)=3: ---- -VVV, mask=0x07, shift_up=5-3=2,
-   * n=9, len(H)=3: ---- -VVV, mask=0x07, shift_up=9-3=6 */
-  uiNumberOfBits -= m_num_held_bits;
-  retval = m_held_bits & ~(0xff << m_num_held_bits);
-  retval <<= uiNumberOfBits;
-
-  /* number of whole bytes that need to be loaded to form retval */
-  /* n=32, len(H)=0, load 4bytes, shift_down=0
-   * n=32, len(H)=1, load 4bytes, shift_down=1
-   * n=31, len(H)=1, load 4bytes, shift_down=1+1
-   * n=8,  len(H)=0, load 1byte,  shift_down=0
-   * n=8,  len(H)=3, load 1byte,  shift_down=3
-   * n=5,  len(H)=1, load 1byte,  shift_down=1+3
-   */
-  UInt aligned_word = 0;
-  UInt num_bytes_to_load = (uiNumberOfBits - 1) >> 3;
-  assert(m_fifo_idx + num_bytes_to_load < m_fifo.size());
-
-  switch (num_bytes_to_load)
+  const uint8_t* src = &m_fifo[m_fifo_idx];
+  if (numBytes == 8)
   {
-  case 3: aligned_word  = m_fifo[m_fifo_idx++] << 24;
-  case 2: aligned_word |= m_fifo[m_fifo_idx++] << 16;
-  case 1: aligned_word |= m_fifo[m_fifo_idx++] <<  8;
-  case 0: aligned_word |= m_fifo[m_fifo_idx++];
+    /* cache is empty: load a complete big-endian word */
+    m_held_bits = (uint64_t(src[0]) << 56) | (uint64_t(src[1]) << 48) | (uint64_t(src[2]) << 40) | (uint64_t(src[3]) << 32)
+                | (uint64_t(src[4]) << 24) | (uint64_t(src[5]) << 16) | (uint64_t(src[6]) <<  8) |  uint64_t(src[7]);
   }
+  else
+  {
+    for (UInt i = 0; i < numBytes; i++)
+    {
+      m_held_bits = (m_held_bits << 8) | src[i];
+    }
+  }
+  m_fifo_idx      += numBytes;
+  m_num_held_bits += numBytes << 3;
+}
 
-  /* resolve remainder bits */
-  UInt next_num_held_bits = (32 - uiNumberOfBits) % 8;
+/**
+ * Read an unsigned Exp-Golomb code (ue(v)).
+ * Codes that are available in the bit cache are decoded with a single
+ * leading-zero scan, longer or truncated codes fall back to bitwise reading.
+ *
+ * \param ruiCodeNum decoded code number
+ * \param ruiNumBits number of bits consumed
+ */
+Void TComInputBitstream::readExpGolomb( UInt& ruiCodeNum, UInt& ruiNumBits )
+{
+  if (m_num_held_bits < 32)
+  {
+    xRefill();
+  }
 
-  /* copy required part of aligned_word into retval */
-  retval |= aligned_word >> next_num_held_bits;
+  UInt uiLength = 0;
+  if (m_num_held_bits > 0)
+  {
+    const uint64_t window = m_held_bits << (64 - m_num_held_bits);
+    while (uiLength < 32 && !(window & (uint64_t(1) << (63 - uiLength))))
+    {
+      uiLength++;
+    }
+  }
 
-  /* store held bits */
-  m_num_held_bits = next_num_held_bits;
-  m_held_bits = aligned_word;
+  if (2 * uiLength + 1 <= m_num_held_bits && uiLength < 32)
+  {
+    UInt uiVal = 0;
+    read( uiLength + 1, uiVal );
+    read( uiLength, uiVal );
+    ruiCodeNum = uiVal + (1 << uiLength) - 1;
+    ruiNumBits = 2 * uiLength + 1;
+    return;
+  }
 
-  ruiBits = retval;
+  UInt uiCode = 0;
+  read( 1, uiCode );
+  uiLength = 0;
+  while ( !uiCode )
+  {
+    read( 1, uiCode );
+    uiLength++;
+  }
+  UInt uiVal = 0;
+  read( uiLength, uiVal );
+  ruiCodeNum = uiVal + (1 << uiLength) - 1;
+  ruiNumBits = 2 * uiLength + 1;
 }
 
 /**
@@ -331,8 +374,11 @@ Void TComInputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
  */
 Void TComOutputBitstream::insertAt(const TComOutputBitstream& src, UInt pos)
 {
+  src.xFlushHeldBytes();
+  xFlushHeldBytes();
   UInt src_bits = src.getNumberOfWrittenBits();
   assert(0 == src_bits % 8);
+  assert(pos <= m_fifo.size());
 
   vector<uint8_t>::iterator at = m_fifo.begin() + pos;
   m_fifo.insert(at, src.m_fifo.begin(), src.m_fifo.end());
@@ -340,14 +386,10 @@ Void TComOutputBitstream::insertAt(const TComOutputBitstream& src, UInt pos)
 
 UInt TComInputBitstream::readOutTrailingBits ()
 {
-  UInt count=0;
+  const UInt count = getNumBitsUntilByteAligned();
   UInt uiBits = 0;
 
-  while ( ( getNumBitsLeft() > 0 ) && (getNumBitsUntilByteAligned()!=0) )
-  {
-    count++;
-    read ( 1, uiBits );
-  }
+  read ( count, uiBits );
   return count;
 }
 //
@@ -375,6 +417,15 @@ TComInputBitstream *TComInputBitstream::extractSubstream( UInt uiNumBits )
   std::vector<uint8_t> &buf = pResult->getFifo();
   buf.reserve((uiNumBits+7)>>3);
 
+  /* whole bytes held in the cache are handed over first, the remainder is copied straight from the fifo */
+  while (m_num_held_bits != 0 && (m_num_held_bits & 7) == 0 && uiNumBytes > 0)
+  {
+    UInt uiByte;
+    readByte(uiByte);
+    buf.push_back(uiByte);
+    uiNumBytes--;
+  }
+
   if (m_num_held_bits == 0)
   {
     std::size_t currentOutputBufferSize=buf.size();
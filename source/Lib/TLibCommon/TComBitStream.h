@@ -79,12 +79,20 @@ class TComOutputBitstream : public TComBitIf
    *  - fifo.clear() to empty the FIFO
    *  - &fifo.front() to get a pointer to the data array.
    *    NB, this pointer is only valid until the next push_back()/clear()
+   *
+   * Written bits are collected in a 64-bit register and moved to the
+   * FIFO 32 bits at a time.  Complete bytes still held in the register
+   * are flushed before the FIFO is accessed.
    */
-  std::vector<uint8_t> m_fifo;
+  mutable std::vector<uint8_t> m_fifo;
+
+  mutable UInt     m_num_held_bits; /// number of bits not flushed to bytestream.
+  mutable uint64_t m_held_bits;     /// the bits held and not flushed to bytestream.
+                                    /// this value is always lsb-aligned, bits above m_num_held_bits are zero.
+
+  /** move all complete bytes held in the register to the FIFO */
+  Void xFlushHeldBytes() const;
 
-  UInt m_num_held_bits; /// number of bits not flushed to bytestream.
-  UChar m_held_bits; /// the bits held and not flushed to bytestream.
-                             /// this value is always msb-aligned, bigendian.
 public:
   // create / destroy
   TComOutputBitstream();
@@ -142,13 +150,14 @@ public:
   /**
    * Return a reference to the internal fifo
    */
-  std::vector<uint8_t>& getFIFO() { return m_fifo; }
+  std::vector<uint8_t>& getFIFO() { xFlushHeldBytes(); return m_fifo; }
 
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  /** Return the bits not flushed to the fifo, msb-aligned */
+  UChar getHeldBits  ()          { xFlushHeldBytes(); return UChar( m_held_bits << ( 8 - m_num_held_bits ) ); }
 
   //TComOutputBitstream& operator= (const TComOutputBitstream& src);
   /** Return a reference to the internal fifo */
-  const std::vector<uint8_t>& getFIFO() const { return m_fifo; }
+  const std::vector<uint8_t>& getFIFO() const { xFlushHeldBytes(); return m_fifo; }
 
   Void          addSubstream    ( TComOutputBitstream* pcSubstream );
   Void writeByteAlignment();
@@ -169,9 +178,11 @@ protected:
 
   UInt m_fifo_idx; /// Read index into m_fifo
 
-  UInt m_num_held_bits;
-  UChar m_held_bits;
-  UInt  m_numBitsRead;
+  UInt     m_num_held_bits; /// Number of unread bits in m_held_bits (up to 64)
+  uint64_t m_held_bits;     /// Cache of bits fetched from m_fifo, lsb-aligned
+  UInt     m_numBitsRead;
+
+  Void        xRefill         ();
 
 public:
   /**
@@ -186,22 +197,41 @@ public:
   // interface for decoding
   Void        pseudoRead      ( UInt uiNumberOfBits, UInt& ruiBits );
   Void        read            ( UInt uiNumberOfBits, UInt& ruiBits );
+  Void        readExpGolomb   ( UInt& ruiCodeNum, UInt& ruiNumBits );
   Void        readByte        ( UInt &ruiBits )
   {
-    assert(m_fifo_idx < m_fifo.size());
-    ruiBits = m_fifo[m_fifo_idx++];
+    if (m_num_held_bits == 0)
+    {
+      assert(m_fifo_idx < m_fifo.size());
+      ruiBits = m_fifo[m_fifo_idx++];
+    }
+    else
+    {
+      // the cache only holds whole bytes when the read position is byte-aligned
+      assert((m_num_held_bits & 7) == 0);
+      m_num_held_bits -= 8;
+      ruiBits = UInt(m_held_bits >> m_num_held_bits) & 0xff;
+    }
+  }
+
+  Void        rewindBytes     ( UInt uiNumBytes )
+  {
+    // only byte-aligned positions can be restored, the bit cache is discarded
+    assert((m_num_held_bits & 7) == 0 && uiNumBytes <= getByteLocation());
+    m_fifo_idx      = getByteLocation() - uiNumBytes;
+    m_num_held_bits = 0;
   }
 
   Void        peekPreviousByte( UInt &byte )
   {
-    assert(m_fifo_idx > 0);
-    byte = m_fifo[m_fifo_idx - 1];
+    assert(getByteLocation() > 0);
+    byte = m_fifo[getByteLocation() - 1];
   }
 
   UInt        readOutTrailingBits ();
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  UChar getHeldBits  ()          { return UChar(m_held_bits);   }
   TComOutputBitstream& operator= (const TComOutputBitstream& src);
-  UInt  getByteLocation              ( )                     { return m_fifo_idx                    ; }
+  UInt  getByteLocation              ( )                     { return m_fifo_idx - (m_num_held_bits >> 3); }
 
   // Peek at bits in word-storage. Used in determining if we have completed reading of current bitstream and therefore slice in LCEC.
   UInt        peekBits (UInt uiBits) { UInt tmp; pseudoRead(uiBits, tmp); return tmp; }
@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <string>
 #include <map>
+#include <vector>
 #include <math.h>
 #include "TComChromaFormat.h"
 
@@ -115,6 +116,9 @@ enum TComCodingStatisticsType
   STATS__CABAC_BITS__SDC_INTRA_FLAG,
   STATS__CABAC_BITS__SDC_DELTADC_FLAG,
 #endif
+#if NH_3D_DIS
+  STATS__CABAC_BITS__DIS,
+#endif
 
   STATS__NUM_STATS
 };
@@ -157,6 +161,9 @@ static inline const TChar* getName(TComCodingStatisticsType name)
     "CABAC_BITS__ESCAPE_BITS",
 #if NH_3D_DBBP
     "CABAC_BITS__DBBP_FLAG",
+#endif
+#if NH_3D_ARP
+    "CABAC_BITS__ARP_FLAG",
 #endif
     "CABAC_BITS__SAO",
     "CABAC_TRM_BITS",
@@ -171,7 +178,7 @@ static inline const TChar* getName(TComCodingStatisticsType name)
     "CABAC_BITS__ALIGNED_ESCAPE_BITS"
 
 #if NH_3D_IC
-    "CABAC_BITS__3D_IC"
+   ,"CABAC_BITS__3D_IC"
 #endif
 #if NH_3D_DMM || NH_3D_SDC_INTRA || NH_3D_SDC_INTER
    ,"STATS__CABAC_BITS__DELTADC_SIGN_EP"
@@ -186,16 +193,86 @@ static inline const TChar* getName(TComCodingStatisticsType name)
 #if NH_3D_SDC_INTRA
     ,"STATS__CABAC_BITS__SDC_INTRA_FLAG"
     ,"STATS__CABAC_BITS__SDC_DELTADC_FLAG"
+#endif
+#if NH_3D_DIS
+    ,"STATS__CABAC_BITS__DIS"
 #endif
   };
   assert(STATS__NUM_STATS == sizeof(statNames)/sizeof(TChar *) && name < STATS__NUM_STATS);
   return statNames[name];
 }
 
+#if NH_3D
+enum TComCodingStatisticsTool
+{
+  STATS_TOOL__NONE = -1,
+  STATS_TOOL__DMM,
+  STATS_TOOL__SDC,
+  STATS_TOOL__DELTA_DC, // delta DC values, shared by DMM and SDC
+  STATS_TOOL__DBBP,
+  STATS_TOOL__IC,
+  STATS_TOOL__ARP,
+  STATS_TOOL__DIS,
+  STATS_TOOL__VSP,      // no syntax element of its own, only the number of PUs using a VSP merge candidate is counted
+  STATS_TOOL__NUM_TOOLS
+};
+
+static inline const TChar* getToolName(TComCodingStatisticsTool tool)
+{
+  static const TChar *toolNames[STATS_TOOL__NUM_TOOLS]= { "DMM", "SDC", "DELTA_DC", "DBBP", "IC", "ARP", "DIS", "VSP" };
+  assert(tool >= 0 && tool < STATS_TOOL__NUM_TOOLS);
+  return toolNames[tool];
+}
+
+static inline TComCodingStatisticsTool getTool(TComCodingStatisticsType statT)
+{
+  switch (statT)
+  {
+#if NH_3D_DMM
+  case STATS__CABAC_BITS__NOTDMM_FLAG:
+  case STATS__CABAC_BITS__DMMMODE:
+  case STATS__CABAC_BITS__DMM1_BITS_EP:
+    return STATS_TOOL__DMM;
+#endif
+#if NH_3D_SDC_INTRA
+  case STATS__CABAC_BITS__SDC_INTRA_FLAG:
+  case STATS__CABAC_BITS__SDC_DELTADC_FLAG:
+    return STATS_TOOL__SDC;
+#endif
+#if NH_3D_DMM || NH_3D_SDC_INTRA || NH_3D_SDC_INTER
+  case STATS__CABAC_BITS__DELTADC_SIGN_EP:
+  case STATS__CABAC_BITS__DELTADC_PREFIX:
+  case STATS__CABAC_BITS__DELTADC_SUFFIX_EP:
+    return STATS_TOOL__DELTA_DC;
+#endif
+#if NH_3D_DBBP
+  case STATS__CABAC_BITS__DBBP_FLAG:
+    return STATS_TOOL__DBBP;
+#endif
+#if NH_3D_IC
+  case STATS__CABAC_BITS__3D_IC:
+    return STATS_TOOL__IC;
+#endif
+#if NH_3D_ARP
+  case STATS__CABAC_BITS__ARP_FLAG:
+    return STATS_TOOL__ARP;
+#endif
+#if NH_3D_DIS
+  case STATS__CABAC_BITS__DIS:
+    return STATS_TOOL__DIS;
+#endif
+  default:
+    return STATS_TOOL__NONE;
+  }
+}
+#endif
+
 static inline Bool isAlignedBins(TComCodingStatisticsType statT) { return statT==STATS__CABAC_BITS__ALIGNED_SIGN_BIT || statT==STATS__CABAC_BITS__ALIGNED_ESCAPE_BITS; }
 
 static const UInt CODING_STATS_NUM_WIDTHS=7;
 static const UInt CODING_STATS_NUM_SUBCLASSES=CODING_STATS_NUM_WIDTHS*(1+MAX_NUM_COMPONENT+MAX_NUM_CHANNEL_TYPE);
+static const UInt CODING_STATS_MAX_CAVLC_SYMBOLS=1024;                           ///< CAVLC syntax element names counted in flat arrays, further names use a map
+static const UInt CODING_STATS_CAVLC_HASH_SIZE=2*CODING_STATS_MAX_CAVLC_SYMBOLS;  ///< open addressing table from name address to array index, a power of 2
 
 class TComCodingStatisticsClassType
 {
@@ -272,21 +349,155 @@ class TComCodingStatistics
       { bits+=src.bits; count+=src.count; sum+=src.sum; return *this; }
     };
 
-    class TComCodingStatisticsData
+    // flat counters of one layer, all statistics of a NAL unit are accumulated in the counters of its nuh_layer_id
+    class TComCodingStatisticsLayerData
     {
+      public:
+        TComCodingStatisticsLayerData() : numVspMergedPUs(0) { }
       private:
         SStat statistics[STATS__NUM_STATS+1][CODING_STATS_NUM_SUBCLASSES];
         SStat statistics_ep[STATS__NUM_STATS+1][CODING_STATS_NUM_SUBCLASSES ];
-        std::map<std::string, SStat> mappings_ep;
+        SStat cavlc_ep[CODING_STATS_MAX_CAVLC_SYMBOLS]; // indexed by the symbol index of TComCodingStatisticsData
+        std::map<std::string, SStat> mappings_ep;        // names beyond CODING_STATS_MAX_CAVLC_SYMBOLS
+        Int64 numVspMergedPUs;
+
+        TComCodingStatisticsLayerData &operator+=(const TComCodingStatisticsLayerData &src)
+        {
+          for(UInt i=0; i<STATS__NUM_STATS+1; i++)
+          {
+            for(UInt c=0; c<CODING_STATS_NUM_SUBCLASSES; c++)
+            {
+              statistics[i][c]+=src.statistics[i][c];
+              statistics_ep[i][c]+=src.statistics_ep[i][c];
+            }
+          }
+          for(UInt i=0; i<CODING_STATS_MAX_CAVLC_SYMBOLS; i++)
+          {
+            cavlc_ep[i]+=src.cavlc_ep[i];
+          }
+          for(std::map<std::string, SStat>::const_iterator it=src.mappings_ep.begin(); it!=src.mappings_ep.end(); it++)
+          {
+            mappings_ep[it->first]+=it->second;
+          }
+          numVspMergedPUs+=src.numVspMergedPUs;
+          return *this;
+        }
+        Bool isEmpty() const
+        {
+          return statistics_ep[STATS__NAL_UNIT_TOTAL_BODY][0].count==0;
+        }
         friend class TComCodingStatistics;
     };
 
+    class TComCodingStatisticsData
+    {
+      public:
+        TComCodingStatisticsData() : numCavlcSymbols(0)
+        {
+          for(UInt i=0; i<CODING_STATS_CAVLC_HASH_SIZE; i++)
+          {
+            cavlcHashKeys[i]=NULL;
+          }
+        }
+      private:
+        std::vector<TComCodingStatisticsLayerData> layers; // indexed by nuh_layer_id, only extended up to the highest layer seen
+
+        // The CAVLC syntax element names are string literals, so a name is identified by its address.
+        // Different addresses with the same text get separate indices and are merged in the report.
+        const TChar *cavlcSymbolNames[CODING_STATS_MAX_CAVLC_SYMBOLS];
+        UInt         numCavlcSymbols;
+        const TChar *cavlcHashKeys[CODING_STATS_CAVLC_HASH_SIZE];
+        UInt         cavlcHashIdx[CODING_STATS_CAVLC_HASH_SIZE];
+
+        // returns the symbol index of a name, or CODING_STATS_MAX_CAVLC_SYMBOLS if the arrays are full
+        UInt getCavlcSymbolIdx(const TChar *pKey)
+        {
+          UInt h=UInt((size_t(pKey)>>2)*2654435761U)&(CODING_STATS_CAVLC_HASH_SIZE-1);
+          while (cavlcHashKeys[h]!=NULL)
+          {
+            if (cavlcHashKeys[h]==pKey)
+            {
+              return cavlcHashIdx[h];
+            }
+            h=(h+1)&(CODING_STATS_CAVLC_HASH_SIZE-1);
+          }
+          if (numCavlcSymbols==CODING_STATS_MAX_CAVLC_SYMBOLS)
+          {
+            return CODING_STATS_MAX_CAVLC_SYMBOLS;
+          }
+          cavlcSymbolNames[numCavlcSymbols]=pKey;
+          cavlcHashKeys[h]=pKey;
+          cavlcHashIdx[h]=numCavlcSymbols;
+          return numCavlcSymbols++;
+        }
+        friend class TComCodingStatistics;
+    };
+
+    StatLogValue values;
+
   private:
 
-    TComCodingStatisticsData data;
+    // State read by every bin update, refreshed whenever the current layer changes, i.e. at most once per NAL unit.
+    // It is constant initialised, so unlike the singleton it costs no initialisation guard per access.
+    struct SCurrentCounters
+    {
+      TComCodingStatisticsData      *pData;
+      TComCodingStatisticsLayerData *pLayerData;
+      const UInt                    *pLogValues;
+    };
+
+    static SCurrentCounters &CurrentCountersStorage()
+    {
+      static SCurrentCounters curr={NULL, NULL, NULL};
+      return curr;
+    }
 
-    TComCodingStatistics() : data()
-    { }
+    static SCurrentCounters &GetCurrentCounters()
+    {
+      SCurrentCounters &curr=CurrentCountersStorage();
+      if (curr.pLayerData==NULL)
+      {
+        GetSingletonInstance(); // the constructor selects layer 0
+      }
+      return curr;
+    }
+
+    TComCodingStatisticsData       data;
+    UInt                           currLayerId;
+
+    TComCodingStatistics() : data(), currLayerId(0)
+    {
+      setCurrentLayer(0);
+    }
+
+    Void setCurrentLayer(const UInt layerId)
+    {
+      if (layerId>=data.layers.size())
+      {
+        data.layers.resize(layerId+1);
+      }
+      currLayerId=layerId;
+      SCurrentCounters &curr=CurrentCountersStorage();
+      curr.pData=&data;
+      curr.pLayerData=&data.layers[layerId];
+      curr.pLogValues=values.values;
+    }
+
+    // CAVLC header statistics by name, merged over the symbol indices and the overflow map
+    Void getCavlcStatistics(const TComCodingStatisticsLayerData &d, std::map<std::string, SStat> &mappings) const
+    {
+      for(UInt i=0; i<data.numCavlcSymbols; i++)
+      {
+        if (d.cavlc_ep[i].count!=0)
+        {
+          mappings[data.cavlcSymbolNames[i]]+=d.cavlc_ep[i];
+        }
+      }
+      for(std::map<std::string, SStat>::const_iterator it=d.mappings_ep.begin(); it!=d.mappings_ep.end(); it++)
+      {
+        mappings[it->first]+=it->second;
+      }
+    }
 
     static Void OutputLine(const TChar *pName, const TChar sep, UInt width, const TChar *pSubClassStr, const SStat &sCABAC, const SStat &sEP)
     {
@@ -328,10 +539,95 @@ class TComCodingStatistics
       printf("\n");
     }
 
+    static SStat GetSubTotal(const SStat (&stats)[STATS__NUM_STATS+1][CODING_STATS_NUM_SUBCLASSES], const Int firstStat, const Int lastStat)
+    {
+      SStat s;
+      for(Int i=firstStat; i<=lastStat; i++)
+      {
+        for(UInt c=0; c<CODING_STATS_NUM_SUBCLASSES; c++)
+        {
+          s+=stats[i][c];
+        }
+      }
+      return s;
+    }
+
+    Void OutputLayerBreakdown() const
+    {
+      OutputDashedLine("Break down by layer");
+      for(UInt layerId=0; layerId<data.layers.size(); layerId++)
+      {
+        const TComCodingStatisticsLayerData &d=data.layers[layerId];
+        if (d.isEmpty())
+        {
+          continue;
+        }
+        TChar layerStr[16];
+        snprintf(layerStr, sizeof(layerStr), "L%u", layerId);
+
+        SStat sCABAC=GetSubTotal(d.statistics, STATS__NAL_UNIT_PACKING, STATS__NUM_STATS-1);
+        sCABAC.bits=(sCABAC.bits+TCOMCODINGSTATISTICS_ENTROPYSCALE/2)/TCOMCODINGSTATISTICS_ENTROPYSCALE;
+        SStat sEP=GetSubTotal(d.statistics_ep, STATS__NAL_UNIT_PACKING, STATS__NUM_STATS-1);
+        SStat sCAVLC;
+        std::map<std::string, SStat> mappings;
+        getCavlcStatistics(d, mappings);
+        for(std::map<std::string, SStat>::const_iterator it=mappings.begin(); it!=mappings.end(); it++)
+        {
+          sCAVLC+=it->second;
+        }
+        OutputLine("CABAC by layer Sub-total", '=', "-", layerStr, sCABAC, sEP);
+        OutputLine("CAVLC Header by layer Sub-total", '=', "-", layerStr, sCAVLC);
+        sEP+=sCAVLC;
+        OutputLine("TOTAL by layer", '~', "-", layerStr, sCABAC, sEP);
+      }
+    }
+
+#if NH_3D
+    Void OutputToolBreakdown() const
+    {
+      OutputDashedLine("Break down by 3D coding tool and layer");
+      for(Int tool=0; tool<STATS_TOOL__NUM_TOOLS; tool++)
+      {
+        for(UInt layerId=0; layerId<data.layers.size(); layerId++)
+        {
+          const TComCodingStatisticsLayerData &d=data.layers[layerId];
+          SStat sCABAC, sEP;
+          for(Int i=0; i<STATS__NUM_STATS; i++)
+          {
+            if (getTool(TComCodingStatisticsType(i))==tool)
+            {
+              sCABAC+=GetSubTotal(d.statistics, i, i);
+              sEP+=GetSubTotal(d.statistics_ep, i, i);
+            }
+          }
+          sCABAC.bits=(sCABAC.bits+TCOMCODINGSTATISTICS_ENTROPYSCALE/2)/TCOMCODINGSTATISTICS_ENTROPYSCALE;
+          if (tool==STATS_TOOL__VSP && d.numVspMergedPUs!=0)
+          {
+            printf(" %-45s:  %6s %6u %12lld merged PUs\n", getToolName(TComCodingStatisticsTool(tool)), "-", layerId, d.numVspMergedPUs);
+          }
+          else if (sCABAC.count!=0 || sEP.count!=0)
+          {
+            TChar layerStr[16];
+            snprintf(layerStr, sizeof(layerStr), "L%u", layerId);
+            OutputLine(getToolName(TComCodingStatisticsTool(tool)), ':', "-", layerStr, sCABAC, sEP);
+          }
+        }
+      }
+    }
+#endif
+
     ~TComCodingStatistics()
     {
       const Int64 es=TCOMCODINGSTATISTICS_ENTROPYSCALE;
 
+      // merge the counters of all layers
+      TComCodingStatisticsLayerData *pTotal=new TComCodingStatisticsLayerData;
+      for(UInt layerId=0; layerId<data.layers.size(); layerId++)
+      {
+        *pTotal+=data.layers[layerId];
+      }
+      const TComCodingStatisticsLayerData &total=*pTotal;
+
       Int64 cr=0; // CABAC remainder, which is added to "STATS__CABAC_INITIALISATION"
       {
         Int64 totalCABACbits=0, roundedCABACbits=0;
@@ -339,8 +635,8 @@ class TComCodingStatistics
         {
           for(UInt c=0; c<CODING_STATS_NUM_SUBCLASSES; c++)
           {
-            totalCABACbits+=data.statistics[i][c].bits;
-            roundedCABACbits+=data.statistics[i][c].bits/es;
+            totalCABACbits+=total.statistics[i][c].bits;
+            roundedCABACbits+=total.statistics[i][c].bits/es;
           }
         }
         Int64 remainder=totalCABACbits - roundedCABACbits*es;
@@ -363,8 +659,8 @@ class TComCodingStatistics
 
         for(UInt c=0; c<CODING_STATS_NUM_SUBCLASSES; c++)
         {
-          SStat &sCABACorig=data.statistics[i][c];
-          SStat &sEP=data.statistics_ep[i][c];
+          const SStat &sCABACorig=total.statistics[i][c];
+          const SStat &sEP=total.statistics_ep[i][c];
 
           if (sCABACorig.bits==0 && sEP.bits==0)
           {
@@ -410,7 +706,9 @@ class TComCodingStatistics
 
       OutputDashedLine("CAVLC HEADER BITS");
       SStat cavlcTotalBits;
-      for(std::map<std::string, SStat>::iterator it=data.mappings_ep.begin(); it!=data.mappings_ep.end(); it++)
+      std::map<std::string, SStat> mappings;
+      getCavlcStatistics(total, mappings);
+      for(std::map<std::string, SStat>::const_iterator it=mappings.begin(); it!=mappings.end(); it++)
       {
         SStat s=it->second;
         cavlcTotalBits+=s;
@@ -464,12 +762,19 @@ class TComCodingStatistics
         }
       }
 
+      OutputLayerBreakdown();
+#if NH_3D
+      OutputToolBreakdown();
+#endif
+
       OutputDashedLine("");
       OutputLine("CABAC Sub-total", '~', "~~ST~~", "~~ST~~", cabacTotalBits, epTotalBits);
       OutputLine("CAVLC Header Sub-total", '~', "~~ST~~", "~~ST~~", cavlcTotalBits);
       OutputDashedLine("GRAND TOTAL");
       epTotalBits+=cavlcTotalBits;
       OutputLine("TOTAL", '~', "~~GT~~", "~~GT~~", cabacTotalBits, epTotalBits);
+
+      delete pTotal;
     }
 
 
@@ -481,13 +786,34 @@ class TComCodingStatistics
     }
 
     static const TComCodingStatisticsData &GetStatistics()         { return GetSingletonInstance().data; }
-    static Void SetStatistics(const TComCodingStatisticsData &src) { GetSingletonInstance().data=src; }
+    static Void SetStatistics(const TComCodingStatisticsData &src)
+    {
+      TComCodingStatistics &inst=GetSingletonInstance();
+      inst.data=src;
+      inst.setCurrentLayer(inst.currLayerId);
+    }
+
+    // select the counters that are updated until the next call, invoked once at the start of each NAL unit
+    static Void SetCurrentLayer(const UInt layerId)
+    {
+      TComCodingStatistics &inst=GetSingletonInstance();
+      if (layerId!=inst.currLayerId)
+      {
+        inst.setCurrentLayer(layerId);
+      }
+    }
 
-    static SStat &GetStatisticEP(const TComCodingStatisticsClassType &stat) { return GetSingletonInstance().data.statistics_ep[stat.type][stat.subClass]; }
+    static SStat &GetStatisticEP(const TComCodingStatisticsClassType &stat) { return GetCurrentCounters().pLayerData->statistics_ep[stat.type][stat.subClass]; }
 
-    static SStat &GetStatisticEP(const std::string &str) { return GetSingletonInstance().data.mappings_ep[str]; }
+    static SStat &GetStatisticEP(const std::string &str) { return GetCurrentCounters().pLayerData->mappings_ep[str]; }
 
-    static SStat &GetStatisticEP(const TChar *pKey) {return GetStatisticEP(std::string(pKey)); }
+    // pKey must be a string literal, see TComCodingStatisticsData
+    static SStat &GetStatisticEP(const TChar *pKey)
+    {
+      SCurrentCounters &curr=GetCurrentCounters();
+      const UInt symbolIdx=curr.pData->getCavlcSymbolIdx(pKey);
+      return symbolIdx<CODING_STATS_MAX_CAVLC_SYMBOLS ? curr.pLayerData->cavlc_ep[symbolIdx] : curr.pLayerData->mappings_ep[pKey];
+    }
 
     static Void IncrementStatisticEP(const TComCodingStatisticsClassType &stat, const Int numBits, const Int value)
     {
@@ -513,16 +839,21 @@ class TComCodingStatistics
       s.sum+=value;
     }
 
-    StatLogValue values;
+#if NH_3D_VSP
+    static Void IncrementVspMergedPUs()
+    {
+      GetCurrentCounters().pLayerData->numVspMergedPUs++;
+    }
+#endif
 
     static Void UpdateCABACStat(const TComCodingStatisticsClassType &stat, UInt uiRangeBefore, UInt uiRangeAfter, Int val)
     {
-      TComCodingStatistics &inst=GetSingletonInstance();
+      const SCurrentCounters &curr=GetCurrentCounters();
       // doing rangeBefore*p(x)=rangeAfter
       // p(x)=rangeAfter/rangeBefore
       // entropy = -log2(p(x))=-log(p(x))/log(2) = -(log rangeAfter - log rangeBefore) / log(2) = (log rangeBefore / log 2 - log rangeAfter / log 2)
-      SStat &s=inst.data.statistics[stat.type][stat.subClass];
-      s.bits+=inst.values.values[uiRangeBefore]-inst.values.values[uiRangeAfter];
+      SStat &s=curr.pLayerData->statistics[stat.type][stat.subClass];
+      s.bits+=curr.pLogValues[uiRangeBefore]-curr.pLogValues[uiRangeAfter];
       s.count++;
       s.sum+=val;
     }
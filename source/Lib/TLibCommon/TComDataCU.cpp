@@ -452,6 +452,9 @@ Void TComDataCU::destroy()
     for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
     {
       const RefPicList rpl=RefPicList(i);
+#if NH_3D_REF_MOTION_STORE
+      if ( m_acCUMvField[rpl].isAllocated() )
+#endif
       m_acCUMvField[rpl].destroy();
     }
 #if NH_3D_NBDV 
@@ -655,6 +658,20 @@ Void TComDataCU::initCtu( TComPic* pcPic, UInt ctuRsAddr )
 #endif
   }
 
+#if NH_3D_REF_MOTION_STORE
+  // motion arrays of a picture CTU are released once its access unit is finished, see releaseMotionData()
+  if ( !m_acCUMvField[REF_PIC_LIST_0].isAllocated() )
+  {
+    for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
+    {
+      m_acCUMvField[i].create( m_uiNumPartition );
+    }
+#if NH_3D_NBDV
+    m_pDvInfo = (DisInfo* )xMalloc(DisInfo, m_uiNumPartition);
+#endif
+  }
+  pcPic->getPicSym()->getRefMotionStore().clearCtu( ctuRsAddr );
+#endif
   for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
   {
     m_acCUMvField[i].clearMvField();
@@ -3455,15 +3472,26 @@ Void TComDataCU::xGetInterMergeCandidates( UInt uiAbsPartIdx, UInt uiPUIdx, TCom
 
       pcTexRec->getCUAddrAndPartIdx( iCenterPosX , iCenterPosY , iTexCenterCUAddr, iTexCenterAbsPartIdx );
       TComDataCU* pcDefaultCU    = pcTexPic->getCtu( iTexCenterCUAddr );
+#if NH_3D_REF_MOTION_STORE
+      const TComRefMotionStore& rcTexStore    = pcTexPic->getPicSym()->getRefMotionStore();
+      const RefMotionUnit&      rcDefaultUnit = rcTexStore.getUnit( iTexCenterCUAddr, iTexCenterAbsPartIdx );
+
+      if( rcDefaultUnit.m_ePredMode != MODE_INTRA )
+#else
 
       if( pcDefaultCU->getPredictionMode( iTexCenterAbsPartIdx ) != MODE_INTRA )
+#endif
       {
         for( UInt uiCurrRefListId = 0; uiCurrRefListId < 2; uiCurrRefListId++ )
         {
           RefPicList  eCurrRefPicList = RefPicList( uiCurrRefListId );
 
           TComMvField cDefaultMvField;
+#if NH_3D_REF_MOTION_STORE
+          cDefaultMvField.setMvField( rcDefaultUnit.m_acMv[eCurrRefPicList], rcDefaultUnit.m_aiRefIdx[eCurrRefPicList] );
+#else
           pcDefaultCU->getMvField( pcDefaultCU, iTexCenterAbsPartIdx, eCurrRefPicList, cDefaultMvField );
+#endif
           Int         iDefaultRefIdx     = cDefaultMvField.getRefIdx();
           if (iDefaultRefIdx >= 0)
           {
@@ -3504,14 +3532,24 @@ Void TComDataCU::xGetInterMergeCandidates( UInt uiAbsPartIdx, UInt uiPUIdx, TCom
             iTexPosY     = i + iOffsetY; 
             pcTexRec->getCUAddrAndPartIdx( iTexPosX, iTexPosY, iTexCUAddr, iTexAbsPartIdx );
             pcTexCU  = pcTexPic->getCtu( iTexCUAddr );
+#if NH_3D_REF_MOTION_STORE
+            const RefMotionUnit& rcTexUnit = rcTexStore.getUnit( iTexCUAddr, iTexAbsPartIdx );
+
+            if( pcTexCU && rcTexUnit.m_ePredMode != MODE_INTRA )
+#else
 
             if( pcTexCU && !pcTexCU->isIntra(iTexAbsPartIdx) )
+#endif
             {
               for( UInt uiCurrRefListId = 0; uiCurrRefListId < 2; uiCurrRefListId++ )
               {
                 RefPicList  eCurrRefPicList = RefPicList( uiCurrRefListId );
                 TComMvField cTexMvField;
+#if NH_3D_REF_MOTION_STORE
+                cTexMvField.setMvField( rcTexUnit.m_acMv[eCurrRefPicList], rcTexUnit.m_aiRefIdx[eCurrRefPicList] );
+#else
                 pcTexCU->getMvField( pcTexCU, iTexAbsPartIdx, eCurrRefPicList, cTexMvField );
+#endif
                 Int iValidDepRef = getPic()->isTextRefValid( eCurrRefPicList, cTexMvField.getRefIdx() );
                 if( (cTexMvField.getRefIdx()>=0) && ( iValidDepRef >= 0 ) )
                 {
@@ -4673,6 +4711,26 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
   // use coldir.
   const TComPic    * const pColPic = getSlice()->getRefPic( RefPicList(getSlice()->isInterB() ? 1-getSlice()->getColFromL0Flag() : 0), getSlice()->getColRefIdx());
   const TComDataCU * const pColCtu = pColPic->getCtu( ctuRsAddr );
+#if NH_3D_REF_MOTION_STORE
+  const RefMotionUnit& rcColUnit = pColPic->getPicSym()->getRefMotionStore().getUnit( ctuRsAddr, absPartAddr );
+  if(pColCtu->getPic()==0 || !rcColUnit.m_bInside)
+  {
+    return false;
+  }
+
+  if (rcColUnit.m_ePredMode != MODE_INTER)
+  {
+    return false;
+  }
+
+  RefPicList eColRefPicList = getSlice()->getCheckLDC() ? eRefPicList : RefPicList(getSlice()->getColFromL0Flag());
+  Int iColRefIdx            = rcColUnit.m_aiRefIdx[eColRefPicList];
+
+  if (iColRefIdx < 0 )
+  {
+    eColRefPicList = RefPicList(1 - eColRefPicList);
+    iColRefIdx = rcColUnit.m_aiRefIdx[eColRefPicList];
+#else
   if(pColCtu->getPic()==0 || pColCtu->getPartitionSize(partUnitIdx)==NUMBER_OF_PART_SIZES)
   {
     return false;
@@ -4690,6 +4748,7 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
   {
     eColRefPicList = RefPicList(1 - eColRefPicList);
     iColRefIdx = pColCtu->getCUMvField(RefPicList(eColRefPicList))->getRefIdx(absPartAddr);
+#endif
 
     if (iColRefIdx < 0 )
     {
@@ -4723,7 +4782,11 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
 #endif
   }
   // Scale the vector.
+#if NH_3D_REF_MOTION_STORE
+  const TComMv &cColMv = rcColUnit.m_acMv[eColRefPicList];
+#else
   const TComMv &cColMv = pColCtu->getCUMvField(eColRefPicList)->getMv(absPartAddr);
+#endif
 
 #if NH_3D_TMVP
   if ( bIsCurrRefLongTerm || bIsColRefLongTerm )
@@ -4735,7 +4798,11 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
     const Int iCurrViewId    = m_pcSlice->getViewId (); 
     const Int iCurrRefViewId = m_pcSlice->getRefPic(eRefPicList, refIdx)->getViewId (); 
     const Int iColViewId     = pColCtu->getSlice()->getViewId(); 
+#if NH_3D_REF_MOTION_STORE
+    const Int iColRefViewId  = pColCtu->getSlice()->getRefPic( eColRefPicList, iColRefIdx )->getViewId(); 
+#else
     const Int iColRefViewId  = pColCtu->getSlice()->getRefPic( eColRefPicList, pColCtu->getCUMvField(eColRefPicList)->getRefIdx(absPartAddr))->getViewId(); 
+#endif
     Int scale = 4096;
     if ( iCurrRefViewId != iCurrViewId && iColViewId != iColRefViewId )
     {
@@ -4834,6 +4901,44 @@ Void TComDataCU::printMV( )
   }
 
 }
+
+#if NH_3D_REF_MOTION_STORE
+/** Copy the (compressed) motion of the CTU into the reference motion store
+ * \param rcStore store of the picture the CTU belongs to
+ */
+Void TComDataCU::storeRefMotion( TComRefMotionStore& rcStore ) const
+{
+  const UInt uiPartsInUnit = 1 << rcStore.getLog2PartsInUnit();
+  for ( UInt uiAbsPartIdx = 0; uiAbsPartIdx < m_uiNumPartition; uiAbsPartIdx += uiPartsInUnit )
+  {
+    RefMotionUnit& rcUnit = rcStore.getUnit( m_ctuRsAddr, uiAbsPartIdx );
+    for ( UInt uiList = 0; uiList < NUM_REF_PIC_LIST_01; uiList++ )
+    {
+      rcUnit.m_acMv    [uiList] = m_acCUMvField[uiList].getMv    ( uiAbsPartIdx );
+      rcUnit.m_aiRefIdx[uiList] = m_acCUMvField[uiList].getRefIdx( uiAbsPartIdx );
+    }
+    rcUnit.m_ePredMode = m_pePredMode[uiAbsPartIdx];
+    rcUnit.m_bInside   = ( m_pePartSize[uiAbsPartIdx] != NUMBER_OF_PART_SIZES );
+  }
+}
+
+/** Release the per-partition motion vectors, reference indices and disparity information of a picture CTU.
+ *  They are allocated again by initCtu() when the picture buffer is reused.
+ */
+Void TComDataCU::releaseMotionData()
+{
+  for ( UInt i = 0; i < NUM_REF_PIC_LIST_01; i++ )
+  {
+    if ( m_acCUMvField[i].isAllocated() )
+    {
+      m_acCUMvField[i].destroy();
+    }
+  }
+#if NH_3D_NBDV
+  if ( m_pDvInfo ) { xFree(m_pDvInfo); m_pDvInfo = NULL; }
+#endif
+}
+#endif
 #endif
 
 UInt TComDataCU::getCoefScanIdx(const UInt uiAbsPartIdx, const UInt uiWidth, const UInt uiHeight, const ComponentID compID) const
@@ -5199,7 +5304,7 @@ Void TComDataCU::getDisMvpCandNBDV( DisInfo* pDInfo
 }
 
 #if NH_3D_NBDV_REF
-Pel TComDataCU::getMcpFromDM(TComPicYuv* pcBaseViewDepthPicYuv, TComMv* mv, Int iBlkX, Int iBlkY, Int iBlkWidth, Int iBlkHeight, Int* aiShiftLUT )
+Pel TComDataCU::getMcpFromDM(TComPicYuv* pcBaseViewDepthPicYuv, TComMv* mv, Int iBlkX, Int iBlkY, Int iBlkWidth, Int iBlkHeight, const Int* aiShiftLUT )
 {
   Int iPictureWidth  = pcBaseViewDepthPicYuv->getWidth(COMPONENT_Y);
   Int iPictureHeight = pcBaseViewDepthPicYuv->getHeight(COMPONENT_Y);
@@ -5234,7 +5339,7 @@ Void TComDataCU::estimateDVFromDM(Int refViewIdx, UInt uiPartIdx, TComPic* picDe
     Int iBlkX = ( getCtuRsAddr() % picDepth->getFrameWidthInCtus() ) * sps.getMaxCUWidth()  + g_auiRasterToPelX[ g_auiZscanToRaster[ uiAbsPartAddrCurrCU ] ];
     Int iBlkY = ( getCtuRsAddr() / picDepth->getFrameWidthInCtus() ) * sps.getMaxCUHeight() + g_auiRasterToPelY[ g_auiZscanToRaster[ uiAbsPartAddrCurrCU ] ];
 
-    Int* aiShiftLUT = getSlice()->getDepthToDisparityB(refViewIdx );
+    const Int* aiShiftLUT = getSlice()->getDepthToDisparityB(refViewIdx );
 
     Pel iDisp = getMcpFromDM( pcBaseViewDepthPicYuv, cMvPred, iBlkX, iBlkY, iWidth, iHeight, aiShiftLUT );
     cMvPred->setHor( iDisp );
@@ -5384,7 +5489,12 @@ Bool TComDataCU::xGetColDisMV( Int currCandPic, RefPicList eRefPicList, Int refi
   TComPic *pColPic = getSlice()->getRefPic( eRefPicList, refidx);
   TComDataCU *pColCU = pColPic->getCtu( uiCUAddr );
   iColViewIdx = pColCU->getSlice()->getViewIndex();
+#if NH_3D_REF_MOTION_STORE
+  const RefMotionUnit& rcColUnit = pColPic->getPicSym()->getRefMotionStore().getUnit( uiCUAddr, uiPartUnitIdx );
+  if (pColCU->getPic()==0||!rcColUnit.m_bInside||rcColUnit.m_ePredMode==MODE_INTRA)
+#else
   if (pColCU->getPic()==0||pColCU->getPartitionSize(uiPartUnitIdx)==NUMBER_OF_PART_SIZES||pColCU->isIntra(uiPartUnitIdx))
+#endif
   {
     return false;
   }
@@ -5395,7 +5505,11 @@ Bool TComDataCU::xGetColDisMV( Int currCandPic, RefPicList eRefPicList, Int refi
       eColRefPicList = RefPicList(ilist);
     }
 
+#if NH_3D_REF_MOTION_STORE
+    Int iColRefIdx = rcColUnit.m_aiRefIdx[eColRefPicList];
+#else
     Int iColRefIdx = pColCU->getCUMvField(eColRefPicList)->getRefIdx(uiPartUnitIdx);
+#endif
 
     if (iColRefIdx < 0)
     {
@@ -5415,7 +5529,11 @@ Bool TComDataCU::xGetColDisMV( Int currCandPic, RefPicList eRefPicList, Int refi
     {
       if(getPic()->isTempIVRefValid(currCandPic, ilist,  iColRefIdx))
       {
+#if NH_3D_REF_MOTION_STORE
+        rcMv = rcColUnit.m_acMv[eColRefPicList];
+#else
         rcMv = pColCU->getCUMvField(eColRefPicList)->getMv(uiPartUnitIdx);
+#endif
         rcMv.setIDVFlag(0);
         iTargetViewIdx  = iColRefViewIdx ;
         iStartViewIdx   = iColViewIdx   ;
@@ -5654,7 +5772,12 @@ TComDataCU::getInterViewMergeCands(UInt uiPartIdx, Int* paiPdmRefIdx, TComMv* pa
 
         pcBaseRec->getCUAddrAndPartIdx( iRefCenterPosX , iRefCenterPosY , iRefCenterCUAddr, iRefCenterAbsPartIdx );
         TComDataCU* pcDefaultCU    = pcBasePic->getCtu( iRefCenterCUAddr );
+#if NH_3D_REF_MOTION_STORE
+        const RefMotionUnit& rcDefaultUnit = pcBasePic->getPicSym()->getRefMotionStore().getUnit( iRefCenterCUAddr, iRefCenterAbsPartIdx );
+        if(!( rcDefaultUnit.m_ePredMode == MODE_INTRA ))
+#else
         if(!( pcDefaultCU->getPredictionMode( iRefCenterAbsPartIdx ) == MODE_INTRA ))
+#endif
         {
           for( UInt uiCurrRefListId = 0; uiCurrRefListId < 2; uiCurrRefListId++ )       
           {
@@ -5664,7 +5787,11 @@ TComDataCU::getInterViewMergeCands(UInt uiPartIdx, Int* paiPdmRefIdx, TComMv* pa
             {
               RefPicList eDefaultRefPicList = (iLoop ==1)? RefPicList( 1 -  uiCurrRefListId ) : RefPicList( uiCurrRefListId );
               TComMvField cDefaultMvField;
+#if NH_3D_REF_MOTION_STORE
+              cDefaultMvField.setMvField( rcDefaultUnit.m_acMv[eDefaultRefPicList], rcDefaultUnit.m_aiRefIdx[eDefaultRefPicList] );
+#else
               pcDefaultCU->getMvField( pcDefaultCU, iRefCenterAbsPartIdx, eDefaultRefPicList, cDefaultMvField );
+#endif
               Int         iDefaultRefIdx     = cDefaultMvField.getRefIdx();
               if (iDefaultRefIdx >= 0)
               {
@@ -5716,7 +5843,12 @@ TComDataCU::getInterViewMergeCands(UInt uiPartIdx, Int* paiPdmRefIdx, TComMv* pa
 
               pcBaseRec->getCUAddrAndPartIdx( iBasePosX , iBasePosY, iBaseCUAddr, iBaseAbsPartIdx );
               pcBaseCU    = pcBasePic->getCtu( iBaseCUAddr );
+#if NH_3D_REF_MOTION_STORE
+              const RefMotionUnit& rcBaseUnit = pcBasePic->getPicSym()->getRefMotionStore().getUnit( iBaseCUAddr, iBaseAbsPartIdx );
+              if(!( rcBaseUnit.m_ePredMode == MODE_INTRA ))
+#else
               if(!( pcBaseCU->getPredictionMode( iBaseAbsPartIdx ) == MODE_INTRA ))
+#endif
               {
                 for( UInt uiCurrRefListId = 0; uiCurrRefListId < 2; uiCurrRefListId++ )
                 {
@@ -5726,7 +5858,11 @@ TComDataCU::getInterViewMergeCands(UInt uiPartIdx, Int* paiPdmRefIdx, TComMv* pa
                   {
                     RefPicList eBaseRefPicList = (iLoop ==1)? RefPicList( 1 -  uiCurrRefListId ) : RefPicList( uiCurrRefListId );
                     TComMvField cBaseMvField;
+#if NH_3D_REF_MOTION_STORE
+                    cBaseMvField.setMvField( rcBaseUnit.m_acMv[eBaseRefPicList], rcBaseUnit.m_aiRefIdx[eBaseRefPicList] );
+#else
                     pcBaseCU->getMvField( pcBaseCU, iBaseAbsPartIdx, eBaseRefPicList, cBaseMvField );
+#endif
                     Int         iBaseRefIdx     = cBaseMvField.getRefIdx();
                     if (iBaseRefIdx >= 0)
                     {
@@ -5812,7 +5948,12 @@ TComDataCU::getInterViewMergeCands(UInt uiPartIdx, Int* paiPdmRefIdx, TComMv* pa
       pcBaseRec->getCUAddrAndPartIdx( iBasePosX , iBasePosY , iBaseCUAddr, iBaseAbsPartIdx );
 
       TComDataCU* pcBaseCU    = pcBasePic->getCtu( iBaseCUAddr );
+#if NH_3D_REF_MOTION_STORE
+      const RefMotionUnit& rcBaseUnit = pcBasePic->getPicSym()->getRefMotionStore().getUnit( iBaseCUAddr, iBaseAbsPartIdx );
+      if(!( rcBaseUnit.m_ePredMode == MODE_INTRA ))
+#else
       if(!( pcBaseCU->getPredictionMode( iBaseAbsPartIdx ) == MODE_INTRA ))
+#endif
       {
         // Loop reference picture list of current slice (X in spec). 
         for( UInt uiCurrRefListId = 0; uiCurrRefListId < 2; uiCurrRefListId++ )       
@@ -5825,7 +5966,11 @@ TComDataCU::getInterViewMergeCands(UInt uiPartIdx, Int* paiPdmRefIdx, TComMv* pa
           {
             RefPicList eBaseRefPicList = (iLoop ==1)? RefPicList( 1 -  uiCurrRefListId ) : RefPicList( uiCurrRefListId );
             TComMvField cBaseMvField;
+#if NH_3D_REF_MOTION_STORE
+            cBaseMvField.setMvField( rcBaseUnit.m_acMv[eBaseRefPicList], rcBaseUnit.m_aiRefIdx[eBaseRefPicList] );
+#else
             pcBaseCU->getMvField( pcBaseCU, iBaseAbsPartIdx, eBaseRefPicList, cBaseMvField );
+#endif
             Int         iBaseRefIdx     = cBaseMvField.getRefIdx();
             if (iBaseRefIdx >= 0)
             {
@@ -6025,7 +6170,7 @@ Void TComDataCU::setMvFieldPUForVSP( TComDataCU* pcCU, UInt partAddr, Int width,
 
   // Initialize LUT according to the reference viewIdx
   Int txtRefViewIdx = pRefPicBaseTxt->getViewIndex();
-  Int* pShiftLUT    = pcCU->getSlice()->getDepthToDisparityB( txtRefViewIdx );
+  const Int* pShiftLUT = pcCU->getSlice()->getDepthToDisparityB( txtRefViewIdx );
   assert( txtRefViewIdx < pcCU->getSlice()->getViewIndex() );
 
   // prepare Dv to access depth map or reference view
@@ -6043,7 +6188,7 @@ Void TComDataCU::setMvFieldPUForVSP( TComDataCU* pcCU, UInt partAddr, Int width,
   xSetMvFieldForVSP( pcCU, pcBaseViewDepthPicYuv, &cDv, partAddr, width, height, pShiftLUT, eRefPicList, iRefIdx, pcCU->getSlice()->getIsDepth(), vspSize );
 }
 
-Void TComDataCU::xSetMvFieldForVSP( TComDataCU *cu, TComPicYuv *picRefDepth, TComMv *dv, UInt partAddr, Int width, Int height, Int *shiftLUT, RefPicList refPicList, Int refIdx, Bool isDepth, Int &vspSize )
+Void TComDataCU::xSetMvFieldForVSP( TComDataCU *cu, TComPicYuv *picRefDepth, TComMv *dv, UInt partAddr, Int width, Int height, const Int *shiftLUT, RefPicList refPicList, Int refIdx, Bool isDepth, Int &vspSize )
 {
   TComCUMvField *cuMvField = cu->getCUMvField( refPicList );
   Int partAddrRasterSubPULine  = g_auiZscanToRaster[ partAddr ];
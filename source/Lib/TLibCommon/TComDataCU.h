@@ -247,7 +247,7 @@ protected:
   Void          xDeriveCenterIdx              ( UInt uiPartIdx, UInt& ruiPartIdxCenter ) const;
 
 #if NH_3D_VSP
-  Void xSetMvFieldForVSP  ( TComDataCU *cu, TComPicYuv *picRefDepth, TComMv *dv, UInt partAddr, Int width, Int height, Int *shiftLUT, RefPicList refPicList, Int refIdx, Bool isDepth, Int &vspSize );
+  Void xSetMvFieldForVSP  ( TComDataCU *cu, TComPicYuv *picRefDepth, TComMv *dv, UInt partAddr, Int width, Int height, const Int *shiftLUT, RefPicList refPicList, Int refIdx, Bool isDepth, Int &vspSize );
 #endif
 
 public:
@@ -504,7 +504,7 @@ public:
 #endif
 
 #if NH_3D_NBDV_REF
-  Pel           getMcpFromDM(TComPicYuv* pcBaseViewDepthPicYuv, TComMv* mv, Int iBlkX, Int iBlkY, Int iWidth, Int iHeight, Int* aiShiftLUT );
+  Pel           getMcpFromDM(TComPicYuv* pcBaseViewDepthPicYuv, TComMv* mv, Int iBlkX, Int iBlkY, Int iWidth, Int iHeight, const Int* aiShiftLUT );
   Void          estimateDVFromDM(Int refViewIdx, UInt uiPartIdx, TComPic* picDepth, UInt uiPartAddr, TComMv* cMvPred );
 #endif //NH_3D_NBDV_REF
 #endif
@@ -607,6 +607,10 @@ public:
 #if NH_3D
   Void          compressMV            ( Int scale );
   Void          printMV               ( );
+#if NH_3D_REF_MOTION_STORE
+  Void          storeRefMotion        ( TComRefMotionStore& rcStore ) const;
+  Void          releaseMotionData     ();
+#endif
 #else            
   Void          compressMV            ();
 #endif  
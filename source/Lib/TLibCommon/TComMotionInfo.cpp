@@ -441,4 +441,84 @@ Void TComMotionCand::print( Int i )
 }
 #endif
 #endif
+
+#if NH_3D_REF_MOTION_STORE
+// --------------------------------------------------------------------------------------------------------------------
+// Reference motion store
+// --------------------------------------------------------------------------------------------------------------------
+
+/** Allocate the store for a picture, all units are marked as not coded
+ * \param uiNumCtus          number of CTUs in the picture
+ * \param uiNumPartInCtu     number of z-scan partitions in one CTU
+ * \param uiLog2PartsInUnit  log2 of the number of partitions covered by one storage unit
+ */
+Void TComRefMotionStore::create( UInt uiNumCtus, UInt uiNumPartInCtu, UInt uiLog2PartsInUnit )
+{
+  destroy();
+
+  m_uiNumCtus         = uiNumCtus;
+  m_uiLog2PartsInUnit = uiLog2PartsInUnit;
+  m_uiNumUnitsInCtu   = std::max<UInt>( 1, uiNumPartInCtu >> uiLog2PartsInUnit );
+  m_pcUnit            = new RefMotionUnit[ m_uiNumCtus * m_uiNumUnitsInCtu ];
+
+  for ( UInt ctuRsAddr = 0; ctuRsAddr < m_uiNumCtus; ctuRsAddr++ )
+  {
+    clearCtu( ctuRsAddr );
+  }
+}
+
+Void TComRefMotionStore::destroy()
+{
+  if ( m_pcUnit )
+  {
+    delete[] m_pcUnit;
+    m_pcUnit = NULL;
+  }
+  m_uiNumCtus       = 0;
+  m_uiNumUnitsInCtu = 0;
+}
+
+Void TComRefMotionStore::clearCtu( UInt ctuRsAddr )
+{
+  RefMotionUnit* pcUnit = m_pcUnit + ctuRsAddr * m_uiNumUnitsInCtu;
+  for ( UInt ui = 0; ui < m_uiNumUnitsInCtu; ui++ )
+  {
+    for ( UInt uiList = 0; uiList < NUM_REF_PIC_LIST_01; uiList++ )
+    {
+      pcUnit[ui].m_acMv    [uiList] = TComMv();
+      pcUnit[ui].m_aiRefIdx[uiList] = NOT_VALID;
+    }
+    pcUnit[ui].m_ePredMode = NUMBER_OF_PREDICTION_MODES;
+    pcUnit[ui].m_bInside   = false;
+  }
+}
+
+/** Subsampling of the stored units, equivalent to TComCUMvField::compress on the full arrays
+ * \param uiLog2PartsInGroup log2 of the number of partitions sharing the motion of their first unit
+ */
+Void TComRefMotionStore::compress( UInt uiLog2PartsInGroup )
+{
+  if ( uiLog2PartsInGroup <= m_uiLog2PartsInUnit )
+  {
+    return;
+  }
+  const UInt uiUnitsInGroup = std::min<UInt>( 1 << ( uiLog2PartsInGroup - m_uiLog2PartsInUnit ), m_uiNumUnitsInCtu );
+  const UInt uiNumUnits     = m_uiNumCtus * m_uiNumUnitsInCtu;
+
+  for ( UInt uiGroup = 0; uiGroup < uiNumUnits; uiGroup += uiUnitsInGroup )
+  {
+    const RefMotionUnit& rcFirst = m_pcUnit[uiGroup];
+    for ( UInt ui = 1; ui < uiUnitsInGroup; ui++ )
+    {
+      RefMotionUnit& rcUnit = m_pcUnit[uiGroup + ui];
+      for ( UInt uiList = 0; uiList < NUM_REF_PIC_LIST_01; uiList++ )
+      {
+        rcUnit.m_acMv    [uiList] = rcFirst.m_acMv    [uiList];
+        rcUnit.m_aiRefIdx[uiList] = rcFirst.m_aiRefIdx[uiList];
+      }
+      rcUnit.m_ePredMode = rcFirst.m_ePredMode;
+    }
+  }
+}
+#endif
 //! \}
@@ -191,7 +191,47 @@ public:
 #if NH_MV
   Void print   (SChar* pePredMode);
 #endif
+#if NH_3D_REF_MOTION_STORE
+  Bool isAllocated() const { return m_pcMv != NULL; }
+#endif
+};
+
+#if NH_3D_REF_MOTION_STORE
+/// motion data of one storage unit of a reconstructed picture
+typedef struct _RefMotionUnit
+{
+  TComMv m_acMv    [NUM_REF_PIC_LIST_01];
+  SChar  m_aiRefIdx[NUM_REF_PIC_LIST_01];
+  SChar  m_ePredMode;                        ///< NUMBER_OF_PREDICTION_MODES when the unit has not been coded
+  Bool   m_bInside;                          ///< false when the unit lies outside of the picture (no partition size)
+} RefMotionUnit;
+
+/// compact motion field of a reconstructed picture, read by TMVP, NBDV, inter-view and texture merge candidates
+class TComRefMotionStore
+{
+private:
+  RefMotionUnit* m_pcUnit;
+  UInt           m_uiNumCtus;
+  UInt           m_uiNumUnitsInCtu;
+  UInt           m_uiLog2PartsInUnit;        ///< log2 of the number of z-scan partitions covered by one storage unit
+
+public:
+  TComRefMotionStore() : m_pcUnit(NULL), m_uiNumCtus(0), m_uiNumUnitsInCtu(0), m_uiLog2PartsInUnit(0) {}
+  ~TComRefMotionStore() { destroy(); }
+
+  Void    create  ( UInt uiNumCtus, UInt uiNumPartInCtu, UInt uiLog2PartsInUnit );
+  Void    destroy ();
+
+  Void    clearCtu( UInt ctuRsAddr );
+  Void    compress( UInt uiLog2PartsInGroup );
+
+  UInt    getLog2PartsInUnit() const { return m_uiLog2PartsInUnit; }
+  UInt    getNumUnitsInCtu  () const { return m_uiNumUnitsInCtu;   }
+
+  RefMotionUnit&       getUnit( UInt ctuRsAddr, UInt uiAbsPartIdx )       { return m_pcUnit[ ctuRsAddr * m_uiNumUnitsInCtu + ( uiAbsPartIdx >> m_uiLog2PartsInUnit ) ]; }
+  const RefMotionUnit& getUnit( UInt ctuRsAddr, UInt uiAbsPartIdx ) const { return m_pcUnit[ ctuRsAddr * m_uiNumUnitsInCtu + ( uiAbsPartIdx >> m_uiLog2PartsInUnit ) ]; }
 };
+#endif
 
 //! \}
 
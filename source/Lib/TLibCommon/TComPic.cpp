@@ -75,6 +75,11 @@ TComPic::TComPic()
 #if NH_3D_QTLPC
   m_bReduceBitsQTL    = 0;
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  m_puhTexAnalysis     = NULL;
+  m_iTexAnalysisStride = 0;
+  m_iTexAnalysisRows   = 0;
+#endif
 #if NH_3D_NBDV
   m_iNumDdvCandPics   = 0;
   m_eRapRefList       = REF_PIC_LIST_0;
@@ -153,8 +158,101 @@ Void TComPic::destroy()
   }
 
   deleteSEIs(m_SEIs);
+#if NH_3D_TEX_GUIDED_MD
+  if ( m_puhTexAnalysis )
+  {
+    delete[] m_puhTexAnalysis;
+    m_puhTexAnalysis = NULL;
+  }
+#endif
 }
 #if NH_3D
+#if NH_3D_TEX_GUIDED_MD
+/** Derive the texture features used by the depth mode decision from the finished picture.
+ * \param edgeThreshold minimum absolute difference of neighbouring 8 bit luma samples that is regarded as edge
+ */
+Void TComPic::buildTextureAnalysis( Int edgeThreshold )
+{
+  const TComPicYuv* pcPicYuv   = getPicYuvRec();
+  const Int         iWidth     = pcPicYuv->getWidth ( COMPONENT_Y );
+  const Int         iHeight    = pcPicYuv->getHeight( COMPONENT_Y );
+  const Int         iStride    = pcPicYuv->getStride( COMPONENT_Y );
+  const Int         iUnitSize  = getMinCUWidth();
+  const Int         iThreshold = edgeThreshold << ( getPicSym()->getSPS().getBitDepth( CHANNEL_TYPE_LUMA ) - 8 );
+
+  if ( m_puhTexAnalysis == NULL )
+  {
+    m_iTexAnalysisStride = ( iWidth  + iUnitSize - 1 ) / iUnitSize;
+    m_iTexAnalysisRows   = ( iHeight + iUnitSize - 1 ) / iUnitSize;
+    m_puhTexAnalysis     = new UChar[ m_iTexAnalysisStride * m_iTexAnalysisRows ];
+  }
+
+  for( Int iUnitY = 0; iUnitY < m_iTexAnalysisRows; iUnitY++ )
+  {
+    for( Int iUnitX = 0; iUnitX < m_iTexAnalysisStride; iUnitX++ )
+    {
+      const Int iPosX = iUnitX * iUnitSize;
+      const Int iPosY = iUnitY * iUnitSize;
+      const Pel* piRec = pcPicYuv->getAddr( COMPONENT_Y ) + iPosY * iStride + iPosX;
+      UChar uhFlags    = 0;
+      for( Int y = 0; y < iUnitSize && iPosY + y < iHeight; y++ )
+      {
+        for( Int x = 0; x < iUnitSize && iPosX + x < iWidth; x++ )
+        {
+          if ( iPosX + x + 1 < iWidth && abs( piRec[ x + 1 ] - piRec[ x ] ) > iThreshold )
+          {
+            uhFlags |= TEX_EDGE_HOR;
+          }
+          if ( iPosY + y + 1 < iHeight && abs( piRec[ x + iStride ] - piRec[ x ] ) > iThreshold )
+          {
+            uhFlags |= TEX_EDGE_VER;
+          }
+        }
+        piRec += iStride;
+      }
+      m_puhTexAnalysis[ iUnitY * m_iTexAnalysisStride + iUnitX ] = uhFlags;
+    }
+  }
+
+  for( UInt uiCtuRsAddr = 0; uiCtuRsAddr < getNumberOfCtusInFrame(); uiCtuRsAddr++ )
+  {
+    const TComDataCU* pcCtu = getCtu( uiCtuRsAddr );
+    for( UInt uiAbsPartIdx = 0; uiAbsPartIdx < getNumPartitionsInCtu(); uiAbsPartIdx++ )
+    {
+      const Int iPosX = Int( pcCtu->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[ uiAbsPartIdx ] ] );
+      const Int iPosY = Int( pcCtu->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[ uiAbsPartIdx ] ] );
+      if ( iPosX < iWidth && iPosY < iHeight && !pcCtu->isSkipped( uiAbsPartIdx ) )
+      {
+        m_puhTexAnalysis[ ( iPosY / iUnitSize ) * m_iTexAnalysisStride + iPosX / iUnitSize ] |= TEX_CODED;
+      }
+    }
+  }
+}
+
+/** OR of the texture features of all units overlapping a block, TEX_ALL if the features have not been derived. */
+UChar TComPic::getTextureAnalysis( Int iX, Int iY, Int iWidth, Int iHeight ) const
+{
+  if ( m_puhTexAnalysis == NULL )
+  {
+    return TEX_ALL;
+  }
+  const Int iUnitSize = getMinCUWidth();
+  const Int iUnitX0   = std::min( iX / iUnitSize, m_iTexAnalysisStride - 1 );
+  const Int iUnitY0   = std::min( iY / iUnitSize, m_iTexAnalysisRows   - 1 );
+  const Int iUnitX1   = std::min( ( iX + iWidth  - 1 ) / iUnitSize, m_iTexAnalysisStride - 1 );
+  const Int iUnitY1   = std::min( ( iY + iHeight - 1 ) / iUnitSize, m_iTexAnalysisRows   - 1 );
+
+  UChar uhFlags = 0;
+  for( Int iUnitY = iUnitY0; iUnitY <= iUnitY1; iUnitY++ )
+  {
+    for( Int iUnitX = iUnitX0; iUnitX <= iUnitX1; iUnitX++ )
+    {
+      uhFlags |= m_puhTexAnalysis[ iUnitY * m_iTexAnalysisStride + iUnitX ];
+    }
+  }
+  return uhFlags;
+}
+#endif
 #if NH_3D_ARP
 Void TComPic::getCUAddrAndPartIdx( Int iX, Int iY, Int& riCuAddr, Int& riAbsZorderIdx )
 {
@@ -186,11 +284,33 @@ Void TComPic::compressMotion()
 #endif
 {
   TComPicSym* pPicSym = getPicSym();
+#if NH_3D_REF_MOTION_STORE
+  TComRefMotionStore& rcStore = pPicSym->getRefMotionStore();
+  if ( scale == 1 )
+  {
+    // final stage at the end of the access unit: only the store is accessed from now on
+    const Int iScaleFactor = 4 * AMVP_DECIMATION_FACTOR / pPicSym->getMinCUWidth();
+    UInt uiLog2PartsInGroup = 0;
+    for ( Int i = iScaleFactor; i > 1; i >>= 1 )
+    {
+      uiLog2PartsInGroup += 2;
+    }
+    rcStore.compress( uiLog2PartsInGroup );
+    for ( UInt uiCUAddr = 0; uiCUAddr < pPicSym->getNumberOfCtusInFrame(); uiCUAddr++ )
+    {
+      pPicSym->getCtu(uiCUAddr)->releaseMotionData();
+    }
+    return;
+  }
+#endif
   for ( UInt uiCUAddr = 0; uiCUAddr < pPicSym->getNumberOfCtusInFrame(); uiCUAddr++ )
   {
     TComDataCU* pCtu = pPicSym->getCtu(uiCUAddr);
 #if NH_3D
     pCtu->compressMV(scale); 
+#if NH_3D_REF_MOTION_STORE
+    pCtu->storeRefMotion( rcStore );
+#endif
 #else
     pCtu->compressMV();
 #endif
@@ -590,11 +710,23 @@ Bool TComAu::containsPic( TComPic* pic )
 TComSubDpb::TComSubDpb( Int nuhLayerid )
 {
   m_nuhLayerId = nuhLayerid;
+#if NH_MV_DPB_POC_INDEX
+  m_numIndexedPics = 0;
+#endif
 }
 
 TComPic* TComSubDpb::getPic( Int poc )
 {
+#if NH_MV_DPB_POC_INDEX
+  TComPic* pic = xLookUpPocIndex( poc );
+  if ( pic != NULL )
+  {
+    return pic;
+  }
+  // POCs of pictures might have been changed after indexing (e.g. re-used encoder buffers), search and re-index when found
+#else
   TComPic* pic = NULL; 
+#endif
   for(TComList<TComPic*>::iterator itP= begin(); ( itP!= end() && (pic == NULL) ); itP++)
   {      
     if ( (*itP)->getPOC() == poc )
@@ -602,6 +734,12 @@ TComPic* TComSubDpb::getPic( Int poc )
       pic = (*itP); 
     }
   }
+#if NH_MV_DPB_POC_INDEX
+  if ( pic != NULL )
+  {
+    rebuildPocIndex();
+  }
+#endif
   return pic;
 }
 
@@ -620,7 +758,16 @@ TComPic* TComSubDpb::getPicFromLsb( Int pocLsb, Int maxPicOrderCntLsb )
 
 TComPic* TComSubDpb::getShortTermRefPic( Int poc )
 {
+#if NH_MV_DPB_POC_INDEX
+  // several pictures may share the POC (e.g. a long-term one from a previous CVS), only the short-term one is returned
+  TComPic* pic = xLookUpPocIndex( poc, true );
+  if ( pic != NULL )
+  {
+    return pic;
+  }
+#else
   TComPic* pic = NULL; 
+#endif
   for(TComList<TComPic*>::iterator itP= begin(); ( itP!= end() && (pic == NULL) ); itP++)
   {      
     if ( (*itP)->getPOC() == poc && (*itP)->getMarkedAsShortTerm() )
@@ -628,6 +775,12 @@ TComPic* TComSubDpb::getShortTermRefPic( Int poc )
       pic = (*itP); 
     }
   }
+#if NH_MV_DPB_POC_INDEX
+  if ( pic != NULL )
+  {
+    rebuildPocIndex();
+  }
+#endif
   return pic;
 }
 
@@ -681,6 +834,9 @@ Void TComSubDpb::addPic( TComPic* pic )
   { 
     pushBack( pic );
   }
+#if NH_MV_DPB_POC_INDEX
+  rebuildPocIndex();
+#endif
 }
 
 Void TComSubDpb::removePics( std::vector<TComPic*> picToRemove )
@@ -699,6 +855,56 @@ Bool TComSubDpb::areAllPicsMarkedNotNeedForOutput()
   return ( getPicsMarkedNeedForOutput().size() == 0 );
 }
 
+#if NH_MV_DPB_POC_INDEX
+Void TComSubDpb::remove( TComPic* pic )
+{
+  TComList<TComPic*>::remove( pic );
+  // drop the removed picture from the index before it gets destroyed
+  rebuildPocIndex();
+}
+
+Void TComSubDpb::rebuildPocIndex()
+{
+  UInt indexSize = 32;
+  while ( indexSize < 2 * size() )
+  {
+    indexSize <<= 1;
+  }
+  m_pocIndex.assign( indexSize, NULL );
+
+  const UInt mask = indexSize - 1;
+  for( TComList<TComPic*>::iterator itP = begin(); itP != end(); itP++ )
+  {
+    UInt slot = (UInt)(*itP)->getPOC() & mask;
+    while ( m_pocIndex[ slot ] != NULL )
+    {
+      slot = ( slot + 1 ) & mask;
+    }
+    m_pocIndex[ slot ] = (*itP);
+  }
+  m_numIndexedPics = size();
+}
+
+TComPic* TComSubDpb::xLookUpPocIndex( Int poc, Bool shortTermOnly )
+{
+  // pictures might have been added or removed via the list interface, e.g. by the encoder
+  if ( m_pocIndex.empty() || m_numIndexedPics != size() )
+  {
+    rebuildPocIndex();
+  }
+
+  const UInt mask = (UInt) m_pocIndex.size() - 1;
+  for( UInt slot = (UInt)poc & mask; m_pocIndex[ slot ] != NULL; slot = ( slot + 1 ) & mask )
+  {
+    if ( m_pocIndex[ slot ]->getPOC() == poc && ( !shortTermOnly || m_pocIndex[ slot ]->getMarkedAsShortTerm() ) )
+    {
+      return m_pocIndex[ slot ];
+    }
+  }
+  return NULL;
+}
+#endif
+
 
 TComPicLists::~TComPicLists()
 {
@@ -795,6 +1001,19 @@ TComPicYuv* TComPicLists::getPicYuv( Int layerIdInNuh, Int poc, Bool reconFlag )
 TComSubDpb* TComPicLists::getSubDpb( Int nuhLayerId, Bool create )
 {
   TComSubDpb* subDpb = NULL;
+#if NH_MV_DPB_POC_INDEX
+  if ( nuhLayerId >= 0 && nuhLayerId < MAX_NUM_LAYER_IDS )
+  {
+    subDpb = m_subDpbIndex[ nuhLayerId ];
+    if ( subDpb == NULL && create )
+    {
+      subDpb = new TComSubDpb( nuhLayerId );
+      m_subDpbs.push_back( subDpb );
+      m_subDpbIndex[ nuhLayerId ] = subDpb;
+    }
+    return subDpb;
+  }
+#endif
   for(TComList<TComSubDpb*>::iterator itL = m_subDpbs.begin(); ( itL != m_subDpbs.end() && subDpb == NULL ); itL++)
   {      
     if ( (*itL)->getLayerId() == nuhLayerId )
@@ -916,6 +1135,9 @@ Void TComPicLists::decrementPocsInSubDpb( Int nuhLayerId, Int deltaPocVal )
       slice->setPOC( slice->getPOC() - deltaPocVal ); 
     }    
   }
+#if NH_MV_DPB_POC_INDEX
+  subDpb->rebuildPocIndex();
+#endif
 }
 Void TComPicLists::emptyAllSubDpbs()
 {
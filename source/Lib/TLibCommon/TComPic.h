@@ -109,6 +109,18 @@ public:
 };
 #endif
 
+#if NH_3D_TEX_GUIDED_MD
+/// features of the reconstructed texture, OR-ed over the units covered by a block
+enum TexAnalysisFlag
+{
+  TEX_EDGE_HOR = 1,                               ///< strong gradient between horizontal neighbours, i.e. a vertical edge
+  TEX_EDGE_VER = 2,                               ///< strong gradient between vertical neighbours, i.e. a horizontal edge
+  TEX_CODED    = 4,                               ///< not coded in skip mode
+  TEX_EDGE     = TEX_EDGE_HOR | TEX_EDGE_VER,
+  TEX_ALL      = TEX_EDGE | TEX_CODED             ///< no information, nothing is pruned
+};
+#endif
+
 class TComPic
 {
 public:
@@ -161,6 +173,11 @@ private:
 #if NH_3D_QTLPC
   Bool                  m_bReduceBitsQTL;
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  UChar*                m_puhTexAnalysis;         ///< TexAnalysisFlag per minimum CU unit, built when the texture picture is finished
+  Int                   m_iTexAnalysisStride;     ///< units per row of m_puhTexAnalysis
+  Int                   m_iTexAnalysisRows;       ///< unit rows of m_puhTexAnalysis
+#endif
 #if NH_3D_NBDV
   UInt                   m_uiRapRefIdx;
   RefPicList             m_eRapRefList;
@@ -331,6 +348,10 @@ public:
    Bool          getReduceBitsFlag ()                     { return m_bReduceBitsQTL;     }
    Void          setReduceBitsFlag ( Bool bFlag )         { m_bReduceBitsQTL = bFlag;    }
 #endif
+#if NH_3D_TEX_GUIDED_MD
+   Void          buildTextureAnalysis( Int edgeThreshold );
+   UChar         getTextureAnalysis  ( Int iX, Int iY, Int iWidth, Int iHeight ) const;
+#endif
 #if NH_3D_NBDV
   Int            getNumDdvCandPics()                      { return m_iNumDdvCandPics;    }
   Int            getDisCandRefPictures(Int iColPOC);        
@@ -381,6 +402,10 @@ class TComSubDpb : public TComList<TComPic*>
 {
 private: 
   Int m_nuhLayerId; 
+#if NH_MV_DPB_POC_INDEX
+  std::vector<TComPic*> m_pocIndex;        ///< open addressing hash table POC -> picture, size is a power of two
+  size_t                m_numIndexedPics;  ///< list size at the time the index has been built
+#endif
 public:  
   TComSubDpb( Int nuhLayerid );
 
@@ -396,6 +421,12 @@ public:
   Void                addPic                          ( TComPic* pic );
   Void                removePics                      ( std::vector<TComPic*> picToRemove );
   Bool                areAllPicsMarkedNotNeedForOutput( );
+#if NH_MV_DPB_POC_INDEX
+  Void                remove                          ( TComPic* pic );
+  Void                rebuildPocIndex                 ( );
+private:
+  TComPic*            xLookUpPocIndex                 ( Int poc, Bool shortTermOnly = false );
+#endif
 };
 
 class TComPicLists 
@@ -403,12 +434,19 @@ class TComPicLists
 private: 
   TComList<TComAu*    >       m_aus;  
   TComList<TComSubDpb*>       m_subDpbs; 
+#if NH_MV_DPB_POC_INDEX
+  std::vector<TComSubDpb*>    m_subDpbIndex;    ///< sub-DPBs indexed by nuh_layer_id
+#endif
   Bool                        m_printPicOutput; 
 #if NH_3D_VSO || NH_3D
   const TComVPS*              m_vps; 
 #endif
 public: 
+#if NH_MV_DPB_POC_INDEX
+  TComPicLists() { m_printPicOutput = false; m_subDpbIndex.resize( MAX_NUM_LAYER_IDS, NULL ); };
+#else
   TComPicLists() { m_printPicOutput = false; };
+#endif
   ~TComPicLists();
 
   // Add and remove single pictures
@@ -133,6 +133,15 @@ Void TComPicSym::create  ( const TComSPS &sps, const TComPPS &pps, UInt uiMaxDep
   }
 
   m_saoBlkParams = new SAOBlkParam[m_numCtusInFrame];
+#if NH_3D_REF_MOTION_STORE
+  // the store keeps the granularity of the first motion compression stage (8x8 luma samples)
+  UInt uiLog2PartsInUnit = 0;
+  for ( UInt uiPartsInUnitWidth = ( 4 / 2 ) * AMVP_DECIMATION_FACTOR / m_uiMinCUWidth; uiPartsInUnitWidth > 1; uiPartsInUnitWidth >>= 1 )
+  {
+    uiLog2PartsInUnit += 2;
+  }
+  m_cRefMotionStore.create( m_numCtusInFrame, m_numPartitionsInCtu, uiLog2PartsInUnit );
+#endif
 
 
   xInitTiles();
@@ -172,6 +181,9 @@ Void TComPicSym::destroy()
   {
     delete[] m_saoBlkParams; m_saoBlkParams = NULL;
   }
+#if NH_3D_REF_MOTION_STORE
+  m_cRefMotionStore.destroy();
+#endif
 
 #if ADAPTIVE_QP_SELECTION
   delete [] m_pParentARLBuffer;
@@ -106,6 +106,9 @@ private:
   UInt*         m_ctuRsToTsAddrMap;    ///< for a given RS (Raster-Scan) address, returns the TS (Tile-Scan; coding order) address. cf CtbAddrRsToTs in specification.
 
   SAOBlkParam  *m_saoBlkParams;
+#if NH_3D_REF_MOTION_STORE
+  TComRefMotionStore m_cRefMotionStore;   ///< compressed motion field used when the picture serves as reference
+#endif
 #if ADAPTIVE_QP_SELECTION
   TCoeff*       m_pParentARLBuffer;
 #endif
@@ -155,6 +158,10 @@ public:
   UInt               getCtuRsToTsAddrMap( Int ctuRsAddr ) const            { return *(m_ctuRsToTsAddrMap + (ctuRsAddr>=m_numCtusInFrame ? m_numCtusInFrame : ctuRsAddr)); }
   SAOBlkParam*       getSAOBlkParam()                                      { return m_saoBlkParams;}
   const SAOBlkParam* getSAOBlkParam() const                                { return m_saoBlkParams;}
+#if NH_3D_REF_MOTION_STORE
+  TComRefMotionStore&       getRefMotionStore()                            { return m_cRefMotionStore; }
+  const TComRefMotionStore& getRefMotionStore() const                      { return m_cRefMotionStore; }
+#endif
   Void               deriveLoopFilterBoundaryAvailibility(Int ctuRsAddr,
                                                           Bool& isLeftAvail, Bool& isRightAvail, Bool& isAboveAvail, Bool& isBelowAvail,
                                                           Bool& isAboveLeftAvail, Bool& isAboveRightAvail, Bool& isBelowLeftAvail, Bool& isBelowRightAvail);
@@ -47,6 +47,9 @@
 
 #include "TComPicYuv.h"
 #include "TLibVideoIO/TVideoIOYuv.h"
+#if NH_MV_SUBPEL_PLANE_CACHE
+#include "TComInterpolationFilter.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -58,6 +61,25 @@ TComPicYuv::TComPicYuv()
     m_apiPicBuf[i]    = NULL;   // Buffer (including margin)
     m_piPicOrg[i]     = NULL;    // m_apiPicBufY + m_iMarginLuma*getStride() + m_iMarginLuma
   }
+#if NH_MV_PYRAMID_ME
+  for(Int level=0; level<NUM_ME_PYRAMID_LEVELS; level++)
+  {
+    m_apiPyramidBuf[level] = NULL;
+    m_apiPyramidOrg[level] = NULL;
+  }
+  m_bIsPyramidBuilt = false;
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  for(Int fracY=0; fracY<LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; fracY++)
+  {
+    for(Int fracX=0; fracX<LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; fracX++)
+    {
+      m_apiSubPelBuf[fracY][fracX] = NULL;
+      m_apiSubPelOrg[fracY][fracX] = NULL;
+    }
+  }
+  m_bIsSubPelBuilt = false;
+#endif
 
   for(UInt i=0; i<MAX_NUM_CHANNEL_TYPE; i++)
   {
@@ -105,6 +127,12 @@ Void TComPicYuv::createWithoutCUInfo ( const Int picWidth,                 ///<
   m_marginX          = (bUseMargin?maxCUWidth:0) + 16;   // for 16-byte alignment
   m_marginY          = (bUseMargin?maxCUHeight:0) + 16;  // margin for 8-tap filter and infinite padding
   m_bIsBorderExtended = false;
+#if NH_MV_PYRAMID_ME
+  m_bIsPyramidBuilt   = false;
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  m_bIsSubPelBuilt    = false;
+#endif
 
   // assign the picture arrays and set up the ptr to the top left of the original picture
   for(UInt comp=0; comp<getNumberValidComponents(); comp++)
@@ -209,6 +237,34 @@ Void TComPicYuv::destroy()
       m_subCuOffsetInBuffer[chan] = NULL;
     }
   }
+
+#if NH_MV_PYRAMID_ME
+  for(Int level=0; level<NUM_ME_PYRAMID_LEVELS; level++)
+  {
+    m_apiPyramidOrg[level] = NULL;
+    if( m_apiPyramidBuf[level] )
+    {
+      xFree( m_apiPyramidBuf[level] );
+      m_apiPyramidBuf[level] = NULL;
+    }
+  }
+  m_bIsPyramidBuilt = false;
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  for(Int fracY=0; fracY<LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; fracY++)
+  {
+    for(Int fracX=0; fracX<LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; fracX++)
+    {
+      m_apiSubPelOrg[fracY][fracX] = NULL;
+      if( m_apiSubPelBuf[fracY][fracX] )
+      {
+        xFree( m_apiSubPelBuf[fracY][fracX] );
+        m_apiSubPelBuf[fracY][fracX] = NULL;
+      }
+    }
+  }
+  m_bIsSubPelBuilt = false;
+#endif
 }
 
 
@@ -254,44 +310,150 @@ Void TComPicYuv::extendPicBorder ()
   for(Int comp=0; comp<getNumberValidComponents(); comp++)
   {
     const ComponentID compId=ComponentID(comp);
-    Pel *piTxt=getAddr(compId); // piTxt = point to (0,0) of image within bigger picture.
-    const Int stride=getStride(compId);
-    const Int width=getWidth(compId);
-    const Int height=getHeight(compId);
-    const Int marginX=getMarginX(compId);
-    const Int marginY=getMarginY(compId);
-
-    Pel*  pi = piTxt;
-    // do left and right margins
-    for (Int y = 0; y < height; y++)
+    // getAddr() points to (0,0) of image within bigger picture.
+    xExtendPlane( getAddr(compId), getStride(compId), getWidth(compId), getHeight(compId), getMarginX(compId), getMarginY(compId) );
+  }
+
+  m_bIsBorderExtended = true;
+}
+
+
+Void TComPicYuv::xExtendPlane( Pel* piTxt, const Int stride, const Int width, const Int height, const Int marginX, const Int marginY )
+{
+  Pel*  pi = piTxt;
+  // do left and right margins
+  for (Int y = 0; y < height; y++)
+  {
+    for (Int x = 0; x < marginX; x++ )
     {
-      for (Int x = 0; x < marginX; x++ )
-      {
-        pi[ -marginX + x ] = pi[0];
-        pi[    width + x ] = pi[width-1];
-      }
-      pi += stride;
+      pi[ -marginX + x ] = pi[0];
+      pi[    width + x ] = pi[width-1];
+    }
+    pi += stride;
+  }
+
+  // pi is now the (0,height) (bottom left of image within bigger picture
+  pi -= (stride + marginX);
+  // pi is now the (-marginX, height-1)
+  for (Int y = 0; y < marginY; y++ )
+  {
+    ::memcpy( pi + (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+  }
+
+  // pi is still (-marginX, height-1)
+  pi -= ((height-1) * stride);
+  // pi is now (-marginX, 0)
+  for (Int y = 0; y < marginY; y++ )
+  {
+    ::memcpy( pi - (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+  }
+}
+
+
+#if NH_MV_PYRAMID_ME
+/** Build the downsampled luma planes of the pyramid motion search.
+ *  Each level is the 2x2 average of the level above; margins are padded as for the full resolution plane.
+ *  Nothing is done when the planes are up to date, the flag is cleared with the border extension flag.
+ */
+Void TComPicYuv::buildPyramid()
+{
+  if ( m_bIsPyramidBuilt )
+  {
+    return;
+  }
+
+  const Pel* piSrc     = getAddr  ( COMPONENT_Y );
+  Int        iSrcStride = getStride( COMPONENT_Y );
+
+  for( Int level = 0; level < NUM_ME_PYRAMID_LEVELS; level++ )
+  {
+    const Int iStride  = getPyramidStride( level );
+    const Int iWidth   = getPyramidWidth ( level );
+    const Int iHeight  = getPyramidHeight( level );
+    const Int iMarginX = m_marginX >> ( level + 1 );
+    const Int iMarginY = m_marginY >> ( level + 1 );
+
+    if ( m_apiPyramidBuf[level] == NULL )
+    {
+      m_apiPyramidBuf[level] = (Pel*)xMalloc( Pel, iStride * ( iHeight + ( iMarginY << 1 ) ) );
+      m_apiPyramidOrg[level] = m_apiPyramidBuf[level] + iMarginY * iStride + iMarginX;
     }
 
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (stride + marginX);
-    // pi is now the (-marginX, height-1)
-    for (Int y = 0; y < marginY; y++ )
+    Pel* piDst = m_apiPyramidOrg[level];
+    for( Int y = 0; y < iHeight; y++ )
     {
-      ::memcpy( pi + (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      const Pel* piSrc0 = piSrc + ( y << 1 ) * iSrcStride;
+      const Pel* piSrc1 = piSrc0 + iSrcStride;
+      for( Int x = 0; x < iWidth; x++ )
+      {
+        piDst[x] = ( piSrc0[2*x] + piSrc0[2*x+1] + piSrc1[2*x] + piSrc1[2*x+1] + 2 ) >> 2;
+      }
+      piDst += iStride;
     }
+    xExtendPlane( m_apiPyramidOrg[level], iStride, iWidth, iHeight, iMarginX, iMarginY );
+
+    piSrc      = m_apiPyramidOrg[level];
+    iSrcStride = iStride;
+  }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((height-1) * stride);
-    // pi is now (-marginX, 0)
-    for (Int y = 0; y < marginY; y++ )
+  m_bIsPyramidBuilt = true;
+}
+#endif
+
+#if NH_MV_SUBPEL_PLANE_CACHE
+/** Interpolate the luma plane at all 15 fractional positions.
+ *  The planes are computed with the same horizontal then vertical filter passes as the block wise
+ *  interpolation of the motion search, so that the samples read from them are identical.
+ *  The outermost NTAPS_LUMA/2 samples of the margin are not filled, motion vectors never reach them.
+ * \param bitDepth luma bit depth
+ */
+Void TComPicYuv::buildSubPelPlanes( const Int bitDepth )
+{
+  if ( m_bIsSubPelBuilt )
+  {
+    return;
+  }
+
+  const Int          iStride        = getStride( COMPONENT_Y );
+  const Int          iBufSize       = iStride * ( m_picHeight + ( m_marginY << 1 ) );
+  const Int          iOrgOffset     = m_marginY * iStride + m_marginX;
+  const Int          iHalfFilterSize = NTAPS_LUMA >> 1;
+  const ChromaFormat chFmt          = getChromaFormat();
+  TComInterpolationFilter cFilter;
+
+  // horizontally filtered intermediate, covering all rows
+  Pel* piTmpBuf = (Pel*)xMalloc( Pel, iBufSize );
+  Pel* piTmpOrg = piTmpBuf + iOrgOffset;
+
+  m_apiSubPelOrg[0][0] = getAddr( COMPONENT_Y );
+
+  for( Int fracX = 0; fracX < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; fracX++ )
+  {
+    cFilter.filterHor( COMPONENT_Y, getAddr( COMPONENT_Y ) - m_marginY * iStride - m_marginX + iHalfFilterSize, iStride,
+                       piTmpOrg - m_marginY * iStride - m_marginX + iHalfFilterSize, iStride,
+                       m_picWidth + ( ( m_marginX - iHalfFilterSize ) << 1 ), m_picHeight + ( m_marginY << 1 ), fracX, false, chFmt, bitDepth );
+
+    for( Int fracY = 0; fracY < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; fracY++ )
     {
-      ::memcpy( pi - (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      if ( fracX == 0 && fracY == 0 )
+      {
+        continue;
+      }
+      if ( m_apiSubPelBuf[fracY][fracX] == NULL )
+      {
+        m_apiSubPelBuf[fracY][fracX] = (Pel*)xMalloc( Pel, iBufSize );
+        m_apiSubPelOrg[fracY][fracX] = m_apiSubPelBuf[fracY][fracX] + iOrgOffset;
+      }
+      const Int iStartOffset = ( iHalfFilterSize - m_marginY ) * iStride + iHalfFilterSize - m_marginX;
+      cFilter.filterVer( COMPONENT_Y, piTmpOrg + iStartOffset, iStride, m_apiSubPelOrg[fracY][fracX] + iStartOffset, iStride,
+                         m_picWidth + ( ( m_marginX - iHalfFilterSize ) << 1 ), m_picHeight + ( ( m_marginY - iHalfFilterSize ) << 1 ), fracY, false, true, chFmt, bitDepth );
     }
   }
 
-  m_bIsBorderExtended = true;
+  xFree( piTmpBuf );
+  m_bIsSubPelBuilt = true;
 }
+#endif
 
 
 
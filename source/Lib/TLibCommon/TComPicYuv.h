@@ -79,6 +79,16 @@ private:
   Int   m_marginY;                                  ///< margin of Luma channel (chroma's may be smaller, depending on ratio)
 
   Bool  m_bIsBorderExtended;
+#if NH_MV_PYRAMID_ME
+  Pel*  m_apiPyramidBuf[NUM_ME_PYRAMID_LEVELS];     ///< luma at 1/2 and 1/4 resolution (including margin)
+  Pel*  m_apiPyramidOrg[NUM_ME_PYRAMID_LEVELS];     ///< top left sample of the picture in m_apiPyramidBuf
+  Bool  m_bIsPyramidBuilt;                          ///< reset together with the border extension whenever the picture changes
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  Pel*  m_apiSubPelBuf[LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS]; ///< luma interpolated at [fracY][fracX] (including margin), [0][0] is unused
+  Pel*  m_apiSubPelOrg[LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS]; ///< top left sample of the picture in m_apiSubPelBuf, [0][0] is the luma plane itself
+  Bool  m_bIsSubPelBuilt;                           ///< reset together with the border extension whenever the picture changes
+#endif
 #if NH_3D_IV_MERGE
   Int   m_iBaseUnitWidth;       ///< Width of Base Unit (with maximum depth or minimum size, m_iCuWidth >> Max. Depth)
   Int   m_iBaseUnitHeight;      ///< Height of Base Unit (with maximum depth or minimum size, m_iCuHeight >> Max. Depth)
@@ -90,6 +100,7 @@ private:
 #if NH_3D_VSO
   Void  xSetPels( Pel* piPelSource , Int iSourceStride, Int iWidth, Int iHeight, Pel iVal );
 #endif
+  static Void xExtendPlane( Pel* piTxt, const Int stride, const Int width, const Int height, const Int marginX, const Int marginY );
 
 public:
                TComPicYuv         ();
@@ -178,10 +189,31 @@ public:
   Void          dump              (const std::string &fileName, const BitDepths &bitDepths, const Bool bAppend=false, const Bool bForceTo8Bit=false) const ;
 
   // Set border extension flag
+#if NH_MV_PYRAMID_ME && NH_MV_SUBPEL_PLANE_CACHE
+  Void          setBorderExtension(Bool b) { m_bIsBorderExtended = b; m_bIsPyramidBuilt = m_bIsPyramidBuilt && b; m_bIsSubPelBuilt = m_bIsSubPelBuilt && b; }
+#elif NH_MV_PYRAMID_ME
+  Void          setBorderExtension(Bool b) { m_bIsBorderExtended = b; m_bIsPyramidBuilt = m_bIsPyramidBuilt && b; }
+#else
   Void          setBorderExtension(Bool b) { m_bIsBorderExtended = b; }
+#endif
 #if NH_MV
   Bool          getBorderExtension( )     { return m_bIsBorderExtended; }
 #endif
+#if NH_MV_PYRAMID_ME
+  // Downsampled luma planes for the coarse stages of the pyramid motion search, level 0 is 1/2 and level 1 is 1/4 resolution
+  Void          buildPyramid      ();
+  Bool          getPyramidBuilt   ()                     const { return m_bIsPyramidBuilt; }
+  const Pel*    getPyramidAddr    (const Int level)      const { return m_apiPyramidOrg[level]; }
+  Int           getPyramidStride  (const Int level)      const { return getStride(COMPONENT_Y) >> (level+1); }
+  Int           getPyramidWidth   (const Int level)      const { return m_picWidth  >> (level+1); }
+  Int           getPyramidHeight  (const Int level)      const { return m_picHeight >> (level+1); }
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  // Luma interpolated at all quarter sample positions, the planes have the stride and margin of the luma plane
+  Void          buildSubPelPlanes (const Int bitDepth);
+  Bool          getSubPelBuilt    ()                               const { return m_bIsSubPelBuilt; }
+  const Pel*    getSubPelAddr     (const Int fracY, const Int fracX) const { return m_apiSubPelOrg[fracY][fracX]; }
+#endif
 #if NH_3D_VSO
   // Set Function 
   Void  setLumaTo    ( Pel pVal );  
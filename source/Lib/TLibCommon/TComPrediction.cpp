@@ -125,6 +125,9 @@ Void TComPrediction::destroy()
 #if NH_3D_ARP
   m_acYuvPredBase[0].destroy();
   m_acYuvPredBase[1].destroy();
+#endif
+#if NH_3D_SCRATCH_ARENA
+  m_cScratchArena.destroy();
 #endif
   if( m_pLumaRecBuffer )
   {
@@ -188,6 +191,10 @@ Void TComPrediction::initTempBuff(ChromaFormat chromaFormatIDC)
 #if NH_3D_VSP
     m_cYuvDepthOnVsp.create( MAX_CU_SIZE, MAX_CU_SIZE, chromaFormatIDC );
 #endif
+#if NH_3D_SCRATCH_ARENA
+    // covers a sub-PU motion field of one CTU plus a few CTU sized sample and pattern buffers
+    m_cScratchArena.create( MAX_NUM_PART_IDXS_IN_CTU_WIDTH*MAX_NUM_PART_IDXS_IN_CTU_WIDTH*( 2*sizeof(TComMvField) + sizeof(UChar) ) + 4*MAX_CU_SIZE*MAX_CU_SIZE*sizeof(Pel) );
+#endif
 
   }
 
@@ -517,7 +524,12 @@ Void TComPrediction::predIntraLumaDmm( TComDataCU* pcCU, UInt uiAbsPartIdx, DmmI
 #endif
 
   // get partition
+#if NH_3D_SCRATCH_ARENA
+  TComArenaScope cArenaScope( m_cScratchArena );
+  Bool* biSegPattern  = m_cScratchArena.alloc<Bool>( (UInt)(iWidth*iHeight) );
+#else
   Bool* biSegPattern  = new Bool[ (UInt)(iWidth*iHeight) ];
+#endif
   UInt  patternStride = (UInt)iWidth;
   switch( dmmType )
   {
@@ -545,8 +557,10 @@ Void TComPrediction::predIntraLumaDmm( TComDataCU* pcCU, UInt uiAbsPartIdx, DmmI
   // set prediction signal
   Pel* pDst = piPred;
   assignBiSegDCs( pDst, uiStride, biSegPattern, patternStride, segDC1, segDC2 );
+#if !NH_3D_SCRATCH_ARENA
   
   delete[] biSegPattern;
+#endif
 }
 #endif
 
@@ -1504,17 +1518,28 @@ Bool TComPrediction::xCheckBiInterviewARP( TComDataCU* pcCU, UInt uiPartAddr, In
   Int uiLCUAddr,uiAbsPartAddr;
   pcPicYuvBaseCol->getCUAddrAndPartIdx( irefPUX, irefPUY, uiLCUAddr, uiAbsPartAddr);
   TComDataCU *pColCU = pcPicYuvBaseCol->getCtu( uiLCUAddr );
+#if NH_3D_REF_MOTION_STORE
+  const RefMotionUnit& rcColUnit = pcPicYuvBaseCol->getPicSym()->getRefMotionStore().getUnit( uiLCUAddr, uiAbsPartAddr );
+#endif
 
   TComPic* pcPicYuvBaseTRef = NULL;
   pcPicYuvCurrTRef = NULL;
 
   //If there is available motion in base reference list, use it
+#if NH_3D_REF_MOTION_STORE
+  if(rcColUnit.m_ePredMode != MODE_INTRA)
+#else
   if(!pColCU->isIntra(uiAbsPartAddr))
+#endif
   {
     for(Int iList = 0; iList < (pColCU->getSlice()->isInterB() ? 2: 1); iList ++)
     {
       RefPicList eRefPicListCurr = RefPicList(iList);
+#if NH_3D_REF_MOTION_STORE
+      Int iRef = rcColUnit.m_aiRefIdx[eRefPicListCurr];
+#else
       Int iRef = pColCU->getCUMvField(eRefPicListCurr)->getRefIdx(uiAbsPartAddr);
+#endif
       if( iRef != -1)
       {
         pcPicYuvBaseTRef = pColCU->getSlice()->getRefPic(eRefPicListCurr, iRef);  
@@ -1529,7 +1554,11 @@ Bool TComPrediction::xCheckBiInterviewARP( TComDataCU* pcCU, UInt uiPartAddr, In
           pcPicYuvBaseTRef =  pcCU->getSlice()->getBaseViewRefPic(iTargetPOC,  pcPicYuvBaseCol->getViewIndex() );  
           if(pcPicYuvBaseTRef)
           {
+#if NH_3D_REF_MOTION_STORE
+            cBaseTMV = rcColUnit.m_acMv[eRefPicListCurr];
+#else
             cBaseTMV = pColCU->getCUMvField(eRefPicListCurr)->getMv(uiAbsPartAddr);
+#endif
             Int iScale = pcCU-> xGetDistScaleFactor(iCurrPOC, iTargetPOC, iCurrPOC, iCurrRefPOC);
             if ( iScale != 4096 )
             {
@@ -1581,6 +1610,9 @@ Void TComPrediction::xPredInterUniARPviewRef( TComDataCU* pcCU, UInt uiPartAddr,
   Int uiLCUAddr,uiAbsPartAddr;
   pcPicYuvBaseCol->getCUAddrAndPartIdx( irefPUX, irefPUY, uiLCUAddr, uiAbsPartAddr);
   TComDataCU *pColCU = pcPicYuvBaseCol->getCtu( uiLCUAddr );
+#if NH_3D_REF_MOTION_STORE
+  const RefMotionUnit& rcColUnit = pcPicYuvBaseCol->getPicSym()->getRefMotionStore().getUnit( uiLCUAddr, uiAbsPartAddr );
+#endif
   if( pcCU->getSlice()->isInterB() && !pcCU->getSlice()->getIsDepth() )
   {
     RefPicList eOtherRefList = ( eRefPicList == REF_PIC_LIST_0 ) ? REF_PIC_LIST_1 : REF_PIC_LIST_0;
@@ -1644,13 +1676,21 @@ Void TComPrediction::xPredInterUniARPviewRef( TComDataCU* pcCU, UInt uiPartAddr,
     }
   }
 
+#if NH_3D_REF_MOTION_STORE
+  if( rcColUnit.m_ePredMode != MODE_INTRA && !bTMVAvai )
+#else
   if( !pColCU->isIntra( uiAbsPartAddr ) && !bTMVAvai )
+#endif
   {
     TComMvField puMVField;
     for(Int iList = 0; iList < (pColCU->getSlice()->isInterB() ? 2: 1) && !bTMVAvai; iList ++)
     {
       RefPicList eRefPicListCurr = RefPicList(iList);
+#if NH_3D_REF_MOTION_STORE
+      Int iRef = rcColUnit.m_aiRefIdx[eRefPicListCurr];
+#else
       Int iRef = pColCU->getCUMvField(eRefPicListCurr)->getRefIdx(uiAbsPartAddr);
+#endif
       if( iRef != -1 && pcCU->getSlice()->getArpRefPicAvailable( eRefPicListCurr, pcPicYuvBaseCol->getViewIndex()))
       {
         pcPicYuvBaseTRef = pColCU->getSlice()->getRefPic(eRefPicListCurr, iRef);  
@@ -1665,7 +1705,11 @@ Void TComPrediction::xPredInterUniARPviewRef( TComDataCU* pcCU, UInt uiPartAddr,
             pcPicYuvBaseTRef =  pcCU->getSlice()->getBaseViewRefPic(iTargetPOC,  pcPicYuvBaseCol->getViewIndex() );  
             if(pcPicYuvBaseTRef)
             {
+#if NH_3D_REF_MOTION_STORE
+              cBaseTMV = rcColUnit.m_acMv[eRefPicListCurr];
+#else
               cBaseTMV = pColCU->getCUMvField(eRefPicListCurr)->getMv(uiAbsPartAddr);
+#endif
               Int iScale = pcCU-> xGetDistScaleFactor(iCurrPOC, iTargetPOC, iCurrPOC, iCurrRefPOC);
               if ( iScale != 4096 )
                 cBaseTMV = cBaseTMV.scaleMv( iScale );                  
@@ -2267,10 +2311,16 @@ Void TComPrediction::predConstantSDC( Pel* ptrSrc, UInt srcStride, UInt uiSize,
 Void TComPrediction::predContourFromTex( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiWidth, UInt uiHeight, Bool* segPattern )
 {
   // get copy of co-located texture luma block
+#if NH_3D_SCRATCH_ARENA
+  TComArenaScope cArenaScope( m_cScratchArena );
+  Pel* piTempBlkY = m_cScratchArena.alloc<Pel>( uiWidth*uiHeight );
+  Pel* piRefBlkY  = piTempBlkY;
+#else
   TComYuv cTempYuv;
   cTempYuv.create( uiWidth, uiHeight, CHROMA_400 ); 
   cTempYuv.clear();
   Pel* piRefBlkY = cTempYuv.getAddr( COMPONENT_Y );
+#endif
   TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getTexturePic()->getPicYuvRec();
   assert( pcPicYuvRef != NULL );
   Int  iRefStride = pcPicYuvRef->getStride( COMPONENT_Y );
@@ -2285,7 +2335,11 @@ Void TComPrediction::predContourFromTex( TComDataCU* pcCU, UInt uiAbsPartIdx, UI
 
 
   // find contour for texture luma block
+#if NH_3D_SCRATCH_ARENA
+  piRefBlkY = piTempBlkY;
+#else
   piRefBlkY = cTempYuv.getAddr( COMPONENT_Y );
+#endif
   UInt iDC = 0;
   iDC  = piRefBlkY[ 0 ];
   iDC += piRefBlkY[ uiWidth - 1 ];
@@ -2293,13 +2347,19 @@ Void TComPrediction::predContourFromTex( TComDataCU* pcCU, UInt uiAbsPartIdx, UI
   iDC += piRefBlkY[ uiWidth * (uiHeight - 1) + uiWidth - 1 ];
   iDC = iDC >> 2;
 
+#if NH_3D_SCRATCH_ARENA
+  piRefBlkY = piTempBlkY;
+#else
   piRefBlkY = cTempYuv.getAddr( COMPONENT_Y );
+#endif
   for( UInt k = 0; k < (uiWidth*uiHeight); k++ ) 
   { 
     segPattern[k] = (piRefBlkY[k] > iDC) ? true : false;
   }
+#if !NH_3D_SCRATCH_ARENA
 
   cTempYuv.destroy();
+#endif
 }
 
 Void TComPrediction::predBiSegDCs( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiWidth, UInt uiHeight, Bool* biSegPattern, Int patternStride, Pel& predDC1, Pel& predDC2 )
@@ -47,6 +47,9 @@
 #if NH_3D_ARP
 #include "TComPic.h"
 #endif
+#if NH_3D_SCRATCH_ARENA
+#include "TComArena.h"
+#endif
 // forward declaration
 class TComMv;
 class TComTU; 
@@ -96,6 +99,9 @@ protected:
 #if NH_3D_VSP
   Int*    m_pDepthBlock;         ///< Store a depth block, local variable, to prevent memory allocation every time
   TComYuv m_cYuvDepthOnVsp;
+#endif
+#if NH_3D_SCRATCH_ARENA
+  TComArena m_cScratchArena;     ///< temporary buffers (patterns, masks, sub-PU fields), released per call, reset per CTU
 #endif
   Void xPredIntraAng            ( Int bitDepth, const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, UInt width, UInt height, ChannelType channelType, UInt dirMode, const Bool bEnableEdgeFilters );
   Void xPredIntraPlanar         ( const Pel* pSrc, Int srcStride, Pel* rpDst, Int dstStride, UInt width, UInt height );
@@ -152,6 +158,9 @@ public:
   Void    initTempBuff(ChromaFormat chromaFormatIDC);
 
   ChromaFormat getChromaFormat() const { return m_cYuvPredTemp.getChromaFormat(); }
+#if NH_3D_SCRATCH_ARENA
+  TComArena&   getScratchArena()       { return m_cScratchArena; }
+#endif
 
   // inter
   Void motionCompensation         ( TComDataCU*  pcCU, TComYuv* pcYuvPred, RefPicList eRefPicList = REF_PIC_LIST_X, Int iPartIdx = -1 );
@@ -145,9 +145,11 @@ TComSlice::TComSlice()
 #if NH_3D
 , m_inCmpPredFlag                 (false)
 , m_numViews                      (0)
+#if !NH_3D_SHARED_DISPARITY_LUT
 , m_depthToDisparityB             (NULL)
 , m_depthToDisparityF             (NULL)
 #endif
+#endif
 #if NH_3D_DIS
 , m_bApplyDIS                     (false)
 #endif
@@ -241,7 +243,13 @@ TComSlice::TComSlice()
 
 TComSlice::~TComSlice()
 {
-#if NH_3D
+#if NH_3D_SHARED_DISPARITY_LUT
+  for( UInt i = 0; i < m_depthToDisparityLut.size(); i++ )
+  {
+    TComDisparityLut::release( m_depthToDisparityLut[ i ] );
+  }
+  m_depthToDisparityLut.clear();
+#elif NH_3D
   for( UInt i = 0; i < m_numViews; i++ )
   {
     if ( m_depthToDisparityB && m_depthToDisparityB[ i ] )
@@ -599,8 +607,13 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
   }
 }
 #else
+#if NH_MV_DPB_POC_INDEX
+Void TComSlice::getTempRefPicLists( TComSubDpb& rcListPic, std::vector<TComPic*>& refPicSetInterLayer0, std::vector<TComPic*>& refPicSetInterLayer1,                                     
+                                   std::vector<TComPic*> rpsCurrList[2], std::vector<Bool> usedAsLongTerm[2], Int& numPocTotalCurr, Bool checkNumPocTotalCurr )
+#else
 Void TComSlice::getTempRefPicLists( TComList<TComPic*>& rcListPic, std::vector<TComPic*>& refPicSetInterLayer0, std::vector<TComPic*>& refPicSetInterLayer1,                                     
                                    std::vector<TComPic*> rpsCurrList[2], std::vector<Bool> usedAsLongTerm[2], Int& numPocTotalCurr, Bool checkNumPocTotalCurr )
+#endif
 {
   if (!checkNumPocTotalCurr)
   {
@@ -625,7 +638,11 @@ Void TComSlice::getTempRefPicLists( TComList<TComPic*>& rcListPic, std::vector<T
   {
     if(m_pRPS->getUsed(i))
     {
+#if NH_MV_DPB_POC_INDEX
+      pcRefPic = rcListPic.getPic( getPOC()+m_pRPS->getDeltaPOC(i) );
+#else
       pcRefPic = xGetRefPic(rcListPic, getPOC()+m_pRPS->getDeltaPOC(i));
+#endif
       pcRefPic->setIsLongTerm(0);
       pcRefPic->getPicYuvRec()->extendPicBorder();
       RefPicSetStCurr0[NumPocStCurr0] = pcRefPic;
@@ -641,7 +658,11 @@ Void TComSlice::getTempRefPicLists( TComList<TComPic*>& rcListPic, std::vector<T
   {
     if(m_pRPS->getUsed(i))
     {
+#if NH_MV_DPB_POC_INDEX
+      pcRefPic = rcListPic.getPic( getPOC()+m_pRPS->getDeltaPOC(i) );
+#else
       pcRefPic = xGetRefPic(rcListPic, getPOC()+m_pRPS->getDeltaPOC(i));
+#endif
       pcRefPic->setIsLongTerm(0);
       pcRefPic->getPicYuvRec()->extendPicBorder();
       RefPicSetStCurr1[NumPocStCurr1] = pcRefPic;
@@ -3638,6 +3659,13 @@ Void TComSlice::setDefaultRefView()
 #endif
 
 #if NH_3D_ARP
+#if NH_MV_DPB_POC_INDEX
+TComPic* TComSlice::getBaseViewRefPic( UInt uiPOC , Int iViewIdx )
+{
+  return m_pBaseViewRefPicList[iViewIdx]->getPic( uiPOC );
+}
+
+#endif
 Void TComSlice::setARPStepNum( TComPicLists*ivPicLists )
 {
   Bool tempRefPicInListsFlag = false;
@@ -3895,6 +3923,47 @@ Void TComSlice::setDepthToDisparityLUTs()
   }
 
   m_numViews = getVPS()->getNumViews(); 
+#if NH_3D_SHARED_DISPARITY_LUT
+  if ( m_depthToDisparityLut.size() < m_numViews )
+  {
+    m_depthToDisparityLut.resize( m_numViews, NULL );
+  }
+
+  const TComVPS* vps = getVPS(); 
+
+  Int log2Div = bitDepthY - 1 + vps->getCpPrecision();
+  Int voiInVps = vps->getVoiInVps( getViewIndex() ); 
+  Bool camParaSH = vps->getCpInSliceSegmentHeaderFlag( voiInVps );  
+
+  const IntAry1d& codScale     = camParaSH ? m_aaiCodedScale [ 0 ] : vps->getCodedScale    ( voiInVps ); 
+  const IntAry1d& codOffset    = camParaSH ? m_aaiCodedOffset[ 0 ] : vps->getCodedOffset   ( voiInVps ); 
+  const IntAry1d& invCodScale  = camParaSH ? m_aaiCodedScale [ 1 ] : vps->getInvCodedScale ( voiInVps ); 
+  const IntAry1d& invCodOffset = camParaSH ? m_aaiCodedOffset[ 1 ] : vps->getInvCodedOffset( voiInVps ); 
+
+  for (Int i = 0; i < voiInVps; i++)
+  {
+    Int iInVoi = vps->getVoiInVps( i ); 
+#if ENC_DEC_TRACE && NH_MV_ENC_DEC_TRAC
+    if ( g_traceCameraParameters )
+    {
+      std::cout << "Cp: " << codScale   [ iInVoi ] << " " <<    codOffset[ iInVoi ] << " "
+                << invCodScale[ iInVoi ] << " " << invCodOffset[ iInVoi ] << " " << log2Div << std::endl ; 
+    }
+#endif
+    TComDisparityLut::Param cParam;
+    cParam.m_iCodedScale     = codScale    [ iInVoi ];
+    cParam.m_iCodedOffset    = codOffset   [ iInVoi ];
+    cParam.m_iInvCodedScale  = invCodScale [ iInVoi ];
+    cParam.m_iInvCodedOffset = invCodOffset[ iInVoi ];
+    cParam.m_iLog2Div        = log2Div;
+    cParam.m_iBitDepthY      = bitDepthY;
+
+    // acquire before release, so that unchanged parameters keep their table
+    const TComDisparityLut* pcLut = TComDisparityLut::acquire( cParam );
+    TComDisparityLut::release( m_depthToDisparityLut[ iInVoi ] );
+    m_depthToDisparityLut[ iInVoi ] = pcLut;
+  }
+#else
   /// GT: Allocation should be moved to a better place later; 
   if ( m_depthToDisparityB == NULL )
   {
@@ -3949,6 +4018,84 @@ Void TComSlice::setDepthToDisparityLUTs()
       m_depthToDisparityF[ iInVoi ][ d ] = ( invCodScale[ iInVoi ] * d + invOffset ) >> log2Div; 
     }
   }
+#endif
+}
+#endif
+
+#if NH_3D_SHARED_DISPARITY_LUT
+TComDisparityLut::LutMap TComDisparityLut::m_cLutMap;
+
+Bool TComDisparityLut::Param::operator< ( const Param& rcOther ) const
+{
+  if ( m_iCodedScale     != rcOther.m_iCodedScale     ) return m_iCodedScale     < rcOther.m_iCodedScale;
+  if ( m_iCodedOffset    != rcOther.m_iCodedOffset    ) return m_iCodedOffset    < rcOther.m_iCodedOffset;
+  if ( m_iInvCodedScale  != rcOther.m_iInvCodedScale  ) return m_iInvCodedScale  < rcOther.m_iInvCodedScale;
+  if ( m_iInvCodedOffset != rcOther.m_iInvCodedOffset ) return m_iInvCodedOffset < rcOther.m_iInvCodedOffset;
+  if ( m_iLog2Div        != rcOther.m_iLog2Div        ) return m_iLog2Div        < rcOther.m_iLog2Div;
+  return m_iBitDepthY < rcOther.m_iBitDepthY;
+}
+
+TComDisparityLut::TComDisparityLut( const Param& rcParam )
+: m_cParam   ( rcParam )
+, m_iRefCount( 0 )
+{
+  const Int iNumValues = 1 << m_cParam.m_iBitDepthY;
+  const Int log2Div    = m_cParam.m_iLog2Div;
+  const Int bitDepthY  = m_cParam.m_iBitDepthY;
+
+  m_piDepthToDisparityB = new Int[ iNumValues ];
+  m_piDepthToDisparityF = new Int[ iNumValues ];
+
+  Int offset    = ( m_cParam.m_iCodedOffset    << bitDepthY ) + ( ( 1 << log2Div ) >> 1 );
+  Int invOffset = ( m_cParam.m_iInvCodedOffset << bitDepthY ) + ( ( 1 << log2Div ) >> 1 );
+  for ( Int d = 0; d < iNumValues; d++ )
+  {
+    m_piDepthToDisparityB[ d ] = ( m_cParam.m_iCodedScale    * d + offset    ) >> log2Div;
+    m_piDepthToDisparityF[ d ] = ( m_cParam.m_iInvCodedScale * d + invOffset ) >> log2Div;
+  }
+}
+
+TComDisparityLut::~TComDisparityLut()
+{
+  delete[] m_piDepthToDisparityB;
+  delete[] m_piDepthToDisparityF;
+}
+
+/** Get the LUTs for a set of camera parameters, computing them only if no slice is using them yet
+ * \param rcParam camera parameters, precision and bit depth
+ * \returns shared LUTs, to be given back with release()
+ */
+const TComDisparityLut* TComDisparityLut::acquire( const Param& rcParam )
+{
+  LutMap::iterator it = m_cLutMap.find( rcParam );
+  TComDisparityLut* pcLut;
+  if ( it == m_cLutMap.end() )
+  {
+    pcLut = new TComDisparityLut( rcParam );
+    m_cLutMap[ rcParam ] = pcLut;
+  }
+  else
+  {
+    pcLut = it->second;
+  }
+  pcLut->m_iRefCount++;
+  return pcLut;
+}
+
+Void TComDisparityLut::release( const TComDisparityLut* pcLut )
+{
+  if ( pcLut == NULL )
+  {
+    return;
+  }
+  LutMap::iterator it = m_cLutMap.find( pcLut->m_cParam );
+  assert( it != m_cLutMap.end() && it->second == pcLut );
+  TComDisparityLut* pcEntry = it->second;
+  if ( --pcEntry->m_iRefCount == 0 )
+  {
+    m_cLutMap.erase( it );
+    delete pcEntry;
+  }
 }
 #endif
 
@@ -54,6 +54,9 @@ class TComTrQuant;
 #if NH_MV
 class TComDecodedRps;
 class TComPicLists; 
+#if NH_MV_DPB_POC_INDEX
+class TComSubDpb;
+#endif
 class TComVPS; 
 class TComSPS; 
 #endif
@@ -2574,6 +2577,45 @@ struct WPACDCParam
   Int64 iDC;
 };
 
+#if NH_3D_SHARED_DISPARITY_LUT
+/// depth to disparity look-up tables of one view pair, shared by all slices with identical camera parameters
+class TComDisparityLut
+{
+public:
+  struct Param
+  {
+    Int m_iCodedScale;
+    Int m_iCodedOffset;
+    Int m_iInvCodedScale;
+    Int m_iInvCodedOffset;
+    Int m_iLog2Div;
+    Int m_iBitDepthY;
+
+    Bool operator< ( const Param& rcOther ) const;
+  };
+
+private:
+  typedef std::map<Param, TComDisparityLut*> LutMap;
+
+  Param          m_cParam;
+  Int            m_iRefCount;
+  Int*           m_piDepthToDisparityB;
+  Int*           m_piDepthToDisparityF;
+
+  static LutMap  m_cLutMap;                ///< all LUTs currently referenced by a slice
+
+  TComDisparityLut( const Param& rcParam );
+  ~TComDisparityLut();
+
+public:
+  static const TComDisparityLut* acquire( const Param& rcParam );
+  static Void                    release( const TComDisparityLut* pcLut );
+
+  const Int*     getDepthToDisparityB() const { return m_piDepthToDisparityB; }
+  const Int*     getDepthToDisparityF() const { return m_piDepthToDisparityF; }
+};
+#endif
+
 /// slice header class
 class TComSlice
 {
@@ -2735,7 +2777,11 @@ private:
 #endif
 #if NH_3D_ARP
   Bool       m_arpRefPicAvailable[2][MAX_NUM_LAYERS];
+#if NH_MV_DPB_POC_INDEX
+  TComSubDpb*          m_pBaseViewRefPicList[MAX_NUM_LAYERS];
+#else
   TComList<TComPic*> * m_pBaseViewRefPicList[MAX_NUM_LAYERS];
+#endif
   UInt        m_nARPStepNum; 
   Int         m_aiFirstTRefIdx    [2];   
 #endif
@@ -2757,8 +2803,12 @@ private:
   TComPic*   m_ivPicsCurrPoc [2][MAX_NUM_LAYERS];  
 #endif
 #if NH_3D
+#if NH_3D_SHARED_DISPARITY_LUT
+  std::vector<const TComDisparityLut*> m_depthToDisparityLut;
+#else
   Int**      m_depthToDisparityB; 
   Int**      m_depthToDisparityF; 
+#endif
   Bool       m_bApplyDIS;
 #endif
 #endif
@@ -2868,11 +2918,19 @@ public:
   Bool                        getIcSkipParseFlag()                                   { return m_icSkipParseFlag;                                     }
 #endif                                                                                                                                               
 #if NH_3D_ARP                                                                                                                                         
+#if NH_MV_DPB_POC_INDEX
+  Void                        setBaseViewRefPicList( TComSubDpb *pSubDpb, Int iViewIdx )               { m_pBaseViewRefPicList[iViewIdx] = pSubDpb; }                  
+#else
   Void                        setBaseViewRefPicList( TComList<TComPic*> *pListPic, Int iViewIdx )      { m_pBaseViewRefPicList[iViewIdx] = pListPic; }                  
+#endif
   Void                        setARPStepNum( TComPicLists*ivPicLists );                                                                              
   Void                        setPocsInCurrRPSs( );
 
+#if NH_MV_DPB_POC_INDEX
+  TComPic*                    getBaseViewRefPic    ( UInt uiPOC , Int iViewIdx );
+#else
   TComPic*                    getBaseViewRefPic    ( UInt uiPOC , Int iViewIdx )     { return xGetRefPic( *m_pBaseViewRefPicList[iViewIdx], uiPOC ); }
+#endif
   UInt                        getARPStepNum( )                                       { return m_nARPStepNum;                                         }  
 #endif
   Int                         getDepth() const                                       { return m_iDepth;                                              }
@@ -2958,8 +3016,13 @@ public:
   Int                         getPocBeforeReset( )                                   { return m_iPOCBeforeReset;                                     }
   Int                         getRefLayerId( RefPicList e, Int iRefIdx)              { return  m_aiRefLayerIdList[e][iRefIdx];                       }
   Void                        setRefLayerId( Int i, RefPicList e, Int iRefIdx )      { m_aiRefLayerIdList[e][iRefIdx] = i;                        }
+#if NH_MV_DPB_POC_INDEX
+  Void                        getTempRefPicLists   ( TComSubDpb& rcSubDpb, std::vector<TComPic*>& refPicSetInterLayer0, std::vector<TComPic*>& refPicSetInterLayer1,                                     
+                                                     std::vector<TComPic*> rpsCurrList[2], BoolAry1d usedAsLongTerm[2], Int& numPocTotalCurr, Bool checkNumPocTotalCurr = false );
+#else
   Void                        getTempRefPicLists   ( TComList<TComPic*>& rcListPic, std::vector<TComPic*>& refPicSetInterLayer0, std::vector<TComPic*>& refPicSetInterLayer1,                                     
                                                      std::vector<TComPic*> rpsCurrList[2], BoolAry1d usedAsLongTerm[2], Int& numPocTotalCurr, Bool checkNumPocTotalCurr = false );
+#endif
                               
   Void                        setRefPicList        ( std::vector<TComPic*> rpsCurrList[2], BoolAry1d usedAsLongTerm[2], Int numPocTotalCurr, Bool checkNumPocTotalCurr = false ); 
 #else
@@ -3198,8 +3261,13 @@ public:
 #if NH_3D
   Void                        setDepthToDisparityLUTs();                                                                                                
                                                                                                                                                         
+#if NH_3D_SHARED_DISPARITY_LUT
+  const Int*                  getDepthToDisparityB( Int refViewIdx ) const           { return m_depthToDisparityLut[ getVPS()->getVoiInVps( refViewIdx) ]->getDepthToDisparityB(); }
+  const Int*                  getDepthToDisparityF( Int refViewIdx ) const           { return m_depthToDisparityLut[ getVPS()->getVoiInVps( refViewIdx) ]->getDepthToDisparityF(); }
+#else
   Int*                        getDepthToDisparityB( Int refViewIdx )                 { return m_depthToDisparityB[ getVPS()->getVoiInVps( refViewIdx) ];}
   Int*                        getDepthToDisparityF( Int refViewIdx )                 { return m_depthToDisparityF[ getVPS()->getVoiInVps( refViewIdx) ];}
+#endif
 #if NH_3D_IC                                                                                                                                             
   Void                        setICEnableCandidate( Int* icEnableCandidate)          { m_aICEnableCandidate = icEnableCandidate;                     }
   Void                        setICEnableNum( Int* icEnableNum)                      { m_aICEnableNum = icEnableNum;                                 }
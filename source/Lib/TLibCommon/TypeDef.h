@@ -84,6 +84,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////
 #if NH_MV
 #define NH_MV_ENC_DEC_TRAC                 1  //< CU/PU level tracking
+#define NH_MV_DPB_POC_INDEX                1  //< Sub-DPBs indexed by layer id and POC hash, replaces linear list searches in reference picture lookup
+#define NH_MV_PYRAMID_ME                   1  //< Encoder: coarse to fine integer motion search on 1/2 and 1/4 resolution luma planes of original and reference pictures
+#define NH_MV_SUBPEL_PLANE_CACHE           1  //< Encoder: fractional motion search reads from per picture interpolated luma planes instead of interpolating around each candidate
+#define NH_MV_PIC_ANALYSIS                 1  //< Encoder: per 8x8 block intra/inter Hadamard cost, moments and motion of each input picture, shared by rate control, adaptive QP and fast intra skipping
+#define NH_MV_RATE_POINT_ME_SEED           1  //< Encoder: motion of the same picture coded at the first rate point as integer ME start point of the additional rate points
 #if NH_3D
 #define NH_3D_INTEGER_MV_DEPTH            1
 #define NH_3D_ENC_DEPTH                   1   // Encoder optimizations for depth, incl.
@@ -272,6 +277,11 @@
 #define NH_3D_DIS                         1   // Depth intra skip
                                               // SEC_DEPTH_INTRA_SKIP_MODE_K0033  Depth intra skip mode
 #define H_3D_FCO                          0   // Flexible coding order for 3D
+#define NH_3D_SCRATCH_ARENA               1   // Per-instance bump allocator for temporary buffers of DMM, SDC, DBBP and sub-PU merge, reset per CTU
+#define NH_3D_REF_MOTION_STORE            1   // Compact 8x8/16x16 motion store of reconstructed pictures for TMVP, NBDV, inter-view and texture merge; full per-CU motion arrays are released once an access unit is finished
+#define NH_3D_SHARED_DISPARITY_LUT        1   // Depth to disparity LUTs cached by camera parameters and shared by all slices instead of being recomputed per slice
+#define NH_3D_IV_MOTION_SEED              1   // Encoder only: base view motion at the NBDV shifted position as start point and early termination candidate of dependent texture view ME
+#define NH_3D_TEX_GUIDED_MD               1   // Encoder only: edge and skip map of the finished texture picture, prunes DMM, DIS, intra NxN and intra in inter slices of the depth layer
 // OTHERS
                                               // MTK_SONY_PROGRESSIVE_MV_COMPRESSION_E0170 // Progressive MV Compression, JCT3V-E0170
                                               // MTK_FAST_TEXTURE_ENCODING_E0173
@@ -304,12 +314,14 @@
 #if NH_3D
 #define NH_3D_OUTPUT_ACTIVE_TOOLS               0
 #define NH_3D_REN_MAX_DEV_OUT                   0
+#define NH_3D_CAM_LUT_INCREMENTAL               1   // Camera shift LUTs held in contiguous blocks and only rebuilt for view pairs whose parameters changed
 #endif
 ///// ***** VIEW SYNTHESIS OPTIMIZAION *********
 #if NH_3D_VSO
 #define H_3D_VSO_DIST_INT                 1   // Allow negative synthesized view distortion change
 #define H_3D_VSO_COLOR_PLANES             1   // Compute VSO distortion on color planes
 #define H_3D_VSO_EARLY_SKIP               1   // LGE_VSO_EARLY_SKIP_A0093, A0093 modification 4
+#define H_3D_VSO_DIST_CACHE               1   // Reuse synthesized view distortion of blocks evaluated before with identical samples
 #define H_3D_VSO_RM_ASSERTIONS            0   // Output VSO assertions
 #define H_3D_VSO_SYNTH_DIST_OUT           0   // Output of synthesized view distortion instead of depth distortion in encoder output
 #endif
@@ -39,6 +39,7 @@
 
 #include <stdint.h>
 #include <cassert>
+#include <cstring>
 #include <vector>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -50,6 +51,113 @@ using namespace std;
 //! \ingroup TLibDecoder
 //! \{
 
+static const size_t ANNEXB_READ_BLOCK_SIZE = 1 << 20;
+
+Void InputByteStream::reset()
+{
+  std::streamoff position = m_Input.tellg();
+  m_BufferOffset   = ( position < 0 ) ? 0 : position;
+  m_KeepPos        = 0;
+  m_ReadPos        = 0;
+  m_DataEnd        = 0;
+  m_InputExhausted = false;
+  m_EndOfStream    = false;
+}
+
+/**
+ * Make at least n bytes available from the current position.
+ * Returns false if the end of the input is reached before.
+ */
+Bool InputByteStream::xFill(UInt n)
+{
+  while (m_DataEnd - m_ReadPos < n && !m_InputExhausted)
+  {
+    xReadBlock();
+  }
+  return m_DataEnd - m_ReadPos >= n;
+}
+
+/**
+ * Drop released bytes and append the next block of the input stream.
+ */
+Void InputByteStream::xReadBlock()
+{
+  if (m_KeepPos > 0)
+  {
+    memmove(&m_Buffer[0], &m_Buffer[m_KeepPos], m_DataEnd - m_KeepPos);
+    m_BufferOffset += std::streamoff(m_KeepPos);
+    m_ReadPos      -= m_KeepPos;
+    m_DataEnd      -= m_KeepPos;
+    m_KeepPos       = 0;
+  }
+  if (m_Buffer.size() < m_DataEnd + ANNEXB_READ_BLOCK_SIZE)
+  {
+    m_Buffer.resize(m_DataEnd + ANNEXB_READ_BLOCK_SIZE);
+  }
+
+  std::streamsize numRead = 0;
+  if (m_Input.good())
+  {
+    m_Input.read(reinterpret_cast<char*>(&m_Buffer[m_DataEnd]), std::streamsize(ANNEXB_READ_BLOCK_SIZE));
+    numRead = m_Input.gcount();
+  }
+  m_DataEnd       += size_t(numRead);
+  m_InputExhausted = ( numRead < std::streamsize(ANNEXB_READ_BLOCK_SIZE) );
+}
+
+const uint8_t* InputByteStream::readNalUnitBytes(UInt& numBytes)
+{
+  size_t start   = m_ReadPos;
+  size_t scanPos = m_ReadPos;
+
+  for (;;)
+  {
+    if (m_DataEnd - scanPos >= 3)
+    {
+      /* look for zero bytes only, a NAL unit ends at 0x00 00 0x with x <= 2 */
+      const uint8_t* base = &m_Buffer[0];
+      const uint8_t* last = base + m_DataEnd - 2;
+      const uint8_t* p    = base + scanPos;
+      while ((p = static_cast<const uint8_t*>(memchr(p, 0, last - p))) != NULL)
+      {
+        if (p[1] != 0)
+        {
+          p += 2;
+        }
+        else if (p[2] > 2)
+        {
+          p += 1;
+        }
+        else
+        {
+          m_ReadPos = p - base;
+          numBytes  = UInt(m_ReadPos - start);
+          return base + start;
+        }
+        if (p >= last)
+        {
+          break;
+        }
+      }
+      scanPos = m_DataEnd - 2;
+    }
+    if (m_InputExhausted)
+    {
+      break;
+    }
+    size_t shift = m_KeepPos;
+    xReadBlock();
+    start   -= shift;
+    scanPos -= shift;
+  }
+
+  /* the end of the stream terminates the NAL unit */
+  m_ReadPos     = m_DataEnd;
+  m_EndOfStream = true;
+  numBytes      = UInt(m_ReadPos - start);
+  return numBytes ? &m_Buffer[0] + start : NULL;
+}
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
@@ -61,7 +169,8 @@ using namespace std;
 static Void
 _byteStreamNALUnit(
   InputByteStream& bs,
-  vector<uint8_t>& nalUnit,
+  const uint8_t*& nalUnit,
+  UInt& nalUnitSize,
   AnnexBStats& stats)
 {
   /* At the beginning of the decoding process, the decoder initialises its
@@ -73,14 +182,14 @@ _byteStreamNALUnit(
    * 0x00000001.
    */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  TComCodingStatistics::SStat &statBits=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  UInt numPackingBytes=0; // counted for the layer of the NAL unit once its header is available
 #endif
   while ((bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) != 0x000001)
   &&     (bs.eofBeforeNBytes(32/8) || bs.peekBytes(32/8) != 0x00000001))
   {
     uint8_t leading_zero_8bits = bs.readByte();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    statBits.bits+=8; statBits.count++;
+    numPackingBytes++;
 #endif
     assert(leading_zero_8bits == 0);
     stats.m_numLeadingZero8BitsBytes++;
@@ -98,7 +207,7 @@ _byteStreamNALUnit(
   {
     uint8_t zero_byte = bs.readByte();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    statBits.bits+=8; statBits.count++;
+    numPackingBytes++;
 #endif
     assert(zero_byte == 0);
     stats.m_numZeroByteBytes++;
@@ -112,7 +221,7 @@ _byteStreamNALUnit(
   /* NB, (1) guarantees that the next three bytes are 0x00 00 01 */
   uint32_t start_code_prefix_one_3bytes = bs.readBytes(24/8);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  statBits.bits+=24; statBits.count+=3;
+  numPackingBytes+=3;
 #endif
   assert(start_code_prefix_one_3bytes == 0x000001);
   stats.m_numStartCodePrefixBytes += 3;
@@ -131,17 +240,22 @@ _byteStreamNALUnit(
    * decoded using the NAL unit decoding process
    */
   /* NB, (unsigned)x > 2 implies n!=0 && n!=1 */
+  nalUnit = bs.readNalUnitBytes(nalUnitSize);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
+  if (nalUnitSize >= 2)
+  {
+    // nuh_layer_id
+    TComCodingStatistics::SetCurrentLayer(((nalUnit[0] & 1) << 5) | (nalUnit[1] >> 3));
+  }
+  TComCodingStatistics::SStat &statBits=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  statBits.bits+=8*numPackingBytes; statBits.count+=numPackingBytes;
   TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+  bodyStats.bits+=8*nalUnitSize; bodyStats.count+=nalUnitSize;
 #endif
-  while (bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) > 2)
+  if (bs.eof())
   {
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    uint8_t thebyte=bs.readByte();bodyStats.bits+=8;bodyStats.count++;
-    nalUnit.push_back(thebyte);
-#else
-    nalUnit.push_back(bs.readByte());
-#endif
+    /* the NAL unit is terminated by the end of the byte stream */
+    return;
   }
 
   /* 5. When the current position in the byte stream is:
@@ -173,27 +287,52 @@ _byteStreamNALUnit(
 
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
- * while accumulating bytestream statistics into stats.
+ * while accumulating bytestream statistics into stats.  nalUnit
+ * points to the bytes of the NAL unit within the buffer of bs and
+ * stays valid until the next call.
  *
- * Returns false if EOF was reached (NB, nalunit data may be valid),
- *         otherwise true.
+ * Returns true if EOF was reached (NB, nalunit data may be valid),
+ *         otherwise false.
  */
 Bool
 byteStreamNALUnit(
   InputByteStream& bs,
-  vector<uint8_t>& nalUnit,
+  const uint8_t*& nalUnit,
+  UInt& nalUnitSize,
   AnnexBStats& stats)
 {
-  Bool eof = false;
+  nalUnit     = NULL;
+  nalUnitSize = 0;
+  bs.releaseConsumedBytes();
   try
   {
-    _byteStreamNALUnit(bs, nalUnit, stats);
+    _byteStreamNALUnit(bs, nalUnit, nalUnitSize, stats);
   }
   catch (...)
   {
-    eof = true;
   }
-  stats.m_numBytesInNALUnit = UInt(nalUnit.size());
+  stats.m_numBytesInNALUnit = nalUnitSize;
+  return bs.eof();
+}
+
+/**
+ * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
+ * while accumulating bytestream statistics into stats.  The bytes
+ * of the NAL unit are appended to nalUnit.
+ *
+ * Returns true if EOF was reached (NB, nalunit data may be valid),
+ *         otherwise false.
+ */
+Bool
+byteStreamNALUnit(
+  InputByteStream& bs,
+  vector<uint8_t>& nalUnit,
+  AnnexBStats& stats)
+{
+  const uint8_t* nalUnitBytes;
+  UInt           nalUnitSize;
+  Bool eof = byteStreamNALUnit(bs, nalUnitBytes, nalUnitSize, stats);
+  nalUnit.insert(nalUnit.end(), nalUnitBytes, nalUnitBytes + nalUnitSize);
   return eof;
 }
 //! \}
@@ -55,30 +55,35 @@ class InputByteStream
 public:
   /**
    * Create a bytestream reader that will extract bytes from
-   * istream.
+   * istream.  The input is read in large blocks, the bytes of the
+   * current NAL unit are kept in one contiguous buffer.
    *
    * NB, it isn't safe to access istream while in use by a
    * InputByteStream.
-   *
-   * Side-effects: the exception mask of istream is set to eofbit
    */
   InputByteStream(std::istream& istream)
-  : m_NumFutureBytes(0)
-  , m_FutureBytes(0)
+  : m_BufferOffset(0)
+  , m_KeepPos(0)
+  , m_ReadPos(0)
+  , m_DataEnd(0)
+  , m_InputExhausted(false)
+  , m_EndOfStream(false)
   , m_Input(istream)
   {
-    istream.exceptions(std::istream::eofbit | std::istream::badbit);
+    reset();
   }
 
   /**
    * Reset the internal state.  Must be called if input stream is
    * modified externally to this class
    */
-  Void reset()
-  {
-    m_NumFutureBytes = 0;
-    m_FutureBytes = 0;
-  }
+  Void reset();
+
+  /**
+   * returns true if an EOF has been encountered, i.e. an attempt
+   * has been made to read or peek beyond the last byte
+   */
+  Bool eof() const { return m_EndOfStream; }
 
   /**
    * returns true if an EOF will be encountered within the next
@@ -87,25 +92,12 @@ public:
   Bool eofBeforeNBytes(UInt n)
   {
     assert(n <= 4);
-    if (m_NumFutureBytes >= n)
+    if (xFill(n))
     {
       return false;
     }
-
-    n -= m_NumFutureBytes;
-    try
-    {
-      for (UInt i = 0; i < n; i++)
-      {
-        m_FutureBytes = (m_FutureBytes << 8) | m_Input.get();
-        m_NumFutureBytes++;
-      }
-    }
-    catch (...)
-    {
-      return true;
-    }
-    return false;
+    m_EndOfStream = true;
+    return true;
   }
 
   /**
@@ -123,7 +115,16 @@ public:
   uint32_t peekBytes(UInt n)
   {
     eofBeforeNBytes(n);
-    return m_FutureBytes >> 8*(m_NumFutureBytes - n);
+    uint32_t val = 0;
+    for (UInt i = 0; i < n; i++)
+    {
+      val <<= 8;
+      if (m_ReadPos + i < m_DataEnd)
+      {
+        val |= m_Buffer[m_ReadPos + i];
+      }
+    }
+    return val;
   }
 
   /**
@@ -134,15 +135,12 @@ public:
    */
   uint8_t readByte()
   {
-    if (!m_NumFutureBytes)
+    if (m_ReadPos == m_DataEnd && !xFill(1))
     {
-      uint8_t byte = m_Input.get();
-      return byte;
+      m_EndOfStream = true;
+      throw std::ios_base::failure("end of byte stream");
     }
-    m_NumFutureBytes--;
-    uint8_t wanted_byte = m_FutureBytes >> 8*m_NumFutureBytes;
-    m_FutureBytes &= ~(0xff << 8*m_NumFutureBytes);
-    return wanted_byte;
+    return m_Buffer[m_ReadPos++];
   }
 
   /**
@@ -160,14 +158,57 @@ public:
     return val;
   }
 
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  UInt GetNumBufferedBytes() const { return m_NumFutureBytes; }
-#endif
+  /**
+   * consume all bytes up to the next byte-aligned three-byte sequence
+   * equal to 0x000000, 0x000001 or 0x000002 or up to the end of the
+   * stream and return a pointer to the first of them.  The bytes stay
+   * valid until releaseConsumedBytes() and a further read are called.
+   */
+  const uint8_t* readNalUnitBytes(UInt& numBytes);
+
+  /**
+   * declare all bytes before the current position as no longer needed,
+   * they may be dropped when the next block is read.
+   */
+  Void releaseConsumedBytes() { m_KeepPos = m_ReadPos; }
+
+  /**
+   * absolute byte position of the next byte to be read.
+   */
+  std::streamoff getPosition() const { return m_BufferOffset + std::streamoff(m_ReadPos); }
+
+  /**
+   * move the read position to a byte position that has not been
+   * released yet and clear a previously encountered EOF.
+   */
+  Void setPosition(std::streamoff position)
+  {
+    assert(position >= m_BufferOffset + std::streamoff(m_KeepPos) && position <= m_BufferOffset + std::streamoff(m_DataEnd));
+    m_ReadPos     = size_t(position - m_BufferOffset);
+    m_EndOfStream = false;
+  }
+
+  /**
+   * pointer to the byte at a position that has not been released yet.
+   */
+  const uint8_t* getBytes(std::streamoff position) const
+  {
+    assert(position >= m_BufferOffset + std::streamoff(m_KeepPos) && position <= m_BufferOffset + std::streamoff(m_DataEnd));
+    return m_Buffer.empty() ? NULL : &m_Buffer[0] + (position - m_BufferOffset);
+  }
 
 private:
-  UInt m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
-  uint32_t m_FutureBytes; /* bytes that have been peeked */
-  std::istream& m_Input; /* Input stream to read from */
+  Bool xFill(UInt n);
+  Void xReadBlock();
+
+  std::vector<uint8_t> m_Buffer;        /* buffered bytes of the input stream */
+  std::streamoff       m_BufferOffset;  /* stream position of m_Buffer[0] */
+  size_t               m_KeepPos;       /* bytes before this index may be dropped */
+  size_t               m_ReadPos;       /* index of the next byte to be read */
+  size_t               m_DataEnd;       /* number of valid bytes in m_Buffer */
+  Bool                 m_InputExhausted;/* all bytes of the input stream have been buffered */
+  Bool                 m_EndOfStream;   /* an attempt has been made to read beyond the last byte */
+  std::istream&        m_Input;         /* Input stream to read from */
 };
 
 /**
@@ -193,6 +234,7 @@ struct AnnexBStats
 };
 
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
+Bool byteStreamNALUnit(InputByteStream& bs, const uint8_t*& nalUnit, UInt& nalUnitSize, AnnexBStats& stats);
 
 //! \}
 
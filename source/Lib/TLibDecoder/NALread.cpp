@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <cstring>
 
 #include "NALread.h"
 #include "TLibCommon/NAL.h"
@@ -55,44 +56,84 @@ using namespace std;
 
 //! \ingroup TLibDecoder
 //! \{
-static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
+/**
+ * Remove emulation prevention bytes from numBytes bytes at src and write the
+ * result to dst, dst may be equal to src.  Returns the number of bytes written.
+ *
+ * Runs of bytes without a 0x000003 pattern are located eight bytes at a time
+ * and copied as a whole.
+ */
+static UInt removeEmulationPreventionBytes(const uint8_t* src, UInt numBytes, uint8_t* dst, TComInputBitstream *bitstream)
 {
-  UInt zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  const uint8_t* end     = src + numBytes;
+  const uint8_t* runSrc  = src;   // start of the bytes not copied yet
+  const uint8_t* scan    = src;   // position of the pattern search
+  uint8_t*       write   = dst;
 
-  UInt pos = 0;
-  bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  while (end - scan >= 3)
   {
-    assert(zeroCount < 2 || *it_read >= 0x03);
-    if (zeroCount == 2 && *it_read == 0x03)
+    if (end - scan >= 8)
+    {
+      // a word without zero bytes cannot contain the start of a 0x000003 pattern
+      uint64_t word;
+      memcpy(&word, scan, sizeof(word));
+      if (((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) == 0)
+      {
+        scan += 8;
+        continue;
+      }
+    }
+
+    if (scan[2] == 0x00)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      scan++;
+    }
+    else if (scan[2] != 0x03 || scan[1] != 0x00 || scan[0] != 0x00)
+    {
+      scan += 3;
+    }
+    else
+    {
+      // copy up to and including the two zero bytes, skip the emulation prevention byte
+      UInt runLength = UInt(scan + 2 - runSrc);
+      memmove(write, runSrc, runLength);
+      write += runLength;
+
+      bitstream->pushEmulationPreventionByteLocation( UInt(scan + 2 - src) );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
-      {
-        break;
-      }
-      assert(*it_read <= 0x03);
+      runSrc = scan = scan + 3;
+      assert(runSrc == end || *runSrc <= 0x03);
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
   }
-  assert(zeroCount == 0);
+
+  UInt runLength = UInt(end - runSrc);
+  memmove(write, runSrc, runLength);
+  write += runLength;
+
+  return UInt(write - dst);
+}
+
+static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, const uint8_t* nalUnitBytes, UInt nalUnitSize, TComInputBitstream *bitstream, Bool isVclNalUnit)
+{
+  bitstream->clearEmulationPreventionByteLocation();
+  assert(nalUnitSize == 0 || nalUnitBytes[nalUnitSize - 1] != 0x00);
+
+  if (nalUnitBuf.empty() || nalUnitBytes != &nalUnitBuf[0])
+  {
+    nalUnitBuf.resize(nalUnitSize);
+  }
+  UInt numBytes = ( nalUnitSize > 0 ) ? removeEmulationPreventionBytes(nalUnitBytes, nalUnitSize, &nalUnitBuf[0], bitstream) : 0;
 
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     Int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (numBytes > 0 && nalUnitBuf[numBytes - 1] == 0x00)
     {
-      it_write--;
+      numBytes--;
       n++;
     }
 
@@ -102,7 +143,7 @@ static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(numBytes);
 }
 
 #if ENC_DEC_TRACE && DEC_NUH_TRACE
@@ -196,8 +237,22 @@ Void read(InputNALUnit& nalu)
 {
   TComInputBitstream &bitstream = nalu.getBitstream();
   vector<uint8_t>& nalUnitBuf=bitstream.getFifo();
-  // perform anti-emulation prevention
-  convertPayloadToRBSP(nalUnitBuf, &bitstream, (nalUnitBuf[0] & 64) == 0);
+  // perform anti-emulation prevention in place
+  convertPayloadToRBSP(nalUnitBuf, &nalUnitBuf[0], UInt(nalUnitBuf.size()), &bitstream, (nalUnitBuf[0] & 64) == 0);
+  bitstream.resetToStart();
+  readNalUnitHeader(nalu);
+}
+
+/**
+ * create a NALunit structure with given header values, the RBSP is
+ * extracted directly from the nalUnitSize bytes at nalUnitBytes
+ */
+Void read(InputNALUnit& nalu, const uint8_t* nalUnitBytes, UInt nalUnitSize)
+{
+  TComInputBitstream &bitstream = nalu.getBitstream();
+  vector<uint8_t>& nalUnitBuf=bitstream.getFifo();
+  // perform anti-emulation prevention while copying
+  convertPayloadToRBSP(nalUnitBuf, nalUnitBytes, nalUnitSize, &bitstream, (nalUnitBytes[0] & 64) == 0);
   bitstream.resetToStart();
   readNalUnitHeader(nalu);
 }
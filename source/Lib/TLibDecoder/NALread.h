@@ -64,6 +64,7 @@ class InputNALUnit : public NALUnit
 };
 
 Void read(InputNALUnit& nalu);
+Void read(InputNALUnit& nalu, const uint8_t* nalUnitBytes, UInt nalUnitSize);
 Void readNalUnitHeader(InputNALUnit& nalu);
 
 //! \}
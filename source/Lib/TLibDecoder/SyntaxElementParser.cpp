@@ -200,31 +200,12 @@ Void SyntaxElementParser::xReadUvlc( UInt& ruiVal)
 #endif
 {
   UInt uiVal = 0;
-  UInt uiCode = 0;
-  UInt uiLength;
-  m_pcBitstream->read( 1, uiCode );
+  UInt uiNumBits;
+  m_pcBitstream->readExpGolomb( uiVal, uiNumBits );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  UInt totalLen=1;
+  UInt totalLen=uiNumBits;
 #endif
 
-  if( 0 == uiCode )
-  {
-    uiLength = 0;
-
-    while( ! ( uiCode & 1 ))
-    {
-      m_pcBitstream->read( 1, uiCode );
-      uiLength++;
-    }
-
-    m_pcBitstream->read( uiLength, uiVal );
-
-    uiVal += (1 << uiLength)-1;
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    totalLen+=uiLength+uiLength;
-#endif
-  }
-
   ruiVal = uiVal;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::IncrementStatisticEP(pSymbolName, Int(totalLen), ruiVal);
@@ -237,33 +218,14 @@ Void SyntaxElementParser::xReadSvlc( Int& riVal, const TChar *pSymbolName)
 Void SyntaxElementParser::xReadSvlc( Int& riVal)
 #endif
 {
-  UInt uiBits = 0;
-  m_pcBitstream->read( 1, uiBits );
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  UInt totalLen=1;
-#endif
-  if( 0 == uiBits )
-  {
-    UInt uiLength = 0;
-
-    while( ! ( uiBits & 1 ))
-    {
-      m_pcBitstream->read( 1, uiBits );
-      uiLength++;
-    }
-
-    m_pcBitstream->read( uiLength, uiBits );
-
-    uiBits += (1 << uiLength);
-    riVal = ( uiBits & 1) ? -(Int)(uiBits>>1) : (Int)(uiBits>>1);
+  UInt uiCodeNum = 0;
+  UInt uiNumBits;
+  m_pcBitstream->readExpGolomb( uiCodeNum, uiNumBits );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    totalLen+=uiLength+uiLength;
+  UInt totalLen=uiNumBits;
 #endif
-  }
-  else
-  {
-    riVal = 0;
-  }
+  // codeNum k maps to (-1)^(k+1) * Ceil(k/2)
+  riVal = ( uiCodeNum & 1 ) ? (Int)((uiCodeNum + 1) >> 1) : -(Int)(uiCodeNum >> 1);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::IncrementStatisticEP(pSymbolName, Int(totalLen), riVal);
 #endif
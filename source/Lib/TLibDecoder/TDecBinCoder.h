@@ -62,10 +62,12 @@ public:
   virtual Void  decodeBin         ( UInt& ruiBin, ContextModel& rcCtxModel, const class TComCodingStatisticsClassType &whichStat )  = 0;
   virtual Void  decodeBinEP       ( UInt& ruiBin                          , const class TComCodingStatisticsClassType &whichStat )  = 0;
   virtual Void  decodeBinsEP      ( UInt& ruiBins, Int numBins            , const class TComCodingStatisticsClassType &whichStat )  = 0;
+  virtual Void  decodeUnaryBinsEP ( UInt& ruiNumOnes, UInt uiMaxBins      , const class TComCodingStatisticsClassType &whichStat )  = 0;
 #else
   virtual Void  decodeBin         ( UInt& ruiBin, ContextModel& rcCtxModel )  = 0;
   virtual Void  decodeBinEP       ( UInt& ruiBin                           )  = 0;
   virtual Void  decodeBinsEP      ( UInt& ruiBins, Int numBins             )  = 0;
+  virtual Void  decodeUnaryBinsEP ( UInt& ruiNumOnes, UInt uiMaxBins       )  = 0;
 #endif
 
   virtual Void  align             ()                                          = 0;
@@ -44,6 +44,9 @@
 //! \ingroup TLibDecoder
 //! \{
 
+//! position of the decoding window in m_uiValue, the bits below it hold data that has already been read from the bitstream
+static const Int CABAC_VALUE_SHIFT = 22;
+
 TDecBinCABAC::TDecBinCABAC()
 : m_pcTComBitstream( 0 )
 {
@@ -76,6 +79,7 @@ TDecBinCABAC::start()
   m_bitsNeeded = -8;
   m_uiValue    = (m_pcTComBitstream->readByte() << 8);
   m_uiValue   |= m_pcTComBitstream->readByte();
+  m_uiValue  <<= CABAC_VALUE_SHIFT - 7;
 }
 
 Void
@@ -116,7 +120,7 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 
   UInt uiLPS = TComCABACTables::sm_aucLPSTable[ rcCtxModel.getState() ][ ( m_uiRange >> 6 ) - 4 ];
   m_uiRange -= uiLPS;
-  UInt scaledRange = m_uiRange << 7;
+  UInt scaledRange = m_uiRange << CABAC_VALUE_SHIFT;
 
   if( m_uiValue < scaledRange )
   {
@@ -127,15 +131,14 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 #endif
     rcCtxModel.updateMPS();
 
-    if ( scaledRange < ( 256 << 7 ) )
+    if ( m_uiRange < 256 )
     {
-      m_uiRange = scaledRange >> 6;
+      m_uiRange += m_uiRange;
       m_uiValue += m_uiValue;
 
-      if ( ++m_bitsNeeded == 0 )
+      if ( ++m_bitsNeeded >= 0 )
       {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
+        xReadBytes();
       }
     }
   }
@@ -155,8 +158,7 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 
     if ( m_bitsNeeded >= 0 )
     {
-      m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
+      xReadBytes();
     }
   }
 
@@ -186,26 +188,15 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin, const TComCodingStatisticsClassTyp
 Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 {
-  if (m_uiRange == 256)
-  {
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    decodeAlignedBinsEP(ruiBin, 1, whichStat);
-#else
-    decodeAlignedBinsEP(ruiBin, 1);
-#endif
-    return;
-  }
-
   m_uiValue += m_uiValue;
 
   if ( ++m_bitsNeeded >= 0 )
   {
-    m_bitsNeeded = -8;
-    m_uiValue += m_pcTComBitstream->readByte();
+    xReadBytes();
   }
 
   ruiBin = 0;
-  UInt scaledRange = m_uiRange << 7;
+  UInt scaledRange = m_uiRange << CABAC_VALUE_SHIFT;
   if ( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
@@ -216,6 +207,14 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 }
 
+/**
+ - Decode a run of bypass bins.
+ .
+ The bins are decoded in batches of as many bins as the value register holds
+ bits for, so the bitstream is only accessed once per batch.
+ \param ruiBin  decoded bins, first bin in the most significant position
+ \param numBins number of bins to decode
+ */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins, const TComCodingStatisticsClassType &whichStat )
 #else
@@ -236,48 +235,73 @@ Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   Int origNumBins=numBins;
 #endif
-  while ( numBins > 8 )
+  const UInt scaledRange = m_uiRange << CABAC_VALUE_SHIFT;
+
+  while ( numBins > 0 )
   {
-    m_uiValue = ( m_uiValue << 8 ) + ( m_pcTComBitstream->readByte() << ( 8 + m_bitsNeeded ) );
+    if ( m_bitsNeeded > -8 )
+    {
+      xReadBytes();
+    }
 
-    UInt scaledRange = m_uiRange << 15;
-    for ( Int i = 0; i < 8; i++ )
+    const Int binsInBatch = std::min<Int>( numBins, -m_bitsNeeded - 1 );
+    for ( Int i = 0; i < binsInBatch; i++ )
     {
-      bins += bins;
-      scaledRange >>= 1;
+      bins      += bins;
+      m_uiValue += m_uiValue;
       if ( m_uiValue >= scaledRange )
       {
         bins++;
         m_uiValue -= scaledRange;
       }
     }
-    numBins -= 8;
+    m_bitsNeeded += binsInBatch;
+    numBins      -= binsInBatch;
   }
 
-  m_bitsNeeded += numBins;
-  m_uiValue <<= numBins;
+  ruiBin = bins;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  TComCodingStatistics::IncrementStatisticEP(whichStat, origNumBins, Int(ruiBin));
+#endif
+}
 
-  if ( m_bitsNeeded >= 0 )
-  {
-    m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
-  }
+/**
+ - Decode a unary coded run of bypass bins.
+ .
+ Bins equal to one are counted until a zero bin is decoded or uiMaxBins
+ bins equal to one have been decoded.
+ \param ruiNumOnes number of leading bins equal to one
+ \param uiMaxBins  maximum number of bins equal to one
+ */
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+Void TDecBinCABAC::decodeUnaryBinsEP( UInt& ruiNumOnes, UInt uiMaxBins, const TComCodingStatisticsClassType &whichStat )
+#else
+Void TDecBinCABAC::decodeUnaryBinsEP( UInt& ruiNumOnes, UInt uiMaxBins )
+#endif
+{
+  const UInt scaledRange = m_uiRange << CABAC_VALUE_SHIFT;
+  UInt numOnes = 0;
 
-  UInt scaledRange = m_uiRange << ( numBins + 7 );
-  for ( Int i = 0; i < numBins; i++ )
+  while ( numOnes < uiMaxBins )
   {
-    bins += bins;
-    scaledRange >>= 1;
-    if ( m_uiValue >= scaledRange )
+    m_uiValue += m_uiValue;
+
+    if ( ++m_bitsNeeded >= 0 )
+    {
+      xReadBytes();
+    }
+
+    if ( m_uiValue < scaledRange )
     {
-      bins++;
-      m_uiValue -= scaledRange;
+      break;
     }
+    m_uiValue -= scaledRange;
+    numOnes++;
   }
 
-  ruiBin = bins;
+  ruiNumOnes = numOnes;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  TComCodingStatistics::IncrementStatisticEP(whichStat, origNumBins, Int(ruiBin));
+  TComCodingStatistics::IncrementStatisticEP(whichStat, Int(numOnes < uiMaxBins ? numOnes + 1 : numOnes), Int(numOnes));
 #endif
 }
 
@@ -302,7 +326,13 @@ Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins )
 
   while (binsRemaining > 0)
   {
-    const UInt binsToRead = std::min<UInt>(binsRemaining, 8); //read bytes if able to take advantage of the system's byte-read function
+    if (m_bitsNeeded > -8)
+    {
+      xReadBytes();
+    }
+
+    //all bits below the 8 usable bits of the window can be taken as well
+    const UInt binsToRead = std::min<UInt>(binsRemaining, 7 - m_bitsNeeded);
     const UInt binMask    = (1 << binsToRead) - 1;
 
     //The MSB of m_uiValue is known to be 0 because range is 256. Therefore:
@@ -310,23 +340,22 @@ Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins )
     // > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
     //
     //As a result, the required bins are simply the <binsToRead> next-most-significant bits of m_uiValue
-    //(m_uiValue is stored MSB-aligned in a 16-bit buffer - hence the shift of 15)
+    //(the window is stored MSB-aligned below bit CABAC_VALUE_SHIFT + 8 - hence the shift of CABAC_VALUE_SHIFT + 8)
     //
-    //   m_uiValue = |0|V|V|V|V|V|V|V|V|B|B|B|B|B|B|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
+    //   m_uiValue = |0|V|V|V|V|V|V|V|V|B|B|B|...|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded > -8))
     //
-    const UInt newBins = (m_uiValue >> (15 - binsToRead)) & binMask;
+    const UInt newBins = (m_uiValue >> (CABAC_VALUE_SHIFT + 8 - binsToRead)) & binMask;
 
     ruiBins   = (ruiBins   << binsToRead) | newBins;
-    m_uiValue = (m_uiValue << binsToRead) & 0x7FFF;
+    m_uiValue = (m_uiValue << binsToRead) & ((1 << (CABAC_VALUE_SHIFT + 8)) - 1);
 
     binsRemaining -= binsToRead;
     m_bitsNeeded  += binsToRead;
+  }
 
-    if (m_bitsNeeded >= 0)
-    {
-      m_uiValue    |= m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
+  if (m_bitsNeeded >= 0)
+  {
+    xReadBytes();
   }
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -338,10 +367,12 @@ Void
 TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 {
   m_uiRange -= 2;
-  UInt scaledRange = m_uiRange << 7;
+  UInt scaledRange = m_uiRange << CABAC_VALUE_SHIFT;
   if( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
+    // the bitstream is read directly after a terminating bin, so return the bytes read ahead
+    xReleaseBytes();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, 2, ruiBin);
     TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0);
@@ -353,15 +384,14 @@ TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, m_uiRange, ruiBin);
 #endif
-    if ( scaledRange < ( 256 << 7 ) )
+    if ( m_uiRange < 256 )
     {
-      m_uiRange = scaledRange >> 6;
+      m_uiRange += m_uiRange;
       m_uiValue += m_uiValue;
 
-      if ( ++m_bitsNeeded == 0 )
+      if ( ++m_bitsNeeded >= 0 )
       {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
+        xReadBytes();
       }
     }
   }
@@ -380,4 +410,45 @@ Void  TDecBinCABAC::xReadPCMCode(UInt uiLength, UInt& ruiCode)
   TComCodingStatistics::IncrementStatisticEP(STATS__CABAC_PCM_CODE_BITS, uiLength, ruiCode);
 #endif
 }
+
+/** Refill the value register.
+ * Two bytes are read at once when the bitstream holds them, which fills the register
+ * below the decoding window and halves the number of refills compared to bytewise reading.
+ * Near the end of the bitstream the register is only refilled when the next bin needs it.
+ * Requires m_bitsNeeded > -8.
+ */
+Void TDecBinCABAC::xReadBytes()
+{
+  const UInt uiNumBitsLeft = m_pcTComBitstream->getNumBitsLeft();
+  if ( uiNumBitsLeft >= 16 )
+  {
+    UInt uiBytes = m_pcTComBitstream->readByte() << 8;
+    uiBytes     |= m_pcTComBitstream->readByte();
+    m_uiValue   += uiBytes << ( m_bitsNeeded + CABAC_VALUE_SHIFT - 15 );
+    m_bitsNeeded -= 16;
+  }
+  else if ( uiNumBitsLeft > 0 || m_bitsNeeded >= -1 )
+  {
+    m_uiValue   += m_pcTComBitstream->readByte() << ( m_bitsNeeded + CABAC_VALUE_SHIFT - 7 );
+    m_bitsNeeded -= 8;
+  }
+}
+
+/** Return bytes that were read ahead of the bytewise decoding process.
+ * Afterwards the bitstream position and m_bitsNeeded match a decoder that reads one byte per refill.
+ */
+Void TDecBinCABAC::xReleaseBytes()
+{
+  UInt uiNumBytes = 0;
+  while ( m_bitsNeeded < -8 )
+  {
+    m_bitsNeeded += 8;
+    m_uiValue    &= ~( ( 1u << ( m_bitsNeeded + CABAC_VALUE_SHIFT + 1 ) ) - 1 );
+    uiNumBytes++;
+  }
+  if ( uiNumBytes )
+  {
+    m_pcTComBitstream->rewindBytes( uiNumBytes );
+  }
+}
 //! \}
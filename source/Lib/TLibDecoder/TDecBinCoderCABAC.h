@@ -61,11 +61,13 @@ public:
   Void  decodeBinEP        ( UInt& ruiBin                          , const class TComCodingStatisticsClassType &whichStat );
   Void  decodeBinsEP       ( UInt& ruiBin, Int numBins             , const class TComCodingStatisticsClassType &whichStat );
   Void  decodeAlignedBinsEP( UInt& ruiBins, Int numBins            , const class TComCodingStatisticsClassType &whichStat );
+  Void  decodeUnaryBinsEP  ( UInt& ruiNumOnes, UInt uiMaxBins      , const class TComCodingStatisticsClassType &whichStat );
 #else
   Void  decodeBin         ( UInt& ruiBin, ContextModel& rcCtxModel );
   Void  decodeBinEP       ( UInt& ruiBin                           );
   Void  decodeBinsEP      ( UInt& ruiBin, Int numBins              );
   Void  decodeAlignedBinsEP( UInt& ruiBins, Int numBins             );
+  Void  decodeUnaryBinsEP  ( UInt& ruiNumOnes, UInt uiMaxBins       );
 #endif
 
   Void  align             ();
@@ -79,6 +81,9 @@ public:
   const TDecBinCABAC* getTDecBinCABAC() const { return this; }
 
 private:
+  Void  xReadBytes        ();
+  Void  xReleaseBytes     ();
+
   TComInputBitstream* m_pcTComBitstream;
   UInt                m_uiRange;
   UInt                m_uiValue;
@@ -149,6 +149,9 @@ Void TDecCu::destroy()
  */
 Void TDecCu::decodeCtu( TComDataCU* pCtu, Bool& isLastCtuOfSliceSegment )
 {
+#if NH_3D_SCRATCH_ARENA
+  m_pcPrediction->getScratchArena().reset();
+#endif
   if ( pCtu->getSlice()->getPPS()->getUseDQP() )
   {
     setdQPFlag(true);
@@ -439,9 +442,15 @@ if(!pcCU->getSlice()->isIntra())
     memset(bSPIVMPFlag, false, sizeof(Bool)*MRG_MAX_NUM_CANDS_MEM);
     TComMvField*  pcMvFieldSP;
     UChar* puhInterDirSP;
+#if NH_3D_SCRATCH_ARENA
+    TComArenaScope cArenaScope( m_pcPrediction->getScratchArena() );
+    pcMvFieldSP   = m_pcPrediction->getScratchArena().alloc<TComMvField>( pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2 );
+    puhInterDirSP = m_pcPrediction->getScratchArena().alloc<UChar>      ( pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()   );
+#else
     pcMvFieldSP = new TComMvField[pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2]; 
     puhInterDirSP = new UChar[pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()]; 
 #endif
+#endif
 
 #if NH_3D_MLC
     m_ppcCU[uiDepth]->initAvailableFlags();
@@ -564,8 +573,10 @@ if(!pcCU->getSlice()->isIntra())
       }
 #endif
     }
+#if !NH_3D_SCRATCH_ARENA
     delete[] pcMvFieldSP;
     delete[] puhInterDirSP;
+#endif
 #endif
 
     xFinishDecodeCU( pcCU, uiAbsPartIdx, uiDepth, isLastCtuOfSliceSegment );
@@ -934,7 +945,13 @@ Void TDecCu::xReconInterDBBP( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth
   AOF( uiDepthStride != 0 );
   
   // compute mask by segmenting depth block
+#if NH_3D_SCRATCH_ARENA
+  // the mask is addressed with a stride of MAX_CU_SIZE
+  TComArenaScope cArenaScope( m_pcPrediction->getScratchArena() );
+  Bool* pMask = m_pcPrediction->getScratchArena().alloc<Bool>( MAX_CU_SIZE*pcCU->getHeight(0) );
+#else
   Bool pMask[MAX_CU_SIZE*MAX_CU_SIZE];
+#endif
   Bool bValidMask = m_pcPrediction->getSegmentMaskFromDepth(pDepthPels, uiDepthStride, pcCU->getWidth(0), pcCU->getHeight(0), pMask, pcCU);
   AOF(bValidMask);
   
@@ -1284,6 +1301,9 @@ Void TDecCu::xReconIntraSDC( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
   UInt uiMaskStride = 0;
 
 #if NH_3D_DMM
+#if NH_3D_SCRATCH_ARENA
+  TComArenaScope cArenaScope( m_pcPrediction->getScratchArena() );
+#endif
   if( isDmmMode( uiLumaPredMode ) )
   {
     assert( uiWidth == uiHeight  );
@@ -1308,7 +1328,11 @@ Void TDecCu::xReconIntraSDC( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
     m_pcPrediction->initIntraPatternChType( tuRecurseWithPU, COMPONENT_Y, false DEBUG_STRING_PASS_INTO(sTemp) );
 
     // get partition
+#if NH_3D_SCRATCH_ARENA
+    pbMask       = m_pcPrediction->getScratchArena().alloc<Bool>( uiWidth*uiHeight );
+#else
     pbMask       = new Bool[ uiWidth*uiHeight ];
+#endif
     uiMaskStride = uiWidth;
     switch( getDmmType( uiLumaPredMode ) )
     {
@@ -1449,7 +1473,7 @@ Void TDecCu::xReconIntraSDC( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
     pRecCb += uiStrideC;
     pRecCr += uiStrideC;
   }
-#if NH_3D_DMM
+#if NH_3D_DMM && !NH_3D_SCRATCH_ARENA
   if( pbMask ) { delete[] pbMask; }
 #endif
 }
@@ -38,6 +38,9 @@
 #include "TDecEntropy.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/TComPrediction.h"
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+#include "TLibCommon/TComCodingStatistics.h"
+#endif
 
 #if ENVIRONMENT_VARIABLE_DEBUG_AND_TEST
 #include "../TLibCommon/Debug.h"
@@ -248,9 +251,15 @@ Void TDecEntropy::decodePUWise( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDept
 #endif
 #if NH_3D_SPIVMP
   Bool bSPIVMPFlag[MRG_MAX_NUM_CANDS_MEM];     
+#if NH_3D_SCRATCH_ARENA
+  TComArenaScope cArenaScope( m_pcPrediction->getScratchArena() );
+  TComMvField*  pcMvFieldSP   = m_pcPrediction->getScratchArena().alloc<TComMvField>( pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2 );
+  UChar*        puhInterDirSP = m_pcPrediction->getScratchArena().alloc<UChar>      ( pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()   );
+#else
   TComMvField*  pcMvFieldSP = new TComMvField[pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2]; 
   UChar* puhInterDirSP = new UChar[pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()]; 
 #endif
+#endif
 #if NH_3D_IV_MERGE
   pcSubCU->copyDVInfoFrom( pcCU, uiAbsPartIdx);
 #endif
@@ -428,6 +437,12 @@ Void TDecEntropy::decodePUWise( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDept
 #endif
         }
       }
+#if NH_3D_VSP && RExt__DECODER_DEBUG_BIT_STATISTICS
+      if( pcCU->getVSPFlag( uiSubPartIdx ) != 0 )
+      {
+        TComCodingStatistics::IncrementVspMergedPUs();
+      }
+#endif
 #if NH_3D_SPIVMP
       pcCU->setSPIVMPFlagSubParts(bSPIVMPFlag[uiMergeIndex], uiSubPartIdx, uiPartIdx, uiDepth );  
       if (bSPIVMPFlag[uiMergeIndex] != 0)
@@ -664,7 +679,7 @@ Void TDecEntropy::decodePUWise( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDept
     }
   }
 #endif
-#if NH_3D_SPIVMP
+#if NH_3D_SPIVMP && !NH_3D_SCRATCH_ARENA
   delete[] pcMvFieldSP;
   delete[] puhInterDirSP;
 #endif
@@ -3285,7 +3285,12 @@ Void TDecTop::xF833DecProcForGenUnavRefPics()
   // F.8.3.3 Decoding process for generating unavailable reference picture
   ///////////////////////////////////////////////////////////////////////////////////////
 
-  x8331GenDecProcForGenUnavilRefPics();
+  // The process is also invoked for IDR pictures with nuh_layer_id greater than 0 following an IDR access unit
+  // within the bitstream. All lists of their RPS are empty, hence no picture is generated.
+  if ( !m_pcPic->isIdr() )
+  {
+    x8331GenDecProcForGenUnavilRefPics();
+  }
 }
 
 Void TDecTop::xCheckUnavailableRefPics()
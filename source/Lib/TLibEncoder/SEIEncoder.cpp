@@ -245,7 +245,8 @@ Void SEIEncoder::initSEIBufferingPeriod(SEIBufferingPeriod *bufferingPeriodSEI,
 
   bufferingPeriodSEI->m_rapCpbParamsPresentFlag = 0;
   //for the concatenation, it can be set to one during splicing.
-  bufferingPeriodSEI->m_concatenationFlag = 0;
+  //a segment encoded for stitching is spliced at its first access unit
+  bufferingPeriodSEI->m_concatenationFlag = ( m_pcCfg->getBufferingPeriodConcatenationFlag() && slice->getPOC() == 0 ) ? 1 : 0;
   //since the temporal layer HRD is not ready, we assumed it is fixed
   bufferingPeriodSEI->m_auCpbRemovalDelayDelta = 1;
   bufferingPeriodSEI->m_cpbDelayOffset = 0;
@@ -71,6 +71,9 @@ public:
 
   virtual Void  align             ()                                          = 0;
 
+  virtual Bool  isBitCounter      () const                                    { return false; }
+  virtual Void  setContextTracking( const ContextModel* pcContextModels, UInt64* pModifiedChunks ) {}
+
   virtual TEncBinCABAC*   getTEncBinCABAC   ()  { return 0; }
   virtual const TEncBinCABAC*   getTEncBinCABAC   () const { return 0; }
 
@@ -42,10 +42,14 @@
 //! \ingroup TLibEncoder
 //! \{
 
+//! number of bits that can be added to m_uiLow before it has to be written out; bytes are written out in bulk once fewer than 12 are left
+static const Int CABAC_LOW_BITS_LEFT = 55;
 
 TEncBinCABAC::TEncBinCABAC()
 : m_pcTComBitIf( 0 )
 , m_binCountIncrement( 0 )
+, m_pcContextModels( NULL )
+, m_pModifiedContextChunks( NULL )
 #if FAST_BIT_EST
 , m_fracBits( 0 )
 #endif
@@ -70,7 +74,7 @@ Void TEncBinCABAC::start()
 {
   m_uiLow            = 0;
   m_uiRange          = 510;
-  m_bitsLeft         = 23;
+  m_bitsLeft         = CABAC_LOW_BITS_LEFT;
   m_numBufferedBytes = 0;
   m_bufferedByte     = 0xff;
 #if FAST_BIT_EST
@@ -80,7 +84,7 @@ Void TEncBinCABAC::start()
 
 Void TEncBinCABAC::finish()
 {
-  if ( m_uiLow >> ( 32 - m_bitsLeft ) )
+  if ( m_uiLow >> ( 64 - m_bitsLeft ) )
   {
     //assert( m_numBufferedBytes > 0 );
     //assert( m_bufferedByte != 0xff );
@@ -90,7 +94,7 @@ Void TEncBinCABAC::finish()
       m_pcTComBitIf->write( 0x00, 8 );
       m_numBufferedBytes--;
     }
-    m_uiLow -= 1 << ( 32 - m_bitsLeft );
+    m_uiLow -= UInt64(1) << ( 64 - m_bitsLeft );
   }
   else
   {
@@ -104,7 +108,12 @@ Void TEncBinCABAC::finish()
       m_numBufferedBytes--;
     }
   }
-  m_pcTComBitIf->write( m_uiLow >> 8, 24 - m_bitsLeft );
+  const Int numBits = 56 - m_bitsLeft;
+  if ( numBits > 32 )
+  {
+    m_pcTComBitIf->write( UInt( m_uiLow >> 40 ), numBits - 32 );
+  }
+  m_pcTComBitIf->write( UInt( m_uiLow >> 8 ), std::min( numBits, 32 ) );
 }
 
 Void TEncBinCABAC::flush()
@@ -164,7 +173,7 @@ Void TEncBinCABAC::copyState( const TEncBinIf* pcTEncBinIf )
 Void TEncBinCABAC::resetBits()
 {
   m_uiLow            = 0;
-  m_bitsLeft         = 23;
+  m_bitsLeft         = CABAC_LOW_BITS_LEFT;
   m_numBufferedBytes = 0;
   m_bufferedByte     = 0xff;
   if ( m_binCountIncrement )
@@ -184,7 +193,7 @@ Void TEncBinCABAC::resetBits()
 
 UInt TEncBinCABAC::getNumWrittenBits()
 {
-  return m_pcTComBitIf->getNumberOfWrittenBits() + 8 * m_numBufferedBytes + 23 - m_bitsLeft;
+  return m_pcTComBitIf->getNumberOfWrittenBits() + 8 * m_numBufferedBytes + CABAC_LOW_BITS_LEFT - m_bitsLeft;
 }
 
 /**
@@ -211,6 +220,7 @@ Void TEncBinCABAC::encodeBin( UInt binValue, ContextModel &rcCtxModel )
 
   m_uiBinsCoded += m_binCountIncrement;
   rcCtxModel.setBinsCoded( 1 );
+  xMarkContextModified( rcCtxModel );
 
   UInt  uiLPS   = TComCABACTables::sm_aucLPSTable[ rcCtxModel.getState() ][ ( m_uiRange >> 6 ) & 3 ];
   m_uiRange    -= uiLPS;
@@ -422,12 +432,22 @@ Void TEncBinCABAC::testAndWriteOut()
 
 /**
  * \brief Move bits from register into bitstream
+ *
+ * All complete bytes held in the register are written, which leaves room for at least 36 more bits.
  */
 Void TEncBinCABAC::writeOut()
 {
-  UInt leadByte = m_uiLow >> (24 - m_bitsLeft);
+  while ( m_bitsLeft < CABAC_LOW_BITS_LEFT - 7 )
+  {
+    xWriteOutByte();
+  }
+}
+
+Void TEncBinCABAC::xWriteOutByte()
+{
+  UInt leadByte = UInt( m_uiLow >> (56 - m_bitsLeft) );
   m_bitsLeft += 8;
-  m_uiLow &= 0xffffffffu >> m_bitsLeft;
+  m_uiLow &= ~UInt64(0) >> m_bitsLeft;
 
   if ( leadByte == 0xff )
   {
@@ -39,6 +39,7 @@
 #define __TENCBINCODERCABAC__
 
 #include "TLibCommon/TComCABACTables.h"
+#include "TLibCommon/ContextTables.h"
 #include "TEncBinCoder.h"
 
 //! \ingroup TLibEncoder
@@ -73,6 +74,8 @@ public:
   Void  align             ();
   Void  encodeAlignedBinsEP( UInt  binValues, Int numBins             );
 
+  Void  setContextTracking( const ContextModel* pcContextModels, UInt64* pModifiedChunks ) { m_pcContextModels = pcContextModels; m_pModifiedContextChunks = pModifiedChunks; }
+
   TEncBinCABAC* getTEncBinCABAC()  { return this; }
   const TEncBinCABAC* getTEncBinCABAC() const { return this; }
 
@@ -88,15 +91,29 @@ private:
 #endif
   Void testAndWriteOut();
   Void writeOut();
+  Void xWriteOutByte();
+
+  /// record the chunk of the context set of the owning entropy coder that is changed by coding a bin with rcCtxModel
+  Void xMarkContextModified( const ContextModel& rcCtxModel )
+  {
+    if( m_pModifiedContextChunks )
+    {
+      const UInt ctxIdx = UInt( &rcCtxModel - m_pcContextModels );
+      assert( ctxIdx < MAX_NUM_CTX_MOD );
+      *m_pModifiedContextChunks |= UInt64(1) << ( ctxIdx / NUM_CTX_MOD_PER_CHUNK );
+    }
+  }
 
   TComBitIf*          m_pcTComBitIf;
-  UInt                m_uiLow;
+  UInt64              m_uiLow;
   UInt                m_uiRange;
   UInt                m_bufferedByte;
   Int                 m_numBufferedBytes;
   Int                 m_bitsLeft;
   UInt                m_uiBinsCoded;
   Int                 m_binCountIncrement;
+  const ContextModel* m_pcContextModels;
+  UInt64*             m_pModifiedContextChunks;
 #if FAST_BIT_EST
   UInt64 m_fracBits;
 #endif
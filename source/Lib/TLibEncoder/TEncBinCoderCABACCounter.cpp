@@ -87,6 +87,7 @@ Void TEncBinCABACCounter::encodeBin( UInt binValue, ContextModel &rcCtxModel )
 #endif
 
   rcCtxModel.update( binValue );
+  xMarkContextModified( rcCtxModel );
 
 #if DEBUG_ENCODER_SEARCH_BINS
   if ((g_debugCounter + debugEncoderSearchBinWindow) >= debugEncoderSearchBinTargetLine)
@@ -63,6 +63,8 @@ public:
 
   Void  align             ();
 
+  Bool  isBitCounter      () const { return true; }
+
 private:
 };
 
@@ -238,6 +238,25 @@ protected:
 #if NH_MV
   Bool      m_bUseDisparitySearchRangeRestriction;
   Int       m_iVerticalDisparitySearchRange;
+#endif
+#if NH_3D_IV_MOTION_SEED
+  Bool      m_bUseIvMotionSeed;
+  Int       m_iIvMotionSeedSearchRange;
+#endif
+#if NH_MV_PYRAMID_ME
+  Bool      m_bUsePyramidME;
+  Int       m_iPyramidMERefineRange;
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  Bool      m_bUseRatePointMotionSeed;
+  Int       m_iRatePointMotionSeedSearchRange;
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  Bool      m_bUseSubPelPlaneCache;
+#endif
+#if NH_MV_PIC_ANALYSIS
+  Bool      m_bUsePicAnalysis;
+  Bool      m_bUsePicAnalysisFastIntra;
 #endif
   //====== Quality control ========
   Int       m_iMaxDeltaQP;                      //  Max. absolute delta QP (1:default)
@@ -321,6 +340,7 @@ protected:
 
   HashType  m_decodedPictureHashSEIType;
   Bool      m_bufferingPeriodSEIEnabled;
+  Bool      m_bufferingPeriodConcatenationFlag;               ///< coded sequence is concatenated to a preceding one, signalled in the first buffering period SEI
   Bool      m_pictureTimingSEIEnabled;
   Bool      m_recoveryPointSEIEnabled;
   Bool      m_toneMappingInfoSEIEnabled;
@@ -510,6 +530,7 @@ protected:
   // SAIT_VSO_EST_A0033
   Bool      m_bUseEstimatedVSD; 
   Double    m_dDispCoeff;
+  Bool      m_bVSOIncrementalSetup;
 #endif
 #if NH_3D
 
@@ -522,6 +543,10 @@ protected:
 #if NH_3D_QTL
   Bool      m_bUseQTL;
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  Bool      m_bUseTexGuidedDepthMD;
+  Int       m_iTexGuidedDepthEdgeThr;
+#endif
 #if NH_3D
   Int       m_profileIdc;
 #endif
@@ -529,6 +554,7 @@ public:
   TEncCfg()
   : m_tileColumnWidth()
   , m_tileRowHeight()
+  , m_bufferingPeriodConcatenationFlag(false)
 #if NH_MV
   , m_layerId(-1)
   , m_layerIdInVps(-1)
@@ -540,6 +566,7 @@ public:
 #endif
 #if NH_3D_VSO
   , m_bUseVSO(false)
+  , m_bVSOIncrementalSetup(false)
 #endif
 #if NH_3D
   , m_profileIdc( -1 )
@@ -664,6 +691,25 @@ public:
   Void      setUseDisparitySearchRangeRestriction ( Bool   b )      { m_bUseDisparitySearchRangeRestriction = b; }
   Void      setVerticalDisparitySearchRange ( Int   i )      { m_iVerticalDisparitySearchRange = i; }
 #endif
+#if NH_3D_IV_MOTION_SEED
+  Void      setUseIvMotionSeed              ( Bool  b )      { m_bUseIvMotionSeed = b; }
+  Void      setIvMotionSeedSearchRange      ( Int   i )      { m_iIvMotionSeedSearchRange = i; }
+#endif
+#if NH_MV_PYRAMID_ME
+  Void      setUsePyramidME                 ( Bool  b )      { m_bUsePyramidME = b; }
+  Void      setPyramidMERefineRange         ( Int   i )      { m_iPyramidMERefineRange = i; }
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  Void      setUseRatePointMotionSeed       ( Bool  b )      { m_bUseRatePointMotionSeed = b; }
+  Void      setRatePointMotionSeedSearchRange( Int  i )      { m_iRatePointMotionSeedSearchRange = i; }
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  Void      setUseSubPelPlaneCache          ( Bool  b )      { m_bUseSubPelPlaneCache = b; }
+#endif
+#if NH_MV_PIC_ANALYSIS
+  Void      setUsePicAnalysis               ( Bool  b )      { m_bUsePicAnalysis = b; }
+  Void      setUsePicAnalysisFastIntra      ( Bool  b )      { m_bUsePicAnalysisFastIntra = b; }
+#endif
 
   //====== Quality control ========
   Void      setMaxDeltaQP                   ( Int   i )      { m_iMaxDeltaQP = i; }
@@ -756,6 +802,25 @@ public:
   Bool      getUseDisparitySearchRangeRestriction ()      { return  m_bUseDisparitySearchRangeRestriction; }
   Int       getVerticalDisparitySearchRange ()            { return  m_iVerticalDisparitySearchRange; }
 #endif
+#if NH_3D_IV_MOTION_SEED
+  Bool      getUseIvMotionSeed              ()            { return  m_bUseIvMotionSeed; }
+  Int       getIvMotionSeedSearchRange      ()            { return  m_iIvMotionSeedSearchRange; }
+#endif
+#if NH_MV_PYRAMID_ME
+  Bool      getUsePyramidME                 ()            { return  m_bUsePyramidME; }
+  Int       getPyramidMERefineRange         ()            { return  m_iPyramidMERefineRange; }
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  Bool      getUseRatePointMotionSeed       ()            { return  m_bUseRatePointMotionSeed; }
+  Int       getRatePointMotionSeedSearchRange()           { return  m_iRatePointMotionSeedSearchRange; }
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  Bool      getUseSubPelPlaneCache          ()            { return  m_bUseSubPelPlaneCache; }
+#endif
+#if NH_MV_PIC_ANALYSIS
+  Bool      getUsePicAnalysis               ()            { return  m_bUsePicAnalysis; }
+  Bool      getUsePicAnalysisFastIntra      ()            { return  m_bUsePicAnalysisFastIntra; }
+#endif
 
   //==== Quality control ========
   Int       getMaxDeltaQP                   ()      { return  m_iMaxDeltaQP; }
@@ -893,6 +958,8 @@ public:
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   Void  setBufferingPeriodSEIEnabled(Bool b)                         { m_bufferingPeriodSEIEnabled = b; }
   Bool  getBufferingPeriodSEIEnabled() const                         { return m_bufferingPeriodSEIEnabled; }
+  Void  setBufferingPeriodConcatenationFlag(Bool b)                  { m_bufferingPeriodConcatenationFlag = b; }
+  Bool  getBufferingPeriodConcatenationFlag() const                  { return m_bufferingPeriodConcatenationFlag; }
   Void  setPictureTimingSEIEnabled(Bool b)                           { m_pictureTimingSEIEnabled = b; }
   Bool  getPictureTimingSEIEnabled() const                           { return m_pictureTimingSEIEnabled; }
   Void  setRecoveryPointSEIEnabled(Bool b)                           { m_recoveryPointSEIEnabled = b; }
@@ -1249,6 +1316,8 @@ public:
   Void      setUseEstimatedVSD              ( Bool  b )     { m_bUseEstimatedVSD = b; }
   Double    getDispCoeff                    ()              { return m_dDispCoeff;    }
   Void      setDispCoeff                    ( Double  d )   { m_dDispCoeff  = d; }
+  Bool      getVSOIncrementalSetup          ()              { return m_bVSOIncrementalSetup; }
+  Void      setVSOIncrementalSetup          ( Bool  b )     { m_bVSOIncrementalSetup = b; }
 #endif // NH_3D_VSO
 #if NH_3D
   Bool      getUseDMM                       ()        { return m_useDMM; }
@@ -1264,6 +1333,12 @@ public:
   Void      setUseQTL                       ( Bool b ) { m_bUseQTL = b;    }
   Bool      getUseQTL                       ()         { return m_bUseQTL; }
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  Void      setUseTexGuidedDepthMD          ( Bool b ) { m_bUseTexGuidedDepthMD = b;    }
+  Bool      getUseTexGuidedDepthMD          ()         { return m_bUseTexGuidedDepthMD; }
+  Void      setTexGuidedDepthEdgeThr        ( Int  i ) { m_iTexGuidedDepthEdgeThr = i;  }
+  Int       getTexGuidedDepthEdgeThr        ()         { return m_iTexGuidedDepthEdgeThr; }
+#endif
 #if NH_3D
 
   Void      setProfileIdc( Int a )    { assert( a == 1 || a == 6 || a == 8 ); m_profileIdc = a;  }
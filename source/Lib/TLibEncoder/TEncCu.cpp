@@ -276,6 +276,9 @@ Void TEncCu::init( TEncTop* pcEncTop )
  */
 Void TEncCu::compressCtu( TComDataCU* pCtu )
 {
+#if NH_3D_SCRATCH_ARENA
+  m_pcPredSearch->getScratchArena().reset();
+#endif
   // initialize CU data
   m_ppcBestCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
   m_ppcTempCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
@@ -435,6 +438,16 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   Bool bTry2NxN           = true;
   Bool bTryNx2N           = true;
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  UChar uhTexFlags        = TEX_ALL;
+  if( depthMapDetect && m_pcEncCfg->getUseTexGuidedDepthMD() && rpcBestCU->getSlice()->getIsDepth() && pcTexture->getReconMark() )
+  {
+    uhTexFlags = pcTexture->getTextureAnalysis( rpcBestCU->getCUPelX(), rpcBestCU->getCUPelY(), rpcBestCU->getWidth( 0 ), rpcBestCU->getHeight( 0 ) );
+  }
+#endif
+#if NH_MV_PIC_ANALYSIS
+  const Bool bTemporallyPredictable = m_pcEncCfg->getUsePicAnalysisFastIntra() && rpcBestCU->getSlice()->getSliceType() != I_SLICE && xIsTemporallyPredictable( rpcBestCU );
+#endif
 
   // get Original YUV data from picture
   m_ppcOrigYuv[uiDepth]->copyFromPicYuv( pcPic->getPicYuvOrg(), rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu() );
@@ -1097,7 +1110,11 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         // speedup for inter frames
 
         if((rpcBestCU->getSlice()->getSliceType() == I_SLICE)                                     ||
-           ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) && (
+           ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) &&
+#if NH_MV_PIC_ANALYSIS
+           !bTemporallyPredictable &&
+#endif
+           (
            (rpcBestCU->getCbf( 0, COMPONENT_Y  ) != 0)                                            ||
           ((rpcBestCU->getCbf( 0, COMPONENT_Cb ) != 0) && (numberValidComponents > COMPONENT_Cb)) ||
           ((rpcBestCU->getCbf( 0, COMPONENT_Cr ) != 0) && (numberValidComponents > COMPONENT_Cr))   // avoid very complex intra if it is unlikely
@@ -1118,6 +1135,13 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
               bOnlyIVP = true;
               bUseIVP = rpcBestCU->getSlice()->getIntraContourFlag();
             }
+#if NH_3D_TEX_GUIDED_MD
+            if( rpcBestCU->getSlice()->getSliceType() != I_SLICE && !( uhTexFlags & TEX_EDGE ) )
+            {
+              // without a texture edge the contour mode has nothing to follow, and where the texture was skipped intra rarely beats inter prediction
+              bUseIVP = bUseIVP && !bOnlyIVP && ( uhTexFlags & TEX_CODED ) != 0;
+            }
+#endif
             if( bUseIVP )
             {
               xCheckRDCostIntra( rpcBestCU, rpcTempCU, SIZE_2Nx2N DEBUG_STRING_PASS_INTO(sDebug), bOnlyIVP );
@@ -1139,7 +1163,11 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
               if(bTrySplit)
               {
 #endif
-            if( rpcTempCU->getWidth(0) > ( 1 << sps.getQuadtreeTULog2MinSize() ) )
+            if( rpcTempCU->getWidth(0) > ( 1 << sps.getQuadtreeTULog2MinSize() )
+#if NH_3D_TEX_GUIDED_MD
+                && ( uhTexFlags & TEX_EDGE )
+#endif
+              )
             {
 #if NH_3D_ENC_DEPTH
               xCheckRDCostIntra( rpcBestCU, rpcTempCU, SIZE_NxN DEBUG_STRING_PASS_INTO(sDebug), bOnlyIVP );
@@ -1754,6 +1782,23 @@ Int  TEncCu::updateCtuDataISlice(TComDataCU* pCtu, Int width, Int height)
   Int  xBl, yBl;
   const Int iBlkSize = 8;
 
+#if NH_MV_PIC_ANALYSIS
+  TEncPic* pcEPic = dynamic_cast<TEncPic*>( pCtu->getPic() );
+  if ( pcEPic != NULL && pcEPic->hasBlockAnalysis() )
+  {
+    // the intra costs of the complete 8x8 blocks were computed when the picture was received
+    Int iSumHad = 0;
+    for ( yBl=0; (yBl+iBlkSize)<=height; yBl+= iBlkSize)
+    {
+      for ( xBl=0; (xBl+iBlkSize)<=width; xBl+= iBlkSize)
+      {
+        iSumHad += pcEPic->getBlockAnalysis( ( pCtu->getCUPelX() + xBl ) >> 3, ( pCtu->getCUPelY() + yBl ) >> 3 )->m_uiIntraHad;
+      }
+    }
+    return(iSumHad);
+  }
+#endif
+
   Pel* pOrgInit   = pCtu->getPic()->getPicYuvOrg()->getAddr(COMPONENT_Y, pCtu->getCtuRsAddr(), 0);
   Int  iStrideOrig = pCtu->getPic()->getPicYuvOrg()->getStride(COMPONENT_Y);
   Pel  *pOrg;
@@ -1770,6 +1815,42 @@ Int  TEncCu::updateCtuDataISlice(TComDataCU* pCtu, Int width, Int height)
   return(iSumHad);
 }
 
+#if NH_MV_PIC_ANALYSIS
+/** Check whether the source of a CU is well predicted from the previous input picture, which makes intra modes unlikely to win
+ * \param pcCU CU to be checked
+ * \returns true if the inter Hadamard cost of all covered 8x8 blocks is far below their intra Hadamard cost
+ */
+Bool TEncCu::xIsTemporallyPredictable( TComDataCU* pcCU )
+{
+  TEncPic* pcEPic = dynamic_cast<TEncPic*>( pcCU->getPic() );
+  if ( pcEPic == NULL || !pcEPic->hasBlockAnalysis() )
+  {
+    return false;
+  }
+
+  const Int iBlkX0 = pcCU->getCUPelX() >> 3;
+  const Int iBlkY0 = pcCU->getCUPelY() >> 3;
+  const Int iBlkX1 = min( pcEPic->getNumBlkInWidth (), Int( ( pcCU->getCUPelX() + pcCU->getWidth ( 0 ) ) >> 3 ) );
+  const Int iBlkY1 = min( pcEPic->getNumBlkInHeight(), Int( ( pcCU->getCUPelY() + pcCU->getHeight( 0 ) ) >> 3 ) );
+  UInt64 uiIntraHad = 0;
+  UInt64 uiInterHad = 0;
+  for ( Int iBlkY = iBlkY0; iBlkY < iBlkY1; iBlkY++ )
+  {
+    for ( Int iBlkX = iBlkX0; iBlkX < iBlkX1; iBlkX++ )
+    {
+      const TEncBlockAnalysis* pcBlk = pcEPic->getBlockAnalysis( iBlkX, iBlkY );
+      if ( pcBlk->m_uiInterHad == MAX_UINT )
+      {
+        return false;
+      }
+      uiIntraHad += pcBlk->m_uiIntraHad;
+      uiInterHad += pcBlk->m_uiInterHad;
+    }
+  }
+  return uiInterHad * 4 < uiIntraHad;
+}
+#endif
+
 /** check RD costs for a CU block encoded with merge
  * \param rpcBestCU
  * \param rpcTempCU
@@ -1828,9 +1909,15 @@ Void TEncCu::xCheckRDCostMerge2Nx2N( TComDataCU*& rpcBestCU, TComDataCU*& rpcTem
   memset(bSPIVMPFlag, false, sizeof(Bool)*MRG_MAX_NUM_CANDS_MEM);
   TComMvField*  pcMvFieldSP;
   UChar* puhInterDirSP;
+#if NH_3D_SCRATCH_ARENA
+  TComArenaScope cArenaScope( m_pcPredSearch->getScratchArena() );
+  pcMvFieldSP   = m_pcPredSearch->getScratchArena().alloc<TComMvField>( rpcTempCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2 );
+  puhInterDirSP = m_pcPredSearch->getScratchArena().alloc<UChar>      ( rpcTempCU->getPic()->getPicSym()->getNumPartitionsInCtu()   );
+#else
   pcMvFieldSP = new TComMvField[rpcTempCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2]; 
   puhInterDirSP = new UChar[rpcTempCU->getPic()->getPicSym()->getNumPartitionsInCtu()]; 
 #endif
+#endif
 
 #if NH_3D_VSP
 #if !NH_3D_ARP
@@ -2243,7 +2330,7 @@ Void TEncCu::xCheckRDCostMerge2Nx2N( TComDataCU*& rpcBestCU, TComDataCU*& rpcTem
 #if NH_3D_ARP
  }
 #endif
-#if NH_3D_SPIVMP
+#if NH_3D_SPIVMP && !NH_3D_SCRATCH_ARENA
  delete[] pcMvFieldSP;
  delete[] puhInterDirSP;
 #endif
@@ -2604,7 +2691,13 @@ Void TEncCu::xCheckRDCostInterDBBP( TComDataCU*& rpcBestCU, TComDataCU*& rpcTemp
   PartSize eVirtualPartSize = m_pcPredSearch->getPartitionSizeFromDepth(pDepthPels, uiDepthStride, uiWidth, rpcTempCU);
 
   // derive partitioning from depth
+#if NH_3D_SCRATCH_ARENA
+  // the mask is addressed with a stride of MAX_CU_SIZE
+  TComArenaScope cArenaScope( m_pcPredSearch->getScratchArena() );
+  Bool* pMask = m_pcPredSearch->getScratchArena().alloc<Bool>( MAX_CU_SIZE*uiHeight );
+#else
   Bool pMask[MAX_CU_SIZE*MAX_CU_SIZE];
+#endif
   Bool bValidMask = m_pcPredSearch->getSegmentMaskFromDepth(pDepthPels, uiDepthStride, uiWidth, uiHeight, pMask, rpcTempCU);
   
   if( !bValidMask )
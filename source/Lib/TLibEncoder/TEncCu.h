@@ -57,6 +57,10 @@ class TEncSbac;
 class TEncCavlc;
 class TEncSlice;
 
+#if NH_MV_PIC_ANALYSIS
+Int xCalcHADs8x8_ISlice( Pel *piOrg, Int iStrideOrg );
+#endif
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -175,6 +179,9 @@ protected:
   Void  xCheckDQP           ( TComDataCU*  pcCU );
 
   Void  xCheckIntraPCM      ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU                      );
+#if NH_MV_PIC_ANALYSIS
+  Bool  xIsTemporallyPredictable( TComDataCU* pcCU );
+#endif
   Void  xCopyAMVPInfo       ( AMVPInfo* pSrc, AMVPInfo* pDst );
   Void  xCopyYuv2Pic        (TComPic* rpcPic, UInt uiCUAddr, UInt uiAbsPartIdx, UInt uiDepth, UInt uiSrcDepth );
   Void  xCopyYuv2Tmp        ( UInt uhPartUnitIdx, UInt uiDepth );
@@ -1530,7 +1530,11 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     std::vector< Bool     >    usedAsLongTerm [2];
     Int       numPocTotalCurr;
 
+#if NH_MV_DPB_POC_INDEX
+    pcSlice->getTempRefPicLists( *m_ivPicLists->getSubDpb( getLayerId(), false ), m_refPicSetInterLayer0, m_refPicSetInterLayer1, tempRefPicLists, usedAsLongTerm, numPocTotalCurr, true );
+#else
     pcSlice->getTempRefPicLists( rcListPic, m_refPicSetInterLayer0, m_refPicSetInterLayer1, tempRefPicLists, usedAsLongTerm, numPocTotalCurr, true );
+#endif
 
 
     xSetRefPicListModificationsMv( tempRefPicLists, pcSlice, iGOPid );
@@ -2205,6 +2209,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
     pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
 
+#if NH_3D_TEX_GUIDED_MD
+    if ( m_pcCfg->getUseTexGuidedDepthMD() && !getIsDepth() )
+    {
+      pcPic->buildTextureAnalysis( m_pcCfg->getTexGuidedDepthEdgeThr() );
+    }
+#endif
     pcPic->setReconMark   ( true );
 #if NH_MV
       TComSlice::markIvRefPicsAsShortTerm( m_refPicSetInterLayer0, m_refPicSetInterLayer1 );
@@ -2538,7 +2548,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
     unsigned int maxval = 255 * (1<<(g_uiBitDepth + g_uiBitIncrement -8));
     Double fRefValueY = (double) maxval * maxval * iSize;
     Double fRefValueC = fRefValueY / 4.0;
-    TRenModel*  pcRenModel = m_pcEncTop->getEncTop()->getRenModel();
+    TRenModel*  pcRenModel = m_pcRdCost->getRenModel();
     Int64 iDistVSOY, iDistVSOU, iDistVSOV;
     pcRenModel->getTotalSSE( iDistVSOY, iDistVSOU, iDistVSOV );
     dYPSNR = ( iDistVSOY ? 10.0 * log10( fRefValueY / (Double) iDistVSOY ) : 99.99 );
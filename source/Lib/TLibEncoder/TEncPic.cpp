@@ -105,6 +105,11 @@ Void TEncPicQPAdaptationLayer::destroy()
 TEncPic::TEncPic()
 : m_acAQLayer(NULL)
 , m_uiMaxAQDepth(0)
+#if NH_MV_PIC_ANALYSIS
+, m_acBlockAnalysis(NULL)
+, m_iNumBlkInWidth(0)
+, m_iNumBlkInHeight(0)
+#endif
 {
 }
 
@@ -139,6 +144,51 @@ Void TEncPic::create( const TComSPS &sps, const TComPPS &pps, UInt uiMaxAdaptive
   }
 }
 
+#if NH_MV_PIC_ANALYSIS
+/** Allocate the 8x8 block analysis map, covering all complete 8x8 luma blocks of the picture
+ */
+Void TEncPic::createBlockAnalysis()
+{
+  if ( m_acBlockAnalysis == NULL )
+  {
+    m_iNumBlkInWidth  = getPicYuvOrg()->getWidth ( COMPONENT_Y ) >> 3;
+    m_iNumBlkInHeight = getPicYuvOrg()->getHeight( COMPONENT_Y ) >> 3;
+    m_acBlockAnalysis = new TEncBlockAnalysis[ m_iNumBlkInWidth * m_iNumBlkInHeight ];
+  }
+}
+#endif
+
+#if NH_MV
+/** Copy the image characteristics of the same original picture analysed by an encoder with the same configuration
+ * \param pcSrcPic picture of that encoder
+ */
+Void TEncPic::copyAnalysis( TEncPic* pcSrcPic )
+{
+  for ( UInt d = 0; d < m_uiMaxAQDepth; d++ )
+  {
+    TEncPicQPAdaptationLayer* pcSrcLayer = pcSrcPic->getAQLayer( d );
+    TEncQPAdaptationUnit*     pcSrcAQU   = pcSrcLayer->getQPAdaptationUnit();
+    TEncQPAdaptationUnit*     pcDstAQU   = m_acAQLayer[d].getQPAdaptationUnit();
+    const UInt uiNumAQPart = m_acAQLayer[d].getNumAQPartInWidth() * m_acAQLayer[d].getNumAQPartInHeight();
+    for ( UInt i = 0; i < uiNumAQPart; i++ )
+    {
+      pcDstAQU[i].setActivity( pcSrcAQU[i].getActivity() );
+    }
+    m_acAQLayer[d].setAvgActivity( pcSrcLayer->getAvgActivity() );
+  }
+#if NH_MV_PIC_ANALYSIS
+  if ( pcSrcPic->hasBlockAnalysis() )
+  {
+    createBlockAnalysis();
+    for ( Int i = 0; i < m_iNumBlkInWidth * m_iNumBlkInHeight; i++ )
+    {
+      m_acBlockAnalysis[i] = pcSrcPic->m_acBlockAnalysis[i];
+    }
+  }
+#endif
+}
+#endif
+
 //! Clean up
 Void TEncPic::destroy()
 {
@@ -147,6 +197,13 @@ Void TEncPic::destroy()
     delete[] m_acAQLayer;
     m_acAQLayer = NULL;
   }
+#if NH_MV_PIC_ANALYSIS
+  if (m_acBlockAnalysis)
+  {
+    delete[] m_acBlockAnalysis;
+    m_acBlockAnalysis = NULL;
+  }
+#endif
   TComPic::destroy();
 }
 //! \}
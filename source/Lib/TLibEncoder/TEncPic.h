@@ -91,12 +91,29 @@ public:
   Void                   setAvgActivity( Double d )  { m_dAvgActivity = d; }
 };
 
+#if NH_MV_PIC_ANALYSIS
+/// Source characteristics of an 8x8 luma block
+struct TEncBlockAnalysis
+{
+  UInt   m_uiIntraHad;    ///< Hadamard cost of the source block without the DC coefficient
+  UInt   m_uiSum;         ///< sum of the source samples
+  UInt   m_uiSumSq;       ///< sum of the squared source samples
+  UInt   m_uiInterHad;    ///< Hadamard cost of the best match in the previous input picture, MAX_UINT if there is none
+  TComMv m_cMv;           ///< integer displacement of that match
+};
+#endif
+
 /// Picture class including local image characteristics information for QP adaptation
 class TEncPic : public TComPic
 {
 private:
   TEncPicQPAdaptationLayer* m_acAQLayer;
   UInt                      m_uiMaxAQDepth;
+#if NH_MV_PIC_ANALYSIS
+  TEncBlockAnalysis*        m_acBlockAnalysis;
+  Int                       m_iNumBlkInWidth;
+  Int                       m_iNumBlkInHeight;
+#endif
 
 public:
   TEncPic();
@@ -107,6 +124,16 @@ public:
 
   TEncPicQPAdaptationLayer* getAQLayer( UInt uiDepth )  { return &m_acAQLayer[uiDepth]; }
   UInt                      getMaxAQDepth()             { return m_uiMaxAQDepth;        }
+#if NH_MV
+  Void                      copyAnalysis( TEncPic* pcSrcPic );
+#endif
+#if NH_MV_PIC_ANALYSIS
+  Void                      createBlockAnalysis();
+  Bool                      hasBlockAnalysis()          { return m_acBlockAnalysis != NULL; }
+  Int                       getNumBlkInWidth()          { return m_iNumBlkInWidth;      }
+  Int                       getNumBlkInHeight()         { return m_iNumBlkInHeight;     }
+  TEncBlockAnalysis*        getBlockAnalysis( Int iBlkX, Int iBlkY ) { return &m_acBlockAnalysis[ iBlkY * m_iNumBlkInWidth + iBlkX ]; }
+#endif
 };
 
 //! \}
@@ -39,6 +39,9 @@
 #include <algorithm>
 
 #include "TEncPreanalyzer.h"
+#if NH_MV_PIC_ANALYSIS
+#include "TEncCu.h"
+#endif
 
 using namespace std;
 
@@ -86,6 +89,15 @@ Void TEncPreanalyzer::xPreanalyze( TEncPic* pcEPic )
         const Pel* pBlkY = &pLineY[x];
         UInt64 uiSum[4] = {0, 0, 0, 0};
         UInt64 uiSumSq[4] = {0, 0, 0, 0};
+#if NH_MV_PIC_ANALYSIS
+        if ( pcEPic->hasBlockAnalysis() && (uiCurrAQPartWidth & 15) == 0 && (uiCurrAQPartHeight & 15) == 0 )
+        {
+          // quadrants consist of complete 8x8 blocks, take their moments from the block analysis
+          xGetQuadrantMoments( pcEPic, x, y, uiCurrAQPartWidth>>1, uiCurrAQPartHeight>>1, uiSum, uiSumSq );
+        }
+        else
+        {
+#endif
         UInt by = 0;
         for ( ; by < uiCurrAQPartHeight>>1; by++ )
         {
@@ -117,6 +129,9 @@ Void TEncPreanalyzer::xPreanalyze( TEncPic* pcEPic )
           }
           pBlkY += iStride;
         }
+#if NH_MV_PIC_ANALYSIS
+        }
+#endif
 
         assert ((uiCurrAQPartWidth&1)==0);
         assert ((uiCurrAQPartHeight&1)==0);
@@ -149,5 +164,172 @@ Void TEncPreanalyzer::xPreanalyze( TEncPic* pcEPic )
     pcAQLayer->setAvgActivity( dAvgAct );
   }
 }
+
+#if NH_MV_PIC_ANALYSIS
+static inline UInt xGetSAD8x8( const Pel* pOrg, const Pel* pRef, Int iStride )
+{
+  UInt uiSad = 0;
+  for ( Int y = 0; y < 8; y++ )
+  {
+    for ( Int x = 0; x < 8; x++ )
+    {
+      uiSad += abs( pOrg[x] - pRef[x] );
+    }
+    pOrg += iStride;
+    pRef += iStride;
+  }
+  return uiSad;
+}
+
+/** Analyze source picture on 8x8 luma blocks: intra Hadamard cost, sample moments and best match in the previous input picture
+ * \param pcEPic    Picture object to be analyzed
+ * \param pcPrevPic Previous input picture of the same layer, NULL if there is none
+ * \return Void
+ */
+Void TEncPreanalyzer::xAnalyzeBlocks( TEncPic* pcEPic, TComPic* pcPrevPic )
+{
+  pcEPic->createBlockAnalysis();
+
+  TComPicYuv* pcPicYuv = pcEPic->getPicYuvOrg();
+  const Int iStride = pcPicYuv->getStride(COMPONENT_Y);
+  const Pel* pRef   = NULL;
+  if ( pcPrevPic != NULL && pcPrevPic->getPicYuvOrg()->getStride(COMPONENT_Y) == iStride )
+  {
+    pRef = pcPrevPic->getPicYuvOrg()->getAddr(COMPONENT_Y);
+  }
+
+  for ( Int iBlkY = 0; iBlkY < pcEPic->getNumBlkInHeight(); iBlkY++ )
+  {
+    for ( Int iBlkX = 0; iBlkX < pcEPic->getNumBlkInWidth(); iBlkX++ )
+    {
+      TEncBlockAnalysis* pcBlk = pcEPic->getBlockAnalysis( iBlkX, iBlkY );
+      Pel* pBlkY = pcPicYuv->getAddr(COMPONENT_Y) + (iBlkY<<3) * iStride + (iBlkX<<3);
+
+      pcBlk->m_uiIntraHad = xCalcHADs8x8_ISlice( pBlkY, iStride );
+      pcBlk->m_uiSum      = 0;
+      pcBlk->m_uiSumSq    = 0;
+      for ( Int by = 0; by < 8; by++ )
+      {
+        for ( Int bx = 0; bx < 8; bx++ )
+        {
+          pcBlk->m_uiSum   += pBlkY[by*iStride+bx];
+          pcBlk->m_uiSumSq += pBlkY[by*iStride+bx] * pBlkY[by*iStride+bx];
+        }
+      }
+
+      if ( pRef != NULL )
+      {
+        xSearchBlock( pcEPic, iBlkX, iBlkY, pRef );
+      }
+      else
+      {
+        pcBlk->m_uiInterHad = MAX_UINT;
+        pcBlk->m_cMv.setZero();
+      }
+    }
+  }
+}
+
+/** Integer motion search of an 8x8 block in the previous input picture. The best of the zero vector and the vectors of
+ *  the left and above blocks is refined by a diamond search with step sizes 4, 2 and 1.
+ */
+Void TEncPreanalyzer::xSearchBlock( TEncPic* pcEPic, Int iBlkX, Int iBlkY, const Pel* pRef )
+{
+  static const Int aiDiamond[4][2] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+  const Int iSearchRange = 32;
+  const Int iMaxIter     = 8;
+
+  TComPicYuv* pcPicYuv = pcEPic->getPicYuvOrg();
+  const Int iStride  = pcPicYuv->getStride(COMPONENT_Y);
+  const Int iPosX    = iBlkX << 3;
+  const Int iPosY    = iBlkY << 3;
+  const Int iMinX    = max( -iSearchRange, -iPosX );
+  const Int iMaxX    = min(  iSearchRange, pcPicYuv->getWidth (COMPONENT_Y) - 8 - iPosX );
+  const Int iMinY    = max( -iSearchRange, -iPosY );
+  const Int iMaxY    = min(  iSearchRange, pcPicYuv->getHeight(COMPONENT_Y) - 8 - iPosY );
+  const Pel* pOrg    = pcPicYuv->getAddr(COMPONENT_Y) + iPosY * iStride + iPosX;
+  const Pel* pRefBlk = pRef + iPosY * iStride + iPosX;
+
+  TComMv acCand[3];
+  Int    iNumCand = 0;
+  acCand[iNumCand++].setZero();
+  if ( iBlkX > 0 )
+  {
+    acCand[iNumCand++] = pcEPic->getBlockAnalysis( iBlkX - 1, iBlkY )->m_cMv;
+  }
+  if ( iBlkY > 0 )
+  {
+    acCand[iNumCand++] = pcEPic->getBlockAnalysis( iBlkX, iBlkY - 1 )->m_cMv;
+  }
+
+  Int  iBestX    = 0;
+  Int  iBestY    = 0;
+  UInt uiBestSad = MAX_UINT;
+  for ( Int i = 0; i < iNumCand; i++ )
+  {
+    const Int x = Clip3( iMinX, iMaxX, Int( acCand[i].getHor() ) );
+    const Int y = Clip3( iMinY, iMaxY, Int( acCand[i].getVer() ) );
+    const UInt uiSad = xGetSAD8x8( pOrg, pRefBlk + y * iStride + x, iStride );
+    if ( uiSad < uiBestSad )
+    {
+      uiBestSad = uiSad;
+      iBestX    = x;
+      iBestY    = y;
+    }
+  }
+
+  for ( Int iStep = 4; iStep > 0; iStep >>= 1 )
+  {
+    Bool bMoved = true;
+    for ( Int iIter = 0; bMoved && iIter < iMaxIter; iIter++ )
+    {
+      bMoved = false;
+      const Int iCentX = iBestX;
+      const Int iCentY = iBestY;
+      for ( Int i = 0; i < 4; i++ )
+      {
+        const Int x = iCentX + aiDiamond[i][0] * iStep;
+        const Int y = iCentY + aiDiamond[i][1] * iStep;
+        if ( x < iMinX || x > iMaxX || y < iMinY || y > iMaxY )
+        {
+          continue;
+        }
+        const UInt uiSad = xGetSAD8x8( pOrg, pRefBlk + y * iStride + x, iStride );
+        if ( uiSad < uiBestSad )
+        {
+          uiBestSad = uiSad;
+          iBestX    = x;
+          iBestY    = y;
+          bMoved    = true;
+        }
+      }
+    }
+  }
+
+  TEncBlockAnalysis* pcBlk = pcEPic->getBlockAnalysis( iBlkX, iBlkY );
+  pcBlk->m_cMv.set( iBestX, iBestY );
+  pcBlk->m_uiInterHad = m_cRdCost.calcHAD( pcEPic->getPicSym()->getSPS().getBitDepth( CHANNEL_TYPE_LUMA ), pOrg, iStride, pRefBlk + iBestY * iStride + iBestX, iStride, 8, 8 );
+}
+
+/** Sum the moments of the 8x8 blocks in the four quadrants of an AQ part
+ */
+Void TEncPreanalyzer::xGetQuadrantMoments( TEncPic* pcEPic, Int iPosX, Int iPosY, Int iQuadWidth, Int iQuadHeight, UInt64* puiSum, UInt64* puiSumSq )
+{
+  for ( Int iQuad = 0; iQuad < 4; iQuad++ )
+  {
+    const Int iBlkX0 = ( iPosX + ( iQuad & 1 ) * iQuadWidth  ) >> 3;
+    const Int iBlkY0 = ( iPosY + ( iQuad >> 1 ) * iQuadHeight ) >> 3;
+    for ( Int iBlkY = iBlkY0; iBlkY < iBlkY0 + ( iQuadHeight >> 3 ); iBlkY++ )
+    {
+      for ( Int iBlkX = iBlkX0; iBlkX < iBlkX0 + ( iQuadWidth >> 3 ); iBlkX++ )
+      {
+        const TEncBlockAnalysis* pcBlk = pcEPic->getBlockAnalysis( iBlkX, iBlkY );
+        puiSum  [iQuad] += pcBlk->m_uiSum;
+        puiSumSq[iQuad] += pcBlk->m_uiSumSq;
+      }
+    }
+  }
+}
+#endif
 //! \}
 
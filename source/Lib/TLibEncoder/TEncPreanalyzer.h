@@ -39,6 +39,9 @@
 #define __TENCPREANALYZER__
 
 #include "TEncPic.h"
+#if NH_MV_PIC_ANALYSIS
+#include "TLibCommon/TComRdCost.h"
+#endif
 
 //! \ingroup TLibEncoder
 //! \{
@@ -55,6 +58,15 @@ public:
   virtual ~TEncPreanalyzer();
 
   Void xPreanalyze( TEncPic* pcPic );
+#if NH_MV_PIC_ANALYSIS
+  Void xAnalyzeBlocks( TEncPic* pcEPic, TComPic* pcPrevPic );
+
+private:
+  Void xSearchBlock       ( TEncPic* pcEPic, Int iBlkX, Int iBlkY, const Pel* pRef );
+  Void xGetQuadrantMoments( TEncPic* pcEPic, Int iPosX, Int iPosY, Int iQuadWidth, Int iQuadHeight, UInt64* puiSum, UInt64* puiSumSq );
+
+  TComRdCost m_cRdCost;
+#endif
 };
 
 //! \}
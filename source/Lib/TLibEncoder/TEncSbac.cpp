@@ -50,6 +50,8 @@
 //! \ingroup TLibEncoder
 //! \{
 
+UInt64 TEncSbac::m_numContextSnapshots = 0;
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -119,6 +121,7 @@ TEncSbac::TEncSbac()
 #endif
 {
   assert( m_numContextModels <= MAX_NUM_CTX_MOD );
+  xNewContextSnapshot();
 }
 
 TEncSbac::~TEncSbac()
@@ -204,6 +207,8 @@ Void TEncSbac::resetEntropy           (const TComSlice *pSlice)
     m_golombRiceAdaptationStatistics[statisticIndex] = 0;
   }
 
+  xNewContextSnapshot();
+
   m_pcBinIf->start();
 
   return;
@@ -502,6 +507,49 @@ Void TEncSbac::xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool
     m_pcBinIf->encodeBinsEP(codeNumber,length);
   }
 }
+/** Number of bins of coeff_abs_level_remaining as written by xWriteCoefRemainExGolomb.
+ * \param symbol                 value to code
+ * \param rParam                 Rice parameter
+ * \param useLimitedPrefixLength limited prefix length (extended precision processing)
+ * \param maxLog2TrDynamicRange  log2 of the coefficient dynamic range
+ * \returns number of bypass bins
+ */
+UInt TEncSbac::xGetCoefRemainNumBins ( UInt symbol, UInt rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange )
+{
+  if (symbol < (COEF_REMAIN_BIN_REDUCTION << rParam))
+  {
+    return (symbol >> rParam) + 1 + rParam;
+  }
+  else if (useLimitedPrefixLength)
+  {
+    const UInt maximumPrefixLength = (32 - (COEF_REMAIN_BIN_REDUCTION + maxLog2TrDynamicRange));
+    const UInt codeValue           = (symbol >> rParam) - COEF_REMAIN_BIN_REDUCTION;
+
+    if (codeValue >= ((1 << maximumPrefixLength) - 1))
+    {
+      return maximumPrefixLength + COEF_REMAIN_BIN_REDUCTION + maxLog2TrDynamicRange;
+    }
+
+    UInt prefixLength = 0;
+    while (codeValue > ((2 << prefixLength) - 2))
+    {
+      prefixLength++;
+    }
+    return COEF_REMAIN_BIN_REDUCTION + 2 * prefixLength + 1 + rParam;
+  }
+  else
+  {
+    UInt length     = rParam;
+    UInt codeNumber = symbol - (COEF_REMAIN_BIN_REDUCTION << rParam);
+
+    while (codeNumber >= (1u << length))
+    {
+      codeNumber -= (1u << (length++));
+    }
+    return COEF_REMAIN_BIN_REDUCTION + 2 * length + 1 - rParam;
+  }
+}
+
 // SBAC RD
 Void  TEncSbac::load ( const TEncSbac* pSrc)
 {
@@ -514,10 +562,12 @@ Void  TEncSbac::loadIntraDirMode( const TEncSbac* pSrc, const ChannelType chType
   if (isLuma(chType))
   {
     this->m_cCUIntraPredSCModel      .copyFrom( &pSrc->m_cCUIntraPredSCModel       );
+    xMarkContextsModified( m_cCUIntraPredSCModel.get( 0 ), NUM_INTRA_PREDICT_CTX );
   }
   else
   {
     this->m_cCUChromaPredSCModel     .copyFrom( &pSrc->m_cCUChromaPredSCModel      );
+    xMarkContextsModified( m_cCUChromaPredSCModel.get( 0 ), NUM_CHROMA_PRED_CTX );
   }
 }
 
@@ -527,6 +577,8 @@ Void TEncSbac::loadIntraDepthDmm( const TEncSbac* pSrc )
   m_pcBinIf->copyState( pSrc->m_pcBinIf );
   this->m_cNotDmmFlagSCModel.copyFrom( &pSrc->m_cNotDmmFlagSCModel );
   this->m_cDmmModeSCModel   .copyFrom( &pSrc->m_cDmmModeSCModel );
+  xMarkContextsModified( m_cNotDmmFlagSCModel.get( 0 ), NUM_NOTDMM_FLAG_CTX );
+  xMarkContextsModified( m_cDmmModeSCModel.get( 0 ),    NUM_DMM_MODE_CTX );
 }
 #endif
 
@@ -1789,6 +1841,9 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
 
   const Int  iLastScanSet  = scanPosLast >> MLS_CG_SIZE;
 
+  // when only the number of bits is estimated, the bypass bins of a coefficient group are counted and added in one call
+  const Bool bCountBinsEP  = m_pcBinIf->isBitCounter();
+
   UInt c1                  = 1;
   UInt uiGoRiceParam       = 0;
   Int  iScanPosSig         = scanPosLast;
@@ -1922,13 +1977,28 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
         m_pcBinIf->align();
       }
 
+      Int numBinsEP = 0;
       if( beValid && signHidden )
       {
-        m_pcBinIf->encodeBinsEP( (coeffSigns >> 1), numNonZero-1 );
+        if( bCountBinsEP )
+        {
+          numBinsEP = numNonZero-1;
+        }
+        else
+        {
+          m_pcBinIf->encodeBinsEP( (coeffSigns >> 1), numNonZero-1 );
+        }
       }
       else
       {
-        m_pcBinIf->encodeBinsEP( coeffSigns, numNonZero );
+        if( bCountBinsEP )
+        {
+          numBinsEP = numNonZero;
+        }
+        else
+        {
+          m_pcBinIf->encodeBinsEP( coeffSigns, numNonZero );
+        }
       }
 
       Int iFirstCoeff2 = 1;
@@ -1942,7 +2012,14 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
           {
             const UInt escapeCodeValue = absCoeff[idx] - baseLevel;
 
-            xWriteCoefRemainExGolomb( escapeCodeValue, uiGoRiceParam, extendedPrecision, maxLog2TrDynamicRange );
+            if( bCountBinsEP )
+            {
+              numBinsEP += xGetCoefRemainNumBins( escapeCodeValue, uiGoRiceParam, extendedPrecision, maxLog2TrDynamicRange );
+            }
+            else
+            {
+              xWriteCoefRemainExGolomb( escapeCodeValue, uiGoRiceParam, extendedPrecision, maxLog2TrDynamicRange );
+            }
 
             if (absCoeff[idx] > (3 << uiGoRiceParam))
             {
@@ -1972,6 +2049,11 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
           }
         }
       }
+
+      if( bCountBinsEP && numBinsEP > 0 )
+      {
+        m_pcBinIf->encodeBinsEP( 0, numBinsEP );
+      }
     }
   }
 #if ENVIRONMENT_VARIABLE_DEBUG_AND_TEST
@@ -2410,10 +2492,49 @@ Void TEncSbac::estSignificantCoefficientsBit( estBitsSbacStruct* pcEstBitsSbac,
  */
 Void TEncSbac::xCopyContextsFrom( const TEncSbac* pSrc )
 {
-  memcpy(m_contextModels, pSrc->m_contextModels, m_numContextModels*sizeof(m_contextModels[0]));
+  if( m_contextSnapshotId == pSrc->m_contextSnapshotId )
+  {
+    // both context sets derive from the same one: only the chunks changed on either side can differ
+    UInt64 chunks = m_modifiedContextChunks | pSrc->m_modifiedContextChunks;
+    for( UInt firstCtx = 0; chunks != 0; chunks >>= 1, firstCtx += NUM_CTX_MOD_PER_CHUNK )
+    {
+      if( chunks & 1 )
+      {
+        std::copy(pSrc->m_contextModels + firstCtx, pSrc->m_contextModels + firstCtx + NUM_CTX_MOD_PER_CHUNK, m_contextModels + firstCtx);
+      }
+    }
+  }
+  else
+  {
+    memcpy(m_contextModels, pSrc->m_contextModels, m_numContextModels*sizeof(m_contextModels[0]));
+    m_contextSnapshotId = pSrc->m_contextSnapshotId;
+  }
+  m_modifiedContextChunks = pSrc->m_modifiedContextChunks;
   memcpy(m_golombRiceAdaptationStatistics, pSrc->m_golombRiceAdaptationStatistics, (sizeof(UInt) * RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS));
 }
 
+/** Start a new context set from the current contexts.
+ * Context sets are only compared through their snapshot id, so contexts changed outside of encodeBin have to start a new one.
+ */
+Void TEncSbac::xNewContextSnapshot()
+{
+  m_contextSnapshotId     = ++m_numContextSnapshots;
+  m_modifiedContextChunks = 0;
+}
+
+/** Record contexts that have been overwritten without coding a bin.
+ * \param pcCtxModel first context
+ * \param numCtx     number of contexts
+ */
+Void TEncSbac::xMarkContextsModified( const ContextModel* pcCtxModel, UInt numCtx )
+{
+  const UInt firstCtx = UInt( pcCtxModel - m_contextModels );
+  for( UInt ctxIdx = firstCtx; ctxIdx < firstCtx + numCtx; ctxIdx++ )
+  {
+    m_modifiedContextChunks |= UInt64(1) << ( ctxIdx / NUM_CTX_MOD_PER_CHUNK );
+  }
+}
+
 Void  TEncSbac::loadContexts ( const TEncSbac* pSrc)
 {
   xCopyContextsFrom(pSrc);
@@ -69,8 +69,8 @@ public:
   TEncSbac();
   virtual ~TEncSbac();
 
-  Void  init                   ( TEncBinIf* p )  { m_pcBinIf = p; }
-  Void  uninit                 ()                { m_pcBinIf = 0; }
+  Void  init                   ( TEncBinIf* p )  { m_pcBinIf = p; m_pcBinIf->setContextTracking( m_contextModels, &m_modifiedContextChunks ); }
+  Void  uninit                 ()                { if( m_pcBinIf ) { m_pcBinIf->setContextTracking( NULL, NULL ); } m_pcBinIf = 0; }
 
   //  Virtual list
   Void  resetEntropy           (const TComSlice *pSlice);
@@ -114,6 +114,7 @@ private:
   Void  xWriteUnaryMaxSymbol ( UInt uiSymbol, ContextModel* pcSCModel, Int iOffset, UInt uiMaxSymbol );
   Void  xWriteEpExGolomb     ( UInt uiSymbol, UInt uiCount );
   Void  xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange );
+  UInt  xGetCoefRemainNumBins    ( UInt symbol, UInt rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange );
 #if NH_3D_DMM || NH_3D_SDC_INTRA || NH_3D_SDC_INTER
   Void  xWriteExGolombLevelDdc( UInt uiSymbol );
   Void  xCodeDeltaDC         ( Pel valDeltaDC, UInt uiNumSeg );
@@ -127,6 +128,8 @@ private:
 
   Void  xCopyFrom            ( const TEncSbac* pSrc );
   Void  xCopyContextsFrom    ( const TEncSbac* pSrc );
+  Void  xNewContextSnapshot  ();
+  Void  xMarkContextsModified( const ContextModel* pcCtxModel, UInt numCtx );
 
 protected:
   TComBitIf*    m_pcBitIf;
@@ -201,6 +204,9 @@ public:
 private:
   ContextModel         m_contextModels[MAX_NUM_CTX_MOD];
   Int                  m_numContextModels;
+  UInt64               m_contextSnapshotId;       ///< identifies the context set the contexts were derived from
+  UInt64               m_modifiedContextChunks;   ///< chunks of NUM_CTX_MOD_PER_CHUNK contexts changed since that context set
+  static UInt64        m_numContextSnapshots;
   ContextModel3DBuffer m_cCUSplitFlagSCModel;
   ContextModel3DBuffer m_cCUSkipFlagSCModel;
 #if NH_3D_DIS
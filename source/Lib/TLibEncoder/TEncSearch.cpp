@@ -116,6 +116,20 @@ TEncSearch::TEncSearch()
 , m_pppcRDSbacCoder (NULL)
 , m_pcRDGoOnSbacCoder (NULL)
 , m_pTempPel (NULL)
+#if NH_3D_IV_MOTION_SEED
+, m_bIvMotionSeedAvailable (false)
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+, m_pcRatePointSeedPic (NULL)
+, m_bRatePointSeedAvailable (false)
+#endif
+#if NH_MV_PYRAMID_ME
+, m_bPyramidStartAvailable (false)
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+, m_pcSubPelRefPic (NULL)
+, m_iSubPelRoiOffset (0)
+#endif
 , m_isInitialized (false)
 {
   for (UInt ch=0; ch<MAX_NUM_COMPONENT; ch++)
@@ -142,6 +156,12 @@ TEncSearch::TEncSearch()
   {
     memset (m_auiMVPIdxCost[i], 0, (AMVP_MAX_NUM_CANDS+1) * sizeof (UInt) );
   }
+#if NH_MV_PYRAMID_ME
+  for (Int i=0; i<NUM_REF_PIC_LIST_01; i++)
+  {
+    memset (m_abPyramidMv2Nx2NValid[i], 0, MAX_NUM_REF * sizeof (Bool) );
+  }
+#endif
 
   setWpScalingDistParam( NULL, -1, REF_PIC_LIST_X );
 }
@@ -198,6 +218,9 @@ Void TEncSearch::destroy()
   m_pcQTTempTransformSkipTComYuv.destroy();
 
   m_tmpYuvPred.destroy();
+#if NH_3D_VSO && NH_3D_SCRATCH_ARENA
+  m_cYuvRecTemp.destroy();
+#endif
   m_isInitialized = false;
 }
 
@@ -303,6 +326,10 @@ Void TEncSearch::init(TEncCfg*      pcEncCfg,
   }
   m_pcQTTempTransformSkipTComYuv.create( maxCUWidth, maxCUHeight, pcEncCfg->getChromaFormatIdc() );
   m_tmpYuvPred.create(MAX_CU_SIZE, MAX_CU_SIZE, pcEncCfg->getChromaFormatIdc());
+#if NH_3D_VSO && NH_3D_SCRATCH_ARENA
+  // allocated once at CTU size, the buffer is only accessed via partition addresses
+  m_cYuvRecTemp.create( maxCUWidth, maxCUHeight, CHROMA_400 );
+#endif
   m_isInitialized = true;
 }
 
@@ -840,8 +867,13 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
   Distortion  uiDistBest  = std::numeric_limits<Distortion>::max();
   UInt        uiDirecBest = 0;
 
+#if NH_MV_SUBPEL_PLANE_CACHE
+  const Pel*  piRefPos;
+  Int iRefStride = m_pcSubPelRefPic != NULL ? m_pcSubPelRefPic->getStride(COMPONENT_Y) : m_filteredBlock[0][0].getStride(COMPONENT_Y);
+#else
   Pel*  piRefPos;
   Int iRefStride = m_filteredBlock[0][0].getStride(COMPONENT_Y);
+#endif
 
   m_pcRdCost->setDistParam( pcPatternKey, m_filteredBlock[0][0].getAddr(COMPONENT_Y), iRefStride, 1, m_cDistParam, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
 
@@ -854,6 +886,14 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
 
     Int horVal = cMvTest.getHor() * iFrac;
     Int verVal = cMvTest.getVer() * iFrac;
+#if NH_MV_SUBPEL_PLANE_CACHE
+    if ( m_pcSubPelRefPic != NULL )
+    {
+      piRefPos = m_pcSubPelRefPic->getSubPelAddr( verVal & 3, horVal & 3 ) + m_iSubPelRoiOffset + ( verVal >> 2 ) * iRefStride + ( horVal >> 2 );
+    }
+    else
+    {
+#endif
     piRefPos = m_filteredBlock[ verVal & 3 ][ horVal & 3 ].getAddr(COMPONENT_Y);
     if ( horVal == 2 && ( verVal & 1 ) == 0 )
     {
@@ -863,6 +903,9 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
     {
       piRefPos += iRefStride;
     }
+#if NH_MV_SUBPEL_PLANE_CACHE
+    }
+#endif
     cMvTest = pcMvRefine[i];
     cMvTest += rcMvFrac;
 
@@ -2016,6 +2059,9 @@ Void TEncSearch::xIntraCodingSDC( TComDataCU* pcCU, UInt uiAbsPartIdx, TComYuv*
   Bool* pbMask = NULL;
   UInt uiMaskStride = 0;
 #if NH_3D_DMM
+#if NH_3D_SCRATCH_ARENA
+  TComArenaScope cArenaScope( m_cScratchArena );
+#endif
   if( isDmmMode( uiLumaPredMode ) )
   {
     assert( uiWidth == uiHeight  );
@@ -2039,7 +2085,11 @@ Void TEncSearch::xIntraCodingSDC( TComDataCU* pcCU, UInt uiAbsPartIdx, TComYuv*
     initIntraPatternChType( tuRecurseWithPU, COMPONENT_Y, false DEBUG_STRING_PASS_INTO(sTemp) );
 
     // get partition
+#if NH_3D_SCRATCH_ARENA
+    pbMask       = m_cScratchArena.alloc<Bool>( uiWidth*uiHeight );
+#else
     pbMask       = new Bool[ uiWidth*uiHeight ];
+#endif
     uiMaskStride = uiWidth;
     switch( getDmmType( uiLumaPredMode ) )
     {
@@ -2211,7 +2261,7 @@ Void TEncSearch::xIntraCodingSDC( TComDataCU* pcCU, UInt uiAbsPartIdx, TComYuv*
     pRecCr += uiStrideC;
   }
 
-#if NH_3D_DMM
+#if NH_3D_DMM && !NH_3D_SCRATCH_ARENA
   if( pbMask ) { delete[] pbMask; }
 #endif
 
@@ -2770,8 +2820,20 @@ Void TEncSearch::estIntraPredDIS( TComDataCU* pcCU,
   UInt         uiBestDISType = 0;
 #endif
 
+#if NH_3D_TEX_GUIDED_MD
+  UChar uhTexFlags;
+  const Bool  bTexGuided = xGetTextureAnalysis( pcCU, 0, uiWidth, uiHeight, uhTexFlags );
+  const UChar uhTexEdges = uhTexFlags & TEX_EDGE;
+#endif
   for( UInt uiPredMode = 0; uiPredMode < 4 ; uiPredMode++ )
   {
+#if NH_3D_TEX_GUIDED_MD
+    // single depth modes need a flat texture, vertical and horizontal copies must not cross an edge of the texture
+    if( bTexGuided && ( ( uiPredMode >= 2 && uhTexEdges != 0 ) || ( uiPredMode == 0 && uhTexEdges == TEX_EDGE_VER ) || ( uiPredMode == 1 && uhTexEdges == TEX_EDGE_HOR ) ) )
+    {
+      continue;
+    }
+#endif
 #if NH_MV
     D_PRINT_INC_INDENT(g_traceModeCheck, "uiPredMode" +  n2s(uiPredMode ) );
 #endif
@@ -3062,7 +3124,12 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
 #if NH_3D_ENC_DEPTH
         if( bOnlyIVP )
         {
+#if NH_3D_SCRATCH_ARENA
+          TComArenaScope cArenaScope( m_cScratchArena );
+          Bool* dmm4Pattern   = m_cScratchArena.alloc<Bool>( puRect.width*puRect.height );
+#else
           Bool* dmm4Pattern   = new Bool[ puRect.width*puRect.height ];
+#endif
           UInt  patternStride = puRect.width;
           predContourFromTex( pcCU, uiPartOffset, puRect.width, puRect.height, dmm4Pattern );
 
@@ -3072,14 +3139,23 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
           pcCU->setDmmDeltaDC( DMM4_IDX, 1, uiPartOffset, deltaDC2 );
 
           uiRdModeList[ numModesForFullRD++ ] = (DMM4_IDX+DMM_OFFSET);
+#if !NH_3D_SCRATCH_ARENA
           delete[] dmm4Pattern;
+#endif
         }
         else
         {
           Int  threshold    = max(((pcCU->getQP(0))>>3)-1,3);
           Int  varThreshold = (Int)( threshold * threshold - 8 );
           UInt varCU        = m_pcRdCost->calcVAR( piOrg, uiStride, puRect.width, puRect.height, pcCU->getDepth(0), pcCU->getSlice()->getSPS()->getMaxCUWidth() );
+#if NH_3D_TEX_GUIDED_MD
+          // depth edges coincide with texture edges, without one the wedgelet and contour searches are skipped
+          UChar uhTexFlags;
+          xGetTextureAnalysis( pcCU, uiAbsPartIdx, puRect.width, puRect.height, uhTexFlags );
+          if( ( uiRdModeList[0] != PLANAR_IDX || varCU >= varThreshold ) && ( uhTexFlags & TEX_EDGE ) )
+#else
           if( uiRdModeList[0] != PLANAR_IDX || varCU >= varThreshold )
+#endif
           {
 #endif
             UInt startIdx = ( m_pcEncCfg->getUseDMM() &&  pcCU->getSlice()->getIntraSdcWedgeFlag() ) ? 0 : 1;
@@ -3089,7 +3165,12 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
 #if H_3D_FCO
               if ( !(pcCU->getSlice()->getIvPic(false, pcCU->getSlice()->getViewIndex() )->getReconMark()) && (DMM4_IDX == dmmType ) ) { continue; }
 #endif
+#if NH_3D_SCRATCH_ARENA
+              TComArenaScope cArenaScope( m_cScratchArena );
+              Bool* biSegPattern  = m_cScratchArena.alloc<Bool>( puRect.width*puRect.height );
+#else
               Bool* biSegPattern  = new Bool[ puRect.width*puRect.height ];
+#endif
               UInt  patternStride = puRect.width;
               Pel deltaDC1 = 0; Pel deltaDC2 = 0;
               switch( dmmType )
@@ -3115,7 +3196,9 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
                 pcCU->setDmmDeltaDC( (DmmID)dmmType, 1, uiPartOffset, deltaDC2 );
   
                 uiRdModeList[ numModesForFullRD++ ] = (dmmType+DMM_OFFSET);
+#if !NH_3D_SCRATCH_ARENA
                 delete[] biSegPattern;
+#endif
               }
             }
 #if NH_3D_ENC_DEPTH
@@ -4685,8 +4768,14 @@ Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv*
       memset(bSPIVMPFlag, false, sizeof(Bool)*MRG_MAX_NUM_CANDS_MEM);
       TComMvField*  pcMvFieldSP;
       UChar* puhInterDirSP;
+#if NH_3D_SCRATCH_ARENA
+      TComArenaScope cArenaScope( m_cScratchArena );
+      pcMvFieldSP   = m_cScratchArena.alloc<TComMvField>( pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2 );
+      puhInterDirSP = m_cScratchArena.alloc<UChar>      ( pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()   );
+#else
       pcMvFieldSP = new TComMvField[pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()*2]; 
       puhInterDirSP = new UChar[pcCU->getPic()->getPicSym()->getNumPartitionsInCtu()]; 
+#endif
 #endif
       xMergeEstimation( pcCU, pcOrgYuv, iPartIdx, uiMRGInterDir, cMRGMvField, uiMRGIndex, uiMRGCost, cMvFieldNeighbours, uhInterDirNeighbours, numValidMergeCand
 #if NH_3D_VSP
@@ -4794,7 +4883,7 @@ Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv*
         pcCU->getCUMvField( REF_PIC_LIST_0 )->setAllMvField( cMEMvField[0], ePartSize, uiPartAddr, 0, iPartIdx );
         pcCU->getCUMvField( REF_PIC_LIST_1 )->setAllMvField( cMEMvField[1], ePartSize, uiPartAddr, 0, iPartIdx );
       }
-#if NH_3D_SPIVMP
+#if NH_3D_SPIVMP && !NH_3D_SCRATCH_ARENA
       delete[] pcMvFieldSP;
       delete[] puhInterDirSP;
 #endif
@@ -5244,6 +5333,30 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 
 
   setWpScalingDistParam( pcCU, iRefIdxPred, eRefPicList );
+#if NH_MV_PYRAMID_ME
+  if ( m_pcEncCfg->getUsePyramidME() && !bBi )
+  {
+    if ( pcCU->getPartitionSize( 0 ) == SIZE_2Nx2N )
+    {
+      m_bPyramidStartAvailable = xPyramidSearch( pcCU, pcPatternKey, uiPartAddr, eRefPicList, iRefIdxPred, cMvSrchRngLT, cMvSrchRngRB, m_cPyramidStart );
+      m_acPyramidMv2Nx2N     [eRefPicList][iRefIdxPred] = m_cPyramidStart;
+      m_abPyramidMv2Nx2NValid[eRefPicList][iRefIdxPred] = m_bPyramidStartAvailable;
+    }
+    else
+    {
+      // the 2Nx2N PU is searched first, its coarse vector is the start point of the smaller PUs of the CU
+      m_bPyramidStartAvailable = m_abPyramidMv2Nx2NValid[eRefPicList][iRefIdxPred];
+      m_cPyramidStart          = m_acPyramidMv2Nx2N     [eRefPicList][iRefIdxPred];
+    }
+    if ( m_bPyramidStartAvailable && m_motionEstimationSearchMethod == MESEARCH_FULL
+      && xGetIntegerMvCost( pcCU, pcPatternKey, piRefY, iRefStride, m_cPyramidStart ) < xGetIntegerMvCost( pcCU, pcPatternKey, piRefY, iRefStride, cMvPred ) )
+    {
+      // the coarse search has covered the whole window and its result beats the predictor the window is centred on,
+      // the full search only refines it
+      xSetSearchRange( pcCU, m_cPyramidStart, m_pcEncCfg->getPyramidMERefineRange(), cMvSrchRngLT, cMvSrchRngRB );
+    }
+  }
+#endif
   //  Do integer search
   if ( (m_motionEstimationSearchMethod==MESEARCH_FULL) || bBi )
   {
@@ -5266,12 +5379,30 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
     {
       pIntegerMv2Nx2NPred = &(m_integerMv2Nx2N[eRefPicList][iRefIdxPred]);
     }
+#if NH_3D_IV_MOTION_SEED
+    // the seed is a start point of the TZ search only, the selective search does not evaluate it
+    m_bIvMotionSeedAvailable = ( m_motionEstimationSearchMethod == MESEARCH_DIAMOND || m_motionEstimationSearchMethod == MESEARCH_DIAMOND_ENHANCED )
+                            && xGetIvMotionSeed( pcCU, iPartIdx, eRefPicList, iRefIdxPred, m_cIvMotionSeed );
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+    m_bRatePointSeedAvailable = ( m_motionEstimationSearchMethod == MESEARCH_DIAMOND || m_motionEstimationSearchMethod == MESEARCH_DIAMOND_ENHANCED )
+                             && xGetRatePointMotionSeed( pcCU, iPartIdx, eRefPicList, iRefIdxPred, m_cRatePointSeed );
+#endif
     xPatternSearchFast  ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, pIntegerMv2Nx2NPred );
+#if NH_3D_IV_MOTION_SEED
+    m_bIvMotionSeedAvailable = false;
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+    m_bRatePointSeedAvailable = false;
+#endif
     if (pcCU->getPartitionSize(0) == SIZE_2Nx2N)
     {
       m_integerMv2Nx2N[eRefPicList][iRefIdxPred] = rcMv;
     }
   }
+#if NH_MV_PYRAMID_ME
+  m_bPyramidStartAvailable = false;
+#endif
 
   m_pcRdCost->selectMotionLambda( true, 0, pcCU->getCUTransquantBypass(uiPartAddr) );
 #if NH_3D_INTEGER_MV_DEPTH
@@ -5281,6 +5412,16 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
   m_pcRdCost->setCostScale ( 1 );
 
   const Bool bIsLosslessCoded = pcCU->getCUTransquantBypass(uiPartAddr) != 0;
+#if NH_MV_SUBPEL_PLANE_CACHE
+  m_pcSubPelRefPic = NULL;
+  if ( m_pcEncCfg->getUseSubPelPlaneCache() )
+  {
+    // built on first use, the planes then serve all CUs and all layers referring to this picture
+    TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec();
+    pcPicYuvRef->buildSubPelPlanes( pcCU->getSlice()->getSPS()->getBitDepth( CHANNEL_TYPE_LUMA ) );
+    m_pcSubPelRefPic = pcPicYuvRef;
+  }
+#endif
   xPatternSearchFracDIF( bIsLosslessCoded, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost );
 
   m_pcRdCost->setCostScale( 0 );
@@ -5307,6 +5448,266 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 #endif
 }
 
+#if NH_MV_PYRAMID_ME
+/** Coarse to fine integer motion search on the downsampled luma planes of the original and the reference picture.
+ *  A full search over the whole search window is done at the coarsest level, each finer level refines the scaled
+ *  result by +-1 sample. The distortion is scaled to full resolution before the motion vector cost is added.
+ * \param rcMv motion vector in the units of the full resolution search
+ * \returns false when the PU has less than 4x4 samples at the coarsest level
+ */
+Bool TEncSearch::xPyramidSearch( TComDataCU* pcCU, const TComPattern* const pcPatternKey, UInt uiPartAddr, RefPicList eRefPicList, Int iRefIdx,
+                                 const TComMv& rcMvSrchRngLT, const TComMv& rcMvSrchRngRB, TComMv& rcMv )
+{
+  const Int iWidth  = pcPatternKey->getROIYWidth();
+  const Int iHeight = pcPatternKey->getROIYHeight();
+  const Int iLevel  = NUM_ME_PYRAMID_LEVELS - 1;
+
+  // smaller PUs would need a full search on a finer level, which costs more than the TZ search it replaces
+  if ( ( iWidth >> ( iLevel + 1 ) ) < 4 || ( iHeight >> ( iLevel + 1 ) ) < 4 )
+  {
+    return false;
+  }
+#if NH_3D_DBBP
+  // the segmentation mask of the distortion is given in full resolution block coordinates
+  if ( pcCU->getDBBPFlag( uiPartAddr ) )
+  {
+    return false;
+  }
+#endif
+
+  TComPicYuv* pcOrgPic = pcCU->getPic()->getPicYuvOrg();
+  TComPicYuv* pcRefPic = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec();
+  pcOrgPic->buildPyramid();
+  pcRefPic->buildPyramid();
+
+  const Int iPelX = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[ uiPartAddr ] ];
+  const Int iPelY = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[ uiPartAddr ] ];
+
+  DistParam cDistParam;
+  Int       iBestX = 0;
+  Int       iBestY = 0;
+
+  for ( Int level = iLevel; level >= 0; level-- )
+  {
+    const Int iShift     = level + 1;
+    const Int iOrgStride = pcOrgPic->getPyramidStride( level );
+    const Int iRefStride = pcRefPic->getPyramidStride( level );
+    const Pel* piOrg     = pcOrgPic->getPyramidAddr( level ) + ( iPelY >> iShift ) * iOrgStride + ( iPelX >> iShift );
+    const Pel* piRef     = pcRefPic->getPyramidAddr( level ) + ( iPelY >> iShift ) * iRefStride + ( iPelX >> iShift );
+
+    m_pcRdCost->setDistParam( cDistParam, pcPatternKey->getBitDepthY(), piOrg, iOrgStride, piRef, iRefStride, iWidth >> iShift, iHeight >> iShift );
+#if NH_3D_IC
+    cDistParam.bUseIC       = pcPatternKey->getICFlag();
+#endif
+#if NH_3D_SDC_INTER
+    cDistParam.bUseSDCMRSAD = pcPatternKey->getSDCMRSADFlag();
+#endif
+
+    Int iLeft, iRight, iTop, iBottom;
+    if ( level == iLevel )
+    {
+      iLeft   = rcMvSrchRngLT.getHor() >> iShift;
+      iRight  = rcMvSrchRngRB.getHor() >> iShift;
+      iTop    = rcMvSrchRngLT.getVer() >> iShift;
+      iBottom = rcMvSrchRngRB.getVer() >> iShift;
+    }
+    else
+    {
+      iLeft   = ( iBestX << 1 ) - 1;
+      iRight  = ( iBestX << 1 ) + 1;
+      iTop    = ( iBestY << 1 ) - 1;
+      iBottom = ( iBestY << 1 ) + 1;
+    }
+
+    Distortion uiBestCost = std::numeric_limits<Distortion>::max();
+    for ( Int y = iTop; y <= iBottom; y++ )
+    {
+      for ( Int x = iLeft; x <= iRight; x++ )
+      {
+        cDistParam.pCur = piRef + y * iRefStride + x;
+        const Distortion uiCost = ( cDistParam.DistFunc( &cDistParam ) << ( iShift << 1 ) ) + m_pcRdCost->getCostOfVectorWithPredictor( x << iShift, y << iShift );
+        if ( uiCost < uiBestCost )
+        {
+          uiBestCost = uiCost;
+          iBestX     = x;
+          iBestY     = y;
+        }
+      }
+    }
+  }
+
+  rcMv.set( iBestX << 1, iBestY << 1 );
+#if NH_3D_INTEGER_MV_DEPTH
+  if( ! pcCU->getSlice()->getIsDepth() )
+#endif
+  rcMv <<= 2;
+  return true;
+}
+
+/** Distortion plus motion vector cost of a single integer position, as evaluated by the full search.
+ * \param rcMv motion vector in the units of the motion vector predictor
+ */
+Distortion TEncSearch::xGetIntegerMvCost( const TComDataCU* const pcCU, const TComPattern* const pcPatternKey, const Pel* piRefY, Int iRefStride, const TComMv& rcMv )
+{
+  TComMv cMv = rcMv;
+  pcCU->clipMv( cMv );
+#if NH_3D_INTEGER_MV_DEPTH
+  if( ! pcCU->getSlice()->getIsDepth() )
+#endif
+#if ME_ENABLE_ROUNDING_OF_MVS
+  cMv.divideByPowerOf2(2);
+#else
+  cMv >>= 2;
+#endif
+
+  m_pcRdCost->setDistParam( pcPatternKey, piRefY + cMv.getVer() * iRefStride + cMv.getHor(), iRefStride, m_cDistParam );
+  setDistParamComp(COMPONENT_Y);
+  m_cDistParam.bitDepth = pcPatternKey->getBitDepthY();
+#if NH_3D_IC
+  m_cDistParam.bUseIC = pcPatternKey->getICFlag();
+#endif
+#if NH_3D_SDC_INTER
+  m_cDistParam.bUseSDCMRSAD = pcPatternKey->getSDCMRSADFlag();
+#endif
+
+  return m_cDistParam.DistFunc( &m_cDistParam ) + m_pcRdCost->getCostOfVectorWithPredictor( cMv.getHor(), cMv.getVer() );
+}
+#endif
+
+#if NH_3D_IV_MOTION_SEED
+/** Get the motion of the base view block that covers the disparity shifted centre of a PU of a dependent texture view.
+ * \returns true when the base view block refers to a picture with the POC of the temporal reference (eRefPicList, iRefIdx)
+ */
+Bool TEncSearch::xGetIvMotionSeed( TComDataCU* pcCU, Int iPartIdx, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv )
+{
+  TComSlice* pcSlice = pcCU->getSlice();
+  if ( !m_pcEncCfg->getUseIvMotionSeed() || pcSlice->getIsDepth() || pcSlice->getViewIndex() == 0 )
+  {
+    return false;
+  }
+  // the NBDV of the CU is only derived when one of these tools is enabled
+  if ( !( pcSlice->getIvMvPredFlag() || pcSlice->getIvResPredFlag() || pcSlice->getViewSynthesisPredFlag() ) )
+  {
+    return false;
+  }
+
+  const Int iRefPOC = pcSlice->getRefPOC( eRefPicList, iRefIdx );
+  if ( iRefPOC == pcSlice->getPOC() )
+  {
+    return false;
+  }
+
+  UInt uiPartAddr;
+  Int  iWidth;
+  Int  iHeight;
+  pcCU->getPartIndexAndSize( iPartIdx, uiPartAddr, iWidth, iHeight );
+
+  const DisInfo cDvInfo   = pcCU->getDvInfo( uiPartAddr );
+  TComPic*      pcBasePic = pcSlice->getIvPic( false, cDvInfo.m_aVIdxCan );
+  if ( pcBasePic == NULL )
+  {
+    return false;
+  }
+  TComPicYuv*   pcBaseRec = pcBasePic->getPicYuvRec();
+
+  TComMv cDv = cDvInfo.m_acNBDV;
+#if NH_3D_NBDV_REF
+  if ( pcSlice->getDepthRefinementFlag() )
+  {
+    cDv = cDvInfo.m_acDoNBDV;
+    cDv.setVer( 0 );
+  }
+#endif
+
+  Int iPosX, iPosY;
+  pcBaseRec->getTopLeftSamplePos( pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() + uiPartAddr, iPosX, iPosY );
+  iPosX = Clip3( 0, pcBaseRec->getWidth ( COMPONENT_Y ) - 1, iPosX + ( iWidth  >> 1 ) + ( ( cDv.getHor() + 2 ) >> 2 ) );
+  iPosY = Clip3( 0, pcBaseRec->getHeight( COMPONENT_Y ) - 1, iPosY + ( iHeight >> 1 ) + ( ( cDv.getVer() + 2 ) >> 2 ) );
+
+  Int iBaseCtuAddr, iBaseAbsPartIdx;
+  pcBaseRec->getCUAddrAndPartIdx( iPosX, iPosY, iBaseCtuAddr, iBaseAbsPartIdx );
+  TComDataCU* pcBaseCU = pcBasePic->getCtu( iBaseCtuAddr );
+#if NH_3D_REF_MOTION_STORE
+  const RefMotionUnit& rcBaseUnit = pcBasePic->getPicSym()->getRefMotionStore().getUnit( iBaseCtuAddr, iBaseAbsPartIdx );
+  if ( rcBaseUnit.m_ePredMode != MODE_INTER )
+#else
+  if ( pcBaseCU->getPredictionMode( iBaseAbsPartIdx ) != MODE_INTER )
+#endif
+  {
+    return false;
+  }
+
+  // same list first, the base view may hold the reference picture in the other list
+  for ( Int iLoop = 0; iLoop < 2; iLoop++ )
+  {
+    const RefPicList eBaseRefPicList = RefPicList( iLoop ? 1 - eRefPicList : eRefPicList );
+    TComMvField cBaseMvField;
+#if NH_3D_REF_MOTION_STORE
+    cBaseMvField.setMvField( rcBaseUnit.m_acMv[eBaseRefPicList], rcBaseUnit.m_aiRefIdx[eBaseRefPicList] );
+#else
+    pcBaseCU->getMvField( pcBaseCU, iBaseAbsPartIdx, eBaseRefPicList, cBaseMvField );
+#endif
+    if ( cBaseMvField.getRefIdx() >= 0 && pcBaseCU->getSlice()->getRefPOC( eBaseRefPicList, cBaseMvField.getRefIdx() ) == iRefPOC )
+    {
+      rcMv = cBaseMvField.getMv();
+      return true;
+    }
+  }
+  return false;
+}
+#endif
+
+#if NH_MV_RATE_POINT_ME_SEED
+/** Get the motion of the block covering the centre of a PU in the same picture coded at the first rate point.
+ * \returns true when that block refers to the reference picture (eRefPicList, iRefIdx), the rate points share the
+ *          reference picture lists
+ */
+Bool TEncSearch::xGetRatePointMotionSeed( TComDataCU* pcCU, Int iPartIdx, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv )
+{
+  if ( m_pcRatePointSeedPic == NULL )
+  {
+    return false;
+  }
+
+  UInt uiPartAddr;
+  Int  iWidth;
+  Int  iHeight;
+  pcCU->getPartIndexAndSize( iPartIdx, uiPartAddr, iWidth, iHeight );
+
+  TComPicYuv* pcSeedRec = m_pcRatePointSeedPic->getPicYuvRec();
+  Int iPosX, iPosY;
+  pcSeedRec->getTopLeftSamplePos( pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() + uiPartAddr, iPosX, iPosY );
+  iPosX = std::min( iPosX + ( iWidth  >> 1 ), pcSeedRec->getWidth ( COMPONENT_Y ) - 1 );
+  iPosY = std::min( iPosY + ( iHeight >> 1 ), pcSeedRec->getHeight( COMPONENT_Y ) - 1 );
+
+  Int iSeedCtuAddr, iSeedAbsPartIdx;
+  pcSeedRec->getCUAddrAndPartIdx( iPosX, iPosY, iSeedCtuAddr, iSeedAbsPartIdx );
+  TComDataCU* pcSeedCU = m_pcRatePointSeedPic->getCtu( iSeedCtuAddr );
+#if NH_3D_REF_MOTION_STORE
+  const RefMotionUnit& rcSeedUnit = m_pcRatePointSeedPic->getPicSym()->getRefMotionStore().getUnit( iSeedCtuAddr, iSeedAbsPartIdx );
+  if ( rcSeedUnit.m_ePredMode != MODE_INTER || rcSeedUnit.m_aiRefIdx[eRefPicList] != iRefIdx )
+  {
+    return false;
+  }
+  TComMvField cSeedMvField;
+  cSeedMvField.setMvField( rcSeedUnit.m_acMv[eRefPicList], rcSeedUnit.m_aiRefIdx[eRefPicList] );
+#else
+  TComMvField cSeedMvField;
+  pcSeedCU->getMvField( pcSeedCU, iSeedAbsPartIdx, eRefPicList, cSeedMvField );
+  if ( pcSeedCU->getPredictionMode( iSeedAbsPartIdx ) != MODE_INTER || cSeedMvField.getRefIdx() != iRefIdx )
+  {
+    return false;
+  }
+#endif
+  // the slice of the seed block may be another one than the slice of the current PU
+  if ( pcSeedCU->getSlice()->getRefPOC( eRefPicList, iRefIdx ) != pcCU->getSlice()->getRefPOC( eRefPicList, iRefIdx ) )
+  {
+    return false;
+  }
+  rcMv = cSeedMvField.getMv();
+  return true;
+}
+#endif
 
 Void TEncSearch::xSetSearchRange ( const TComDataCU* const pcCU, const TComMv& cMvPred, const Int iSrchRng,
                                    TComMv& rcMvSrchRngLT, TComMv& rcMvSrchRngRB )
@@ -5591,6 +5992,104 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
     iSrchRngVerBottom = cMvSrchRngRB.getVer();
   }
 
+#if NH_MV_PYRAMID_ME || NH_3D_IV_MOTION_SEED || NH_MV_RATE_POINT_ME_SEED
+  Int iReducedSearchRange = (Int)uiSearchRange;
+#endif
+#if NH_MV_PYRAMID_ME
+  TComMv cPyramidMv = m_cPyramidStart;
+  if ( m_bPyramidStartAvailable )
+  {
+    pcCU->clipMv( cPyramidMv );
+#if NH_3D_INTEGER_MV_DEPTH
+    if( ! pcCU->getSlice()->getIsDepth() )
+#endif
+#if ME_ENABLE_ROUNDING_OF_MVS
+    cPyramidMv.divideByPowerOf2(2);
+#else
+    cPyramidMv >>= 2;
+#endif
+    if ( cPyramidMv.getHor() != cStruct.iBestX || cPyramidMv.getVer() != cStruct.iBestY )
+    {
+      xTZSearchHelp( pcPatternKey, cStruct, cPyramidMv.getHor(), cPyramidMv.getVer(), 0, 0 );
+    }
+  }
+#endif
+#if NH_3D_IV_MOTION_SEED
+  TComMv cIvMv = m_cIvMotionSeed;
+  if ( m_bIvMotionSeedAvailable )
+  {
+    pcCU->clipMv( cIvMv );
+#if ME_ENABLE_ROUNDING_OF_MVS
+    cIvMv.divideByPowerOf2(2);
+#else
+    cIvMv >>= 2;
+#endif
+    if ( cIvMv.getHor() != cStruct.iBestX || cIvMv.getVer() != cStruct.iBestY )
+    {
+      xTZSearchHelp( pcPatternKey, cStruct, cIvMv.getHor(), cIvMv.getVer(), 0, 0 );
+    }
+  }
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  TComMv cRatePointMv = m_cRatePointSeed;
+  if ( m_bRatePointSeedAvailable )
+  {
+    pcCU->clipMv( cRatePointMv );
+#if NH_3D_INTEGER_MV_DEPTH
+    if( ! pcCU->getSlice()->getIsDepth() )
+#endif
+#if ME_ENABLE_ROUNDING_OF_MVS
+    cRatePointMv.divideByPowerOf2(2);
+#else
+    cRatePointMv >>= 2;
+#endif
+    if ( cRatePointMv.getHor() != cStruct.iBestX || cRatePointMv.getVer() != cStruct.iBestY )
+    {
+      xTZSearchHelp( pcPatternKey, cStruct, cRatePointMv.getHor(), cRatePointMv.getVer(), 0, 0 );
+    }
+  }
+#endif
+  // the window is only reduced around a start point that has won against all other ones
+#if NH_MV_PYRAMID_ME
+  if ( m_bPyramidStartAvailable && cPyramidMv.getHor() == cStruct.iBestX && cPyramidMv.getVer() == cStruct.iBestY )
+  {
+    // the coarse search has covered the whole window, only refine its result
+    iReducedSearchRange = std::min( iReducedSearchRange, m_pcEncCfg->getPyramidMERefineRange() );
+  }
+#endif
+#if NH_3D_IV_MOTION_SEED
+  if ( m_bIvMotionSeedAvailable && cIvMv.getHor() == cStruct.iBestX && cIvMv.getVer() == cStruct.iBestY )
+  {
+    // motion consistent with the base view: only refine it in a reduced window
+    iReducedSearchRange = std::min( iReducedSearchRange, m_pcEncCfg->getIvMotionSeedSearchRange() );
+  }
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  if ( m_bRatePointSeedAvailable && cRatePointMv.getHor() == cStruct.iBestX && cRatePointMv.getVer() == cStruct.iBestY )
+  {
+    // the first rate point has searched the whole window for the same block, only refine its motion
+    iReducedSearchRange = std::min( iReducedSearchRange, m_pcEncCfg->getRatePointMotionSeedSearchRange() );
+  }
+#endif
+#if NH_MV_PYRAMID_ME || NH_3D_IV_MOTION_SEED || NH_MV_RATE_POINT_ME_SEED
+  if ( iReducedSearchRange < (Int)uiSearchRange )
+  {
+    uiSearchRange = iReducedSearchRange;
+    TComMv cMvSrchRngLT;
+    TComMv cMvSrchRngRB;
+    TComMv currBestMv( cStruct.iBestX, cStruct.iBestY );
+#if NH_3D_INTEGER_MV_DEPTH
+    if( ! pcCU->getSlice()->getIsDepth() )
+#endif
+    currBestMv <<= 2;
+    xSetSearchRange( pcCU, currBestMv, iReducedSearchRange, cMvSrchRngLT, cMvSrchRngRB );
+    iSrchRngHorLeft   = std::max( iSrchRngHorLeft,   cMvSrchRngLT.getHor() );
+    iSrchRngHorRight  = std::min( iSrchRngHorRight,  cMvSrchRngRB.getHor() );
+    iSrchRngVerTop    = std::max( iSrchRngVerTop,    cMvSrchRngLT.getVer() );
+    iSrchRngVerBottom = std::min( iSrchRngVerBottom, cMvSrchRngRB.getVer() );
+  }
+#endif
+
   // start search
   Int  iDist = 0;
   Int  iStartX = cStruct.iBestX;
@@ -5977,8 +6476,19 @@ Void TEncSearch::xPatternSearchFracDIF(
                           iRefStride,
                           pcPatternKey->getBitDepthY());
 
+#if NH_MV_SUBPEL_PLANE_CACHE
+  if ( m_pcSubPelRefPic != NULL )
+  {
+    m_iSubPelRoiOffset = Int( piRefY - m_pcSubPelRefPic->getSubPelAddr( 0, 0 ) ) + iOffset;
+  }
+  else
+  {
+#endif
   //  Half-pel refinement
   xExtDIFUpSamplingH ( &cPatternRoi );
+#if NH_MV_SUBPEL_PLANE_CACHE
+  }
+#endif
 
   rcMvHalf = *pcMvInt;   rcMvHalf <<= 1;    // for mv-cost
   TComMv baseRefMv(0, 0);
@@ -5986,7 +6496,14 @@ Void TEncSearch::xPatternSearchFracDIF(
 
   m_pcRdCost->setCostScale( 0 );
 
+#if NH_MV_SUBPEL_PLANE_CACHE
+  if ( m_pcSubPelRefPic == NULL )
+  {
+#endif
   xExtDIFUpSamplingQ ( &cPatternRoi, rcMvHalf );
+#if NH_MV_SUBPEL_PLANE_CACHE
+  }
+#endif
   baseRefMv = rcMvHalf;
   baseRefMv <<= 1;
 
@@ -6123,10 +6640,12 @@ Void TEncSearch::encodeResAndCalcRdInterCU( TComDataCU* pcCU, TComYuv* pcYuvOrg,
 
   m_pcRDGoOnSbacCoder->load( m_pppcRDSbacCoder[ pcCU->getDepth( 0 ) ][ CI_CURR_BEST ] );
 #if NH_3D_VSO // M16 // M18  
+#if !NH_3D_SCRATCH_ARENA
   if ( m_pcRdCost->getUseVSO() )  // This creating and destroying need to be fixed. 
   {
     m_cYuvRecTemp.create( pcYuvPred->getWidth( COMPONENT_Y ), pcYuvPred->getHeight( COMPONENT_Y ), CHROMA_400  );
   }
+#endif
 
 #if ENC_DEC_TRACE && NH_MV_ENC_DEC_TRAC
   Bool oldTraceRDCost = g_traceRDCost;     
@@ -6147,10 +6666,12 @@ Void TEncSearch::encodeResAndCalcRdInterCU( TComDataCU* pcCU, TComYuv* pcYuvOrg,
   g_traceModeCheck = oldTraceModeCheck; 
 #endif
 
+#if !NH_3D_SCRATCH_ARENA
   if ( m_pcRdCost->getUseVSO() )
   {
     m_cYuvRecTemp.destroy();
   }
+#endif
 #else
   xEstimateInterResidualQT( pcYuvResi,  nonZeroCost, nonZeroBits, nonZeroDistortion, &zeroDistortion, tuLevel0 DEBUG_STRING_PASS_INTO(sDebug) );
 #endif
@@ -7912,18 +8433,44 @@ Void TEncSearch::xSearchDmmDeltaDCs( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piO
 #endif
 }
 
+#if NH_3D_TEX_GUIDED_MD
+/** Get the features of the co-located texture block.
+ * \returns false (and TEX_ALL) if they are not used or not available
+ */
+Bool TEncSearch::xGetTextureAnalysis( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiWidth, UInt uiHeight, UChar& ruhFlags )
+{
+  const TComPic* pcTexture = pcCU->getSlice()->getTexturePic();
+  ruhFlags = TEX_ALL;
+  if( !m_pcEncCfg->getUseTexGuidedDepthMD() || !pcCU->getSlice()->getIsDepth() || pcTexture == NULL || !pcTexture->getReconMark() )
+  {
+    return false;
+  }
+  const Int iPosX = Int( pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[ uiAbsPartIdx ] ] );
+  const Int iPosY = Int( pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[ uiAbsPartIdx ] ] );
+  ruhFlags = pcTexture->getTextureAnalysis( iPosX, iPosY, uiWidth, uiHeight );
+  return true;
+}
+#endif
+
 Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef, UInt uiRefStride, UInt uiWidth, UInt uiHeight, UInt& ruiTabIdx )
 {
   ruiTabIdx = 0;
   Int bitDepthY = pcCU->getSlice()->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA);
 
   // local pred buffer
+#if NH_3D_SCRATCH_ARENA
+  TComArenaScope cArenaScope( m_cScratchArena );
+  UInt uiPredStride = uiWidth;
+  Pel* piPred       = m_cScratchArena.alloc<Pel>( uiWidth*uiHeight );
+  ::memset( piPred, 0, sizeof(Pel)*uiWidth*uiHeight );
+#else
   TComYuv cPredYuv;
   cPredYuv.create( uiWidth, uiHeight, CHROMA_400 );
   cPredYuv.clear();
 
   UInt uiPredStride = cPredYuv.getStride( COMPONENT_Y );
   Pel* piPred       = cPredYuv.getAddr( COMPONENT_Y );
+#endif
 
   Pel refDC1 = 0; Pel refDC2 = 0;
 
@@ -8022,7 +8569,9 @@ Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef
 
   ruiTabIdx = uiBestTabIdxRef;
 
+#if !NH_3D_SCRATCH_ARENA
   cPredYuv.destroy();
+#endif
   return;
 }
 
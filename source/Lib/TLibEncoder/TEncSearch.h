@@ -114,12 +114,32 @@ protected:
 
 #if NH_3D_VSO // M17
   TComYuv         m_cYuvRecTemp; 
+  TRenModel       m_cRenModel;                ///< renderer model of this search instance, set up per CTU row from the setup of the slice
 #endif
   // AMVP cost computation
   // UInt            m_auiMVPIdxCost[AMVP_MAX_NUM_CANDS+1][AMVP_MAX_NUM_CANDS];
   UInt            m_auiMVPIdxCost[AMVP_MAX_NUM_CANDS+1][AMVP_MAX_NUM_CANDS+1]; //th array bounds
 
   TComMv          m_integerMv2Nx2N[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+#if NH_3D_IV_MOTION_SEED
+  Bool            m_bIvMotionSeedAvailable;   ///< m_cIvMotionSeed is a start point candidate of the current integer search
+  TComMv          m_cIvMotionSeed;            ///< base view motion of the current PU and reference picture
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  TComPic*        m_pcRatePointSeedPic;       ///< current picture coded at the first rate point, NULL if not available
+  Bool            m_bRatePointSeedAvailable;  ///< m_cRatePointSeed is a start point candidate of the current integer search
+  TComMv          m_cRatePointSeed;           ///< motion of the current PU and reference picture at the first rate point
+#endif
+#if NH_MV_PYRAMID_ME
+  Bool            m_bPyramidStartAvailable;   ///< m_cPyramidStart is the result of the coarse search of the current ME call
+  TComMv          m_cPyramidStart;            ///< motion vector found on the downsampled planes
+  TComMv          m_acPyramidMv2Nx2N[NUM_REF_PIC_LIST_01][MAX_NUM_REF];     ///< coarse vectors of the last 2Nx2N PU, reused by the other partitionings of the CU
+  Bool            m_abPyramidMv2Nx2NValid[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+#endif
+#if NH_MV_SUBPEL_PLANE_CACHE
+  const TComPicYuv* m_pcSubPelRefPic;         ///< reference picture whose interpolated planes are used by the current fractional search, NULL for block wise interpolation
+  Int             m_iSubPelRoiOffset;         ///< offset of the integer search result in the planes of m_pcSubPelRefPic
+#endif
 
   Bool            m_isInitialized;
 public:
@@ -141,6 +161,13 @@ public:
 
   Void destroy();
 
+#if NH_3D_VSO
+  TRenModel*  getRenModel() { return &m_cRenModel; }
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  Void        setRatePointSeedPic( TComPic* pcPic ) { m_pcRatePointSeedPic = pcPic; }
+#endif
+
 protected:
 
   /// sub-function for motion vector refinement used in fractional-pel accuracy
@@ -358,6 +385,9 @@ const ComponentID   compID,
   Void xSearchDmmDeltaDCs         ( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piOrig, Pel* piPredic, UInt uiStride, Bool* biSegPattern, Int patternStride, UInt uiWidth, UInt uiHeight, Pel& rDeltaDC1, Pel& rDeltaDC2 );
   Void xSearchDmm1Wedge           ( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef, UInt uiRefStride, UInt uiWidth, UInt uiHeight, UInt& ruiTabIdx );
 #endif
+#if NH_3D_TEX_GUIDED_MD
+  Bool xGetTextureAnalysis        ( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiWidth, UInt uiHeight, UChar& ruhFlags );
+#endif
 #if NH_3D_SDC_INTRA
 #if NH_3D_VSO
   Void xIntraCodingSDC            ( TComDataCU* pcCU, UInt uiAbsPartIdx, TComYuv* pcOrgYuv, TComYuv* pcPredYuv, Dist& ruiDist      , Double& dRDCost, Bool bZeroResidual, Int iSDCDeltaResi    );
@@ -448,6 +478,38 @@ const ComponentID   compID,
                                     Distortion&  ruiCost,
                                     Bool         bBi = false  );
 
+#if NH_MV_PYRAMID_ME
+  Bool xPyramidSearch             ( TComDataCU*  pcCU,
+                                    const TComPattern* const pcPatternKey,
+                                    UInt         uiPartAddr,
+                                    RefPicList   eRefPicList,
+                                    Int          iRefIdx,
+                                    const TComMv& rcMvSrchRngLT,
+                                    const TComMv& rcMvSrchRngRB,
+                                    TComMv&      rcMv );
+
+  Distortion xGetIntegerMvCost    ( const TComDataCU* const pcCU,
+                                    const TComPattern* const pcPatternKey,
+                                    const Pel*   piRefY,
+                                    Int          iRefStride,
+                                    const TComMv& rcMv );
+#endif
+
+#if NH_3D_IV_MOTION_SEED
+  Bool xGetIvMotionSeed           ( TComDataCU*  pcCU,
+                                    Int          iPartIdx,
+                                    RefPicList   eRefPicList,
+                                    Int          iRefIdx,
+                                    TComMv&      rcMv );
+#endif
+#if NH_MV_RATE_POINT_ME_SEED
+  Bool xGetRatePointMotionSeed    ( TComDataCU*  pcCU,
+                                    Int          iPartIdx,
+                                    RefPicList   eRefPicList,
+                                    Int          iRefIdx,
+                                    TComMv&      rcMv );
+#endif
+
   Void xTZSearch                  ( const TComDataCU* const  pcCU,
                                     const TComPattern* const pcPatternKey,
                                     const Pel* const         piRefY,
@@ -865,9 +865,36 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     }
   }
 
+#if NH_MV_RATE_POINT_ME_SEED
+  // the same picture coded at the first rate point provides start points of the integer ME
+  TEncTop* pcFirstRatePointEncTop = ((TEncTop*) m_pcCfg)->getFirstRatePointEncTop();
+  m_pcPredSearch->setRatePointSeedPic( pcFirstRatePointEncTop != NULL && m_pcCfg->getUseRatePointMotionSeed() ? pcFirstRatePointEncTop->getPic( pcSlice->getPOC() ) : NULL );
+#endif
+
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
 #if NH_3D_VSO
   Int iLastPosY = -1;
+  TEncRenModelSetup cRenModelSetup;
+  if ( m_pcRdCost->getUseRenModel() )
+  {
+    TEncTop* pcEncTop = (TEncTop*) m_pcCfg; // Fix this later.
+    pcEncTop->deriveRenModelSetup( pcSlice->getPOC() , pcSlice->getViewIndex(), pcSlice->getIsDepth() || pcSlice->getVPS()->getAuxId( pcSlice->getLayerId()  ) ? 1 : 0, cRenModelSetup );
+
+    if ( m_pcCfg->getVSOIncrementalSetup() )
+    {
+      // render the initial state of all CTU rows of the slice segment once, setData keeps it up to date while coding
+      UInt uiFirstCtuRow = MAX_UINT;
+      UInt uiLastCtuRow  = 0;
+      for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+      {
+        const UInt ctuRow = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr) / frameWidthInCtus;
+        uiFirstCtuRow = std::min( uiFirstCtuRow, ctuRow );
+        uiLastCtuRow  = std::max( uiLastCtuRow , ctuRow );
+      }
+      const Int maxCUHeight = pcSlice->getSPS()->getMaxCUHeight();
+      pcEncTop->setupRenModel( m_pcRdCost->getRenModel(), cRenModelSetup, uiFirstCtuRow * maxCUHeight, ( uiLastCtuRow - uiFirstCtuRow + 1 ) * maxCUHeight );
+    }
+  }
 #endif
 
   for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
@@ -877,7 +904,7 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
     pCtu->initCtu( pcPic, ctuRsAddr );
 #if NH_3D_VSO
-    if ( m_pcRdCost->getUseRenModel() )
+    if ( m_pcRdCost->getUseRenModel() && !m_pcCfg->getVSOIncrementalSetup() )
     {
       // updated renderer model if necessary
       Int iCurPosX;
@@ -887,7 +914,7 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
       {
         iLastPosY = iCurPosY;         
         TEncTop* pcEncTop = (TEncTop*) m_pcCfg; // Fix this later.
-        pcEncTop->setupRenModel( pcSlice->getPOC() , pcSlice->getViewIndex(), pcSlice->getIsDepth() || pcSlice->getVPS()->getAuxId( pcSlice->getLayerId()  ) ? 1 : 0, iCurPosY, pcSlice->getSPS()->getMaxCUHeight() );
+        pcEncTop->setupRenModel( m_pcRdCost->getRenModel(), cRenModelSetup, iCurPosY, pcSlice->getSPS()->getMaxCUHeight() );
       }
     }
 #endif
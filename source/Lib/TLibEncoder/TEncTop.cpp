@@ -77,6 +77,7 @@ TEncTop::TEncTop()
 #endif
 #if NH_MV
   m_ivPicLists = NULL;
+  m_pcFirstRatePointEncTop = NULL;
 #endif
 #if NH_3D_IC
   m_aICEnableCandidate = NULL;
@@ -364,10 +365,24 @@ Void TEncTop::initNewPic( TComPicYuv* pcPicYuvOrg )
   xGetNewPicBuffer( pcPicCurr );
   pcPicYuvOrg->copyToPic( pcPicCurr->getPicYuvOrg() );
 
-  // compute image characteristics
-  if ( getUseAdaptiveQP() )
+  // compute image characteristics, they do not depend on the QP and are taken from the first rate point, if any
+  TEncPic* pcEPicCurr = dynamic_cast<TEncPic*>( pcPicCurr );
+  if ( pcEPicCurr != NULL && m_pcFirstRatePointEncTop != NULL )
   {
-    m_cPreanalyzer.xPreanalyze( dynamic_cast<TEncPic*>( pcPicCurr ) );
+    pcEPicCurr->copyAnalysis( dynamic_cast<TEncPic*>( m_pcFirstRatePointEncTop->getPic( m_iPOCLast ) ) );
+  }
+  else
+  {
+#if NH_MV_PIC_ANALYSIS
+    if ( getUsePicAnalysis() )
+    {
+      m_cPreanalyzer.xAnalyzeBlocks( dynamic_cast<TEncPic*>( pcPicCurr ), getPic( m_iPOCLast - 1 ) );
+    }
+#endif
+    if ( getUseAdaptiveQP() )
+    {
+      m_cPreanalyzer.xPreanalyze( dynamic_cast<TEncPic*>( pcPicCurr ) );
+    }
   }
   pcPicCurr->setLayerId( getLayerId()); 
 #if NH_3D
@@ -623,12 +638,21 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic )
   }
   else
   {
+#if NH_MV_PIC_ANALYSIS
+    if ( getUseAdaptiveQP() || getUsePicAnalysis() )
+    {
+      TEncPic* pcEPic = new TEncPic;
+      pcEPic->create( m_cSPS, m_cPPS, getUseAdaptiveQP() ? m_cPPS.getMaxCuDQPDepth()+1 : 0, false);
+      rpcPic = pcEPic;
+    }
+#else
     if ( getUseAdaptiveQP() )
     {
       TEncPic* pcEPic = new TEncPic;
       pcEPic->create( m_cSPS, m_cPPS, m_cPPS.getMaxCuDQPDepth()+1, false);
       rpcPic = pcEPic;
     }
+#endif
     else
     {
       rpcPic = new TComPic;
@@ -1587,14 +1611,16 @@ TComPic* TEncTop::getPic( Int poc )
 #endif
 
 #if NH_3D_VSO
-Void TEncTop::setupRenModel( Int iPoc, Int iEncViewIdx, Int iEncContent, Int iHorOffset, Int maxCuHeight )
+Void TEncTop::deriveRenModelSetup( Int iPoc, Int iEncViewIdx, Int iEncContent, TEncRenModelSetup& rcSetup )
 {
-  TRenModel* rendererModel = m_cRdCost.getRenModel(); 
-  rendererModel->setupPart( iHorOffset, std::min( maxCuHeight, (Int) ( m_iSourceHeight - iHorOffset ) )) ; 
-  
   Int iEncViewSIdx = m_cameraParameters->getBaseId2SortedId()[ iEncViewIdx ];
 
-  // setup base views
+  rcSetup.m_iEncViewSIdx = iEncViewSIdx;
+  rcSetup.m_iEncContent  = iEncContent;
+  rcSetup.m_baseViews   .clear();
+  rcSetup.m_singleModels.clear();
+
+  // base views
   Int iNumOfBV = m_renderModelParameters->getNumOfBaseViewsForView( iEncViewSIdx, iEncContent );
 
   for (Int iCurView = 0; iCurView < iNumOfBV; iCurView++ )
@@ -1629,22 +1655,22 @@ Void TEncTop::setupRenModel( Int iPoc, Int iEncViewIdx, Int iEncContent, Int iHo
     TComPicYuv* pcPicYuvVideoOrg  = m_ivPicLists->getPicYuv( iBaseViewIdx, false,     0    , iPoc, false );
     TComPicYuv* pcPicYuvDepthOrg  = m_ivPicLists->getPicYuv( iBaseViewIdx, depthFlag, auxId, iPoc, false );    
 
-    TComPicYuv* pcPicYuvVideoRef  = ( iVideoDistMode == 2 ) ? pcPicYuvVideoOrg  : NULL;
-    TComPicYuv* pcPicYuvDepthRef  = ( iDepthDistMode == 2 ) ? pcPicYuvDepthOrg  : NULL;
-
-    TComPicYuv* pcPicYuvVideoTest = ( iVideoDistMode == 0 ) ? pcPicYuvVideoOrg  : pcPicYuvVideoRec;
-    TComPicYuv* pcPicYuvDepthTest = ( iDepthDistMode == 0 ) ? pcPicYuvDepthOrg  : pcPicYuvDepthRec;
+    TEncRenModelSetup::BaseView cBaseView;
+    cBaseView.m_iBaseViewSIdx     = iBaseViewSIdx;
+    cBaseView.m_pcPicYuvVideoRef  = ( iVideoDistMode == 2 ) ? pcPicYuvVideoOrg  : NULL;
+    cBaseView.m_pcPicYuvDepthRef  = ( iDepthDistMode == 2 ) ? pcPicYuvDepthOrg  : NULL;
+    cBaseView.m_pcPicYuvVideoTest = ( iVideoDistMode == 0 ) ? pcPicYuvVideoOrg  : pcPicYuvVideoRec;
+    cBaseView.m_pcPicYuvDepthTest = ( iDepthDistMode == 0 ) ? pcPicYuvDepthOrg  : pcPicYuvDepthRec;
 
-    AOT( (iVideoDistMode == 2) != (pcPicYuvVideoRef != NULL) );
-    AOT( (iDepthDistMode == 2) != (pcPicYuvDepthRef != NULL) );
-    AOT( pcPicYuvDepthTest == NULL );
-    AOT( pcPicYuvVideoTest == NULL );
+    AOT( (iVideoDistMode == 2) != (cBaseView.m_pcPicYuvVideoRef != NULL) );
+    AOT( (iDepthDistMode == 2) != (cBaseView.m_pcPicYuvDepthRef != NULL) );
+    AOT( cBaseView.m_pcPicYuvDepthTest == NULL );
+    AOT( cBaseView.m_pcPicYuvVideoTest == NULL );
 
-    rendererModel->setBaseView( iBaseViewSIdx, pcPicYuvVideoTest, pcPicYuvDepthTest, pcPicYuvVideoRef, pcPicYuvDepthRef );
+    rcSetup.m_baseViews.push_back( cBaseView );
   }
 
-  rendererModel->setErrorMode( iEncViewSIdx, iEncContent, 0 );
-  // setup virtual views
+  // virtual views
   Int iNumOfSV  = m_renderModelParameters->getNumOfModelsForView( iEncViewSIdx, iEncContent );
   for (Int iCurView = 0; iCurView < iNumOfSV; iCurView++ )
   {
@@ -1659,44 +1685,65 @@ Void TEncTop::setupRenModel( Int iPoc, Int iEncViewIdx, Int iEncContent, Int iHo
     Int iLeftBaseViewIdx    = -1;
     Int iRightBaseViewIdx   = -1;
 
-    TComPicYuv* pcPicYuvOrgRef  = NULL;
-    Int**      ppiShiftLUTLeft  = NULL;
-    Int**      ppiShiftLUTRight = NULL;
-    Int**      ppiBaseShiftLUTLeft  = NULL;
-    Int**      ppiBaseShiftLUTRight = NULL;
-
-
-    Int        iDistToLeft      = -1;
+    TEncRenModelSetup::SingleModel cModel;
+    cModel.m_iModelNum            = iModelNum;
+    cModel.m_pcPicYuvOrgRef       = NULL;
+    cModel.m_ppiShiftLUTLeft      = NULL;
+    cModel.m_ppiShiftLUTRight     = NULL;
+    cModel.m_ppiBaseShiftLUTLeft  = NULL;
+    cModel.m_ppiBaseShiftLUTRight = NULL;
+    cModel.m_iDistToLeft          = -1;
 
     Int iSynthViewIdx = m_cameraParameters->synthRelNum2Idx( iSynthViewRelNum );
 
     if ( iLeftBaseViewSIdx != -1 )
     {
-      iLeftBaseViewIdx   = m_cameraParameters->getBaseSortedId2Id()   [ iLeftBaseViewSIdx ];
-      ppiShiftLUTLeft    = m_cameraParameters->getSynthViewShiftLUTI()[ iLeftBaseViewIdx  ][ iSynthViewIdx  ];
+      iLeftBaseViewIdx         = m_cameraParameters->getBaseSortedId2Id()   [ iLeftBaseViewSIdx ];
+      cModel.m_ppiShiftLUTLeft = m_cameraParameters->getSynthViewShiftLUTI()[ iLeftBaseViewIdx  ][ iSynthViewIdx  ];
     }
 
     if ( iRightBaseViewSIdx != -1 )
     {
-      iRightBaseViewIdx  = m_cameraParameters->getBaseSortedId2Id()   [iRightBaseViewSIdx ];
-      ppiShiftLUTRight   = m_cameraParameters->getSynthViewShiftLUTI()[ iRightBaseViewIdx ][ iSynthViewIdx ];
+      iRightBaseViewIdx         = m_cameraParameters->getBaseSortedId2Id()   [iRightBaseViewSIdx ];
+      cModel.m_ppiShiftLUTRight = m_cameraParameters->getSynthViewShiftLUTI()[ iRightBaseViewIdx ][ iSynthViewIdx ];
     }
 
     if ( iRightBaseViewSIdx != -1 && iLeftBaseViewSIdx != -1 )
     {
-      iDistToLeft          = m_cameraParameters->getRelDistLeft(  iSynthViewIdx , iLeftBaseViewIdx, iRightBaseViewIdx);
-      ppiBaseShiftLUTLeft  = m_cameraParameters->getBaseViewShiftLUTI() [ iLeftBaseViewIdx  ][ iRightBaseViewIdx ];
-      ppiBaseShiftLUTRight = m_cameraParameters->getBaseViewShiftLUTI() [ iRightBaseViewIdx ][ iLeftBaseViewIdx  ];
-
+      cModel.m_iDistToLeft          = m_cameraParameters->getRelDistLeft(  iSynthViewIdx , iLeftBaseViewIdx, iRightBaseViewIdx);
+      cModel.m_ppiBaseShiftLUTLeft  = m_cameraParameters->getBaseViewShiftLUTI() [ iLeftBaseViewIdx  ][ iRightBaseViewIdx ];
+      cModel.m_ppiBaseShiftLUTRight = m_cameraParameters->getBaseViewShiftLUTI() [ iRightBaseViewIdx ][ iLeftBaseViewIdx  ];
     }
 
     if ( iOrgRefBaseViewSIdx != -1 )
     {
-      pcPicYuvOrgRef = m_ivPicLists->getPicYuv(  m_cameraParameters->getBaseSortedId2Id()[ iOrgRefBaseViewSIdx ] , false, 0, iPoc, false );
-      AOF ( pcPicYuvOrgRef );
+      cModel.m_pcPicYuvOrgRef = m_ivPicLists->getPicYuv(  m_cameraParameters->getBaseSortedId2Id()[ iOrgRefBaseViewSIdx ] , false, 0, iPoc, false );
+      AOF ( cModel.m_pcPicYuvOrgRef );
     }
 
-    rendererModel->setSingleModel( iModelNum, ppiShiftLUTLeft, ppiBaseShiftLUTLeft, ppiShiftLUTRight, ppiBaseShiftLUTRight, iDistToLeft, pcPicYuvOrgRef, iEncViewSIdx );
+    rcSetup.m_singleModels.push_back( cModel );
+  }
+}
+
+/** set up a renderer model for the iHeight rows starting at iHorOffset
+ * Only pcRenModel is modified. Each TEncSearch owns a model instance, which it sets up from the shared rcSetup.
+ */
+Void TEncTop::setupRenModel( TRenModel* pcRenModel, const TEncRenModelSetup& rcSetup, Int iHorOffset, Int iHeight ) const
+{
+  pcRenModel->setupPart( iHorOffset, std::min( iHeight, (Int) ( m_iSourceHeight - iHorOffset ) )) ; 
+
+  for ( size_t i = 0; i < rcSetup.m_baseViews.size(); i++ )
+  {
+    const TEncRenModelSetup::BaseView& rcBaseView = rcSetup.m_baseViews[ i ];
+    pcRenModel->setBaseView( rcBaseView.m_iBaseViewSIdx, rcBaseView.m_pcPicYuvVideoTest, rcBaseView.m_pcPicYuvDepthTest, rcBaseView.m_pcPicYuvVideoRef, rcBaseView.m_pcPicYuvDepthRef );
+  }
+
+  pcRenModel->setErrorMode( rcSetup.m_iEncViewSIdx, rcSetup.m_iEncContent, 0 );
+
+  for ( size_t i = 0; i < rcSetup.m_singleModels.size(); i++ )
+  {
+    const TEncRenModelSetup::SingleModel& rcModel = rcSetup.m_singleModels[ i ];
+    pcRenModel->setSingleModel( rcModel.m_iModelNum, rcModel.m_ppiShiftLUTLeft, rcModel.m_ppiBaseShiftLUTLeft, rcModel.m_ppiShiftLUTRight, rcModel.m_ppiBaseShiftLUTRight, rcModel.m_iDistToLeft, rcModel.m_pcPicYuvOrgRef, rcSetup.m_iEncViewSIdx );
   }
 }
 #endif
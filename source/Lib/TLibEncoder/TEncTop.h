@@ -67,6 +67,36 @@
 #if KWU_RC_MADPRED_E0227
 class TAppEncTop;
 #endif
+#if NH_3D_VSO
+/// renderer model setup of a picture, derived once per slice and used read-only for the setup of each CTU row
+struct TEncRenModelSetup
+{
+  struct BaseView
+  {
+    Int         m_iBaseViewSIdx;
+    TComPicYuv* m_pcPicYuvVideoTest;
+    TComPicYuv* m_pcPicYuvDepthTest;
+    TComPicYuv* m_pcPicYuvVideoRef;
+    TComPicYuv* m_pcPicYuvDepthRef;
+  };
+
+  struct SingleModel
+  {
+    Int         m_iModelNum;
+    Int**       m_ppiShiftLUTLeft;
+    Int**       m_ppiBaseShiftLUTLeft;
+    Int**       m_ppiShiftLUTRight;
+    Int**       m_ppiBaseShiftLUTRight;
+    Int         m_iDistToLeft;
+    TComPicYuv* m_pcPicYuvOrgRef;
+  };
+
+  Int                      m_iEncViewSIdx;
+  Int                      m_iEncContent;
+  std::vector<BaseView>    m_baseViews;
+  std::vector<SingleModel> m_singleModels;
+};
+#endif
 /// encoder class
 class TEncTop : public TEncCfg
 {
@@ -81,6 +111,7 @@ private:
 
 #if NH_MV
   TComPicLists*           m_ivPicLists;                   ///< access to picture lists of other layers 
+  TEncTop*                m_pcFirstRatePointEncTop;       ///< encoder of the same layer at the first rate point, NULL at the first rate point
 #endif
 #if NH_3D_IC
   Int *m_aICEnableCandidate;
@@ -209,6 +240,8 @@ public:
   Int                     getFrameId            (Int iGOPid);  
   TComPic*                getPic                ( Int poc );
   Void                    setIvPicLists         ( TComPicLists* picLists) { m_ivPicLists = picLists; }
+  Void                    setFirstRatePointEncTop( TEncTop* pcEncTop ) { m_pcFirstRatePointEncTop = pcEncTop; }
+  TEncTop*                getFirstRatePointEncTop() { return m_pcFirstRatePointEncTop; }
 #endif
 #if NH_3D
   Void                    setSps3dExtension     ( TComSps3dExtension sps3dExtension ) { m_cSPS.setSps3dExtension( sps3dExtension );  };
@@ -250,7 +283,8 @@ public:
   Void printSummary(Bool isField) { m_cGOPEncoder.printOutSummary (m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE, m_cSPS.getBitDepths()); }
 
 #if NH_3D_VSO
-   Void setupRenModel( Int iPoc, Int iEncViewIdx, Int iEncContent, Int iHorOffset, Int maxCuHeight ); 
+   Void deriveRenModelSetup( Int iPoc, Int iEncViewIdx, Int iEncContent, TEncRenModelSetup& rcSetup );
+   Void setupRenModel      ( TRenModel* pcRenModel, const TEncRenModelSetup& rcSetup, Int iHorOffset, Int iHeight ) const;
 #endif
 };
 
@@ -38,6 +38,7 @@
 #include "TExtrTop.h"
 #if NH_MV
 TExtrTop::TExtrTop()
+: m_vpsReceived( false )
 {
 }
 
@@ -50,34 +51,51 @@ Void TExtrTop::init()
   m_cEntropyDecoder.init(&m_cPrediction);
 
   m_acSPSBuffer.clear();
+  m_aiSPSLayerIdBuffer.clear();
+  m_vpsReceived = false;
 }
 
-Bool TExtrTop::extract( InputNALUnit& nalu, std::set<UInt>& rsuiExtractLayerIds )
+/** Decode the parameter sets extraction depends on. Only VPS and, if requested, SPS NAL units are parsed,
+ *  all other NAL units are selected by their NAL unit header alone.
+ * \param nalu       completely read NAL unit
+ * \param bDecodeSps parse SPS NAL units for the SPS info output
+ */
+Void TExtrTop::decodeParameterSet( InputNALUnit& nalu, Bool bDecodeSps )
 {
-  //extraction now has to be done using layer_id
-  UInt uiLayerId      = nalu.m_nuhLayerId;
-
-  
   // Initialize entropy decoder
   m_cEntropyDecoder.setEntropyDecoder( &m_cCavlcDecoder );
+  m_cEntropyDecoder.setBitstream     ( &nalu.getBitstream() );
 
-  TComInputBitstream inpBs = nalu.getBitstream(); 
-  m_cEntropyDecoder.setBitstream     ( &inpBs );
-  
   if ( nalu.m_nalUnitType == NAL_UNIT_VPS )
   {
     // a hack for now assuming there's only one VPS in the bitstream
-    m_cEntropyDecoder.decodeVPS( &m_cVPS );      
+    m_cEntropyDecoder.decodeVPS( &m_cVPS );
+    m_vpsReceived = true;
   }
 
-  if ( nalu.m_nalUnitType == NAL_UNIT_SPS )
+  if ( nalu.m_nalUnitType == NAL_UNIT_SPS && bDecodeSps )
   {
      TComSPS     cSPS;
+     cSPS.setLayerId( nalu.m_nuhLayerId );
      m_cEntropyDecoder   .decodeSPS( &cSPS );
      m_acSPSBuffer       .push_back( cSPS );
+     m_aiSPSLayerIdBuffer.push_back( nalu.m_nuhLayerId );
   }
+}
 
-  return ( rsuiExtractLayerIds.find( uiLayerId ) != rsuiExtractLayerIds.end() );
+/** Get the nuh_layer_id values of a layer set of the VPS.
+ * \param layerSetIdx  index of the layer set, including additional layer sets
+ * \param rsuiLayerIds set the layer IDs are inserted in
+ */
+Void TExtrTop::getLayerIdsInLayerSet( Int layerSetIdx, std::set<UInt>& rsuiLayerIds ) const
+{
+  assert( m_vpsReceived );
+  assert( layerSetIdx >= 0 && layerSetIdx < m_cVPS.getNumLayerSets() );
+
+  for ( Int j = 0; j < m_cVPS.getNumLayersInIdList( layerSetIdx ); j++ )
+  {
+    rsuiLayerIds.insert( m_cVPS.getLayerSetLayerIdList( layerSetIdx, j ) );
+  }
 }
 
 
@@ -56,6 +56,7 @@ class TExtrTop
 private:
 
   TComVPS                 m_cVPS;
+  Bool                    m_vpsReceived;
   std::list<TComSPS>      m_acSPSBuffer;
   std::list<Int    >      m_aiSPSLayerIdBuffer; 
 
@@ -70,7 +71,11 @@ public:
   
   Void     init();
 
-  Bool     extract( InputNALUnit& nalu, std::set<UInt>& rsuiExtractLayerIds );
+  Void     decodeParameterSet   ( InputNALUnit& nalu, Bool bDecodeSps );
+  Bool     isVpsReceived        () const { return m_vpsReceived; }
+  Int      getNumLayerSets      () const { return m_cVPS.getNumLayerSets(); }
+  Void     getLayerIdsInLayerSet( Int layerSetIdx, std::set<UInt>& rsuiLayerIds ) const;
+
   Void     dumpSpsInfo( std::ostream& rcSpsInfoHandle );
   Void     dumpVpsInfo( std::ostream& rcVpsInfoHandle ); 
   
@@ -93,6 +93,10 @@ TRenModel::TRenModel()
   /// Current Setup data ///
   m_abSetupVideoFromOrgForView = NULL;
   m_abSetupDepthFromOrgForView = NULL;
+
+#if H_3D_VSO_DIST_CACHE
+  xResetDistCache();
+#endif
 }
 
 TRenModel::~TRenModel()
@@ -451,6 +455,10 @@ TRenModel::setBaseView( Int iViewNum, TComPicYuv* pcPicYuvVideoData, TComPicYuv*
   AOF( pcPicYuvDepthData->getHeight( COMPONENT_Y ) >= m_iUsedHeight + m_uiHorOff && pcPicYuvDepthData->getWidth( COMPONENT_Y ) == m_iWidth );
   
   AOF( pcPicYuvVideoData   ->getChromaFormat() == CHROMA_420 );
+
+#if H_3D_VSO_DIST_CACHE
+  xResetDistCache();
+#endif
   
   pcPicYuvVideoData->extendPicBorder();
 
@@ -485,6 +493,10 @@ TRenModel::setSingleModel( Int iModelNum, Int** ppiShiftLutLeft, Int** ppiBaseSh
 {
   AOT( iModelNum < 0 || iModelNum > m_iNumOfRenModels );
 
+#if H_3D_VSO_DIST_CACHE
+  xResetDistCache();
+#endif
+
   m_apcRenModels[iModelNum]->setupPart( m_uiHorOff, m_iUsedHeight );
 
   // Switch model  to original data for setup if given to render reference
@@ -596,6 +608,13 @@ TRenModel::setErrorMode( Int iView, Int iContent, int iPlane )
   AOT(iContent != 0  &&  iContent != 1);
   AOT(iPlane < 0     || iPlane > 3);
 
+#if H_3D_VSO_DIST_CACHE
+  if ( iView != m_iCurrentView || iContent != m_iCurrentContent || iPlane != m_iCurrentPlane )
+  {
+    xResetDistCache();
+  }
+#endif
+
   m_iCurrentView    = iView;
   m_iCurrentContent = iContent;
   m_iCurrentPlane   = iPlane;
@@ -619,6 +638,9 @@ Void
 TRenModel::setupPart ( UInt uiHorOff, Int iUsedHeight )
 {
 //  AOT( iUsedHeight > m_iHeight );     
+#if H_3D_VSO_DIST_CACHE
+  xResetDistCache();
+#endif
   m_uiHorOff    = uiHorOff; 
   m_iUsedHeight = iUsedHeight; 
 }
@@ -641,6 +663,23 @@ TRenModel::getDist( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int
   AOT( iWidth     < 0);
   AOT( iHeight    < 0);
 
+#if H_3D_VSO_DIST_CACHE
+  // the distortion only depends on the model state in the rows of the block and on the block samples
+#if H_3D_VSO_EARLY_SKIP
+  const Pel* piCacheOrgData = piOrgData;
+#else
+  const Pel* piCacheOrgData = NULL;
+  const Int  iOrgStride     = 0;
+#endif
+  const Bool bUseCache = ( iWidth > 0 && iHeight > 0 );
+  const UInt uiHash    = bUseCache ? xGetBlockHash( iWidth, iHeight, iStride, piNewData ) : 0;
+  const Int  iEntry    = bUseCache ? xFindDistCacheEntry( iStartPosX, iStartPosY, iWidth, iHeight, uiHash, iStride, piNewData, iOrgStride, piCacheOrgData ) : -1;
+  if ( iEntry >= 0 )
+  {
+    return m_acDistCache[ iEntry ].iDist;
+  }
+#endif
+
   RMDist iDist = 0;
 
   for (Int iModelNum = 0; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
@@ -658,7 +697,15 @@ TRenModel::getDist( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int
       iDist +=  m_apcCurRenModels[iModelNum]->getDistVideo  ( m_aiCurPosInModels[iModelNum], m_iCurrentPlane ,iStartPosX, iStartPosY, iWidth, iHeight, iStride, piNewData );
     }
   }
-  return m_iNumOfCurRenModels > 0 ? ( iDist + (m_iNumOfCurRenModels >> 1) ) / m_iNumOfCurRenModels : 0;
+  iDist = m_iNumOfCurRenModels > 0 ? ( iDist + (m_iNumOfCurRenModels >> 1) ) / m_iNumOfCurRenModels : 0;
+
+#if H_3D_VSO_DIST_CACHE
+  if ( bUseCache )
+  {
+    xAddDistCacheEntry( iStartPosX, iStartPosY, iWidth, iHeight, uiHash, iStride, piNewData, iOrgStride, piCacheOrgData, iDist );
+  }
+#endif
+  return iDist;
 }
 
 Void
@@ -674,6 +721,10 @@ TRenModel::setData( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int
   AOT( iWidth     < 0);
   AOT( iHeight    < 0);
 
+#if H_3D_VSO_DIST_CACHE
+  xInvalidateDistCache( iStartPosY, iHeight );
+#endif
+
   for (Int iModelNum = 0; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
   {
     if (m_iCurrentContent == 1)
@@ -769,4 +820,100 @@ TRenModel::xSetLRViewAndAddModel( Int iModelNum, Int iBaseViewNum, Int iContent,
     }
   }
 }
+
+#if H_3D_VSO_DIST_CACHE
+Void
+TRenModel::xResetDistCache( )
+{
+  for (Int iEntry = 0; iEntry < RM_DIST_CACHE_SIZE; iEntry++ )
+  {
+    m_acDistCache[ iEntry ].bValid = false;
+  }
+  m_iDistCacheNextEntry = 0;
+}
+
+Void
+TRenModel::xInvalidateDistCache( Int iStartPosY, Int iHeight )
+{
+  for (Int iEntry = 0; iEntry < RM_DIST_CACHE_SIZE; iEntry++ )
+  {
+    DistCacheEntry& rcEntry = m_acDistCache[ iEntry ];
+    if ( rcEntry.bValid && rcEntry.iStartPosY < iStartPosY + iHeight && iStartPosY < rcEntry.iStartPosY + rcEntry.iHeight )
+    {
+      rcEntry.bValid = false;
+    }
+  }
+}
+
+Int
+TRenModel::xFindDistCacheEntry( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, UInt uiHash, Int iStride, const Pel* piNewData, Int iOrgStride, const Pel* piOrgData ) const
+{
+  for (Int iEntry = 0; iEntry < RM_DIST_CACHE_SIZE; iEntry++ )
+  {
+    const DistCacheEntry& rcEntry = m_acDistCache[ iEntry ];
+    if ( !rcEntry.bValid || rcEntry.uiHash != uiHash || rcEntry.iStartPosX != iStartPosX || rcEntry.iStartPosY != iStartPosY
+      || rcEntry.iWidth != iWidth || rcEntry.iHeight != iHeight || rcEntry.acOrgData.empty() != ( piOrgData == NULL ) )
+    {
+      continue;
+    }
+
+    Bool bEqual = true;
+    for (Int iPosY = 0; iPosY < iHeight && bEqual; iPosY++ )
+    {
+      bEqual = ( memcmp( &rcEntry.acNewData[ iPosY * iWidth ], piNewData + iPosY * iStride, iWidth * sizeof( Pel ) ) == 0 );
+      if ( bEqual && piOrgData != NULL )
+      {
+        bEqual = ( memcmp( &rcEntry.acOrgData[ iPosY * iWidth ], piOrgData + iPosY * iOrgStride, iWidth * sizeof( Pel ) ) == 0 );
+      }
+    }
+
+    if ( bEqual )
+    {
+      return iEntry;
+    }
+  }
+  return -1;
+}
+
+Void
+TRenModel::xAddDistCacheEntry( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, UInt uiHash, Int iStride, const Pel* piNewData, Int iOrgStride, const Pel* piOrgData, RMDist iDist )
+{
+  DistCacheEntry& rcEntry = m_acDistCache[ m_iDistCacheNextEntry ];
+  m_iDistCacheNextEntry   = ( m_iDistCacheNextEntry + 1 ) % RM_DIST_CACHE_SIZE;
+
+  rcEntry.bValid     = true;
+  rcEntry.iStartPosX = iStartPosX;
+  rcEntry.iStartPosY = iStartPosY;
+  rcEntry.iWidth     = iWidth;
+  rcEntry.iHeight    = iHeight;
+  rcEntry.uiHash     = uiHash;
+  rcEntry.iDist      = iDist;
+
+  rcEntry.acNewData.resize( iWidth * iHeight );
+  rcEntry.acOrgData.resize( piOrgData != NULL ? iWidth * iHeight : 0 );
+
+  for (Int iPosY = 0; iPosY < iHeight; iPosY++ )
+  {
+    memcpy( &rcEntry.acNewData[ iPosY * iWidth ], piNewData + iPosY * iStride, iWidth * sizeof( Pel ) );
+    if ( piOrgData != NULL )
+    {
+      memcpy( &rcEntry.acOrgData[ iPosY * iWidth ], piOrgData + iPosY * iOrgStride, iWidth * sizeof( Pel ) );
+    }
+  }
+}
+
+UInt
+TRenModel::xGetBlockHash( Int iWidth, Int iHeight, Int iStride, const Pel* piData )
+{
+  UInt uiHash = 2166136261u;
+  for (Int iPosY = 0; iPosY < iHeight; iPosY++, piData += iStride )
+  {
+    for (Int iPosX = 0; iPosX < iWidth; iPosX++ )
+    {
+      uiHash = ( uiHash ^ (UInt) piData[ iPosX ] ) * 16777619u;
+    }
+  }
+  return uiHash;
+}
+#endif
 #endif // NH_3D
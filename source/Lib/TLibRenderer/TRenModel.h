@@ -41,6 +41,8 @@
 #include "../TLibCommon/TComPicYuv.h"
 #include "../TLibCommon/TypeDef.h"
 
+#include <vector>
+
 #if NH_3D_VSO
 
 class TRenModel
@@ -88,6 +90,15 @@ private:
   // helpers
   Void xSetLRViewAndAddModel( Int iModelNum, Int iBaseViewNum, Int iContent, Int iViewPos, Bool bAdd );
 
+#if H_3D_VSO_DIST_CACHE
+  // distortion cache
+  Void xResetDistCache      ( );
+  Void xInvalidateDistCache ( Int iStartPosY, Int iHeight );
+  Int  xFindDistCacheEntry  ( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, UInt uiHash, Int iStride, const Pel* piNewData, Int iOrgStride, const Pel* piOrgData ) const;
+  Void xAddDistCacheEntry   ( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, UInt uiHash, Int iStride, const Pel* piNewData, Int iOrgStride, const Pel* piOrgData, RMDist iDist );
+  static UInt xGetBlockHash ( Int iWidth, Int iHeight, Int iStride, const Pel* piData );
+#endif
+
   // Settings
   Int    m_iShiftPrec;
   Int**  m_aaaiSubPelShiftLut[2];
@@ -155,6 +166,27 @@ private:
 
   Pel**  m_apiOrgDepthPel    ;    // Dim1: ViewPosition
   Int*   m_aiOrgDepthStrides ;    // Dim1: ViewPosition
+
+#if H_3D_VSO_DIST_CACHE
+  /// Distortions of recently evaluated blocks, an entry is valid until the model changes in the rows covered by it
+  static const Int RM_DIST_CACHE_SIZE = 16;
+
+  struct DistCacheEntry
+  {
+    Bool             bValid;
+    Int              iStartPosX;
+    Int              iStartPosY;
+    Int              iWidth;
+    Int              iHeight;
+    UInt             uiHash;
+    RMDist           iDist;
+    std::vector<Pel> acNewData;
+    std::vector<Pel> acOrgData;   // empty if no original data was given
+  };
+
+  DistCacheEntry m_acDistCache[ RM_DIST_CACHE_SIZE ];
+  Int            m_iDistCacheNextEntry;
+#endif
 };
 
 #endif // NH_3D
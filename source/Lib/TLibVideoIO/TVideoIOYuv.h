@@ -83,6 +83,7 @@ public:
 
   Bool  isEof ();                                           ///< check for end-of-file
   Bool  isFail();                                           ///< check for failure
+  Bool  isOpen()  { return m_cHandle.is_open(); }           ///< check whether a file has been opened
 
 
 };